@@ -2573,6 +2573,50 @@ kint32_t DisplayChangeFrameBuffer(DisplayCtrl *sprt_disp, kuint32_t FrameAddr, k
     return ER_NORMAL;
 }
 
+/*!
+ *	DisplayParkFrameBuffer(DisplayCtrl *sprt_disp, kuint32_t FrameAddr)
+ *
+ *	Parameters:
+ *		sprt_disp - Pointer to the initialized DisplayCtrl struct
+ *      FrameAddr - FrameBuffer Address to be shown
+ *      
+ *	Return Value: kint32_t
+ *		ER_NORMAL if successful, errno otherwise
+ *
+ *	Errors:
+ *
+ *	Description:
+ *		Replace the address of the parked frame store. The channel keeps running,
+ *      the new address is taken by VDMA at the next frame sync, so there is no tearing.
+ */
+kint32_t DisplayParkFrameBuffer(DisplayCtrl *sprt_disp, kuint32_t FrameAddr)
+{
+    XAxiVdma_Channel *sprt_chan;
+    kint32_t index, Status;
+
+    if (sprt_disp->state != NR_XIL_DISPLAY_RUNNING)
+        return -ER_NREADY;
+
+    sprt_chan = XAxiVdma_GetChannel(sprt_disp->vdma, XAXIVDMA_READ);
+    if (!sprt_chan || !sprt_chan->IsValid)
+        return -ER_NOTFOUND;
+
+    index = sprt_disp->curFrame;
+    sprt_disp->framePtr[index] = (kuint8_t *)FrameAddr;
+    sprt_disp->vdmaConfig.FrameStoreStartAddr[index] = FrameAddr;
+
+    Status = XAxiVdma_ChannelSetBufferAddr(sprt_chan, sprt_disp->vdmaConfig.FrameStoreStartAddr, sprt_chan->NumFrames);
+    if (Status)
+        return Status;
+
+    /*!< writing vsize commits the start address at the next frame boundary */
+    Status = XAxiVdma_ChannelStart(sprt_chan);
+    if (Status)
+        return Status;
+
+    return XAxiVdma_ChannelStartParking(sprt_chan);
+}
+
 /*!
  *	DisplayStart(DisplayCtrl *sprt_disp)
  *
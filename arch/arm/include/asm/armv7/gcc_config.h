@@ -392,6 +392,126 @@ static inline void __set_cp15_isb(kuint32_t result)
     );
 }
 
+/*!
+ * @brief  	__enable_cp15_pmccntr
+ * @param  	none
+ * @retval 	none
+ * @note   	start PMU cycle counter: PMCR::E | PMCR::C | PMCR::D (count once every 64 cycles), PMCNTENSET::C
+ */
+static inline void __enable_cp15_pmccntr(void)
+{
+    kuint32_t result;
+
+    __asm__ __volatile__ (
+        " mrc p15, 0, %0, c9, c12, 0 "
+        : "=r"(result)
+    );
+
+    result |= (1U << 0) | (1U << 2) | (1U << 3);
+
+    __asm__ __volatile__ (
+        " mcr p15, 0, %0, c9, c12, 0 "
+        :
+        : "r"(result)
+        : "memory"
+    );
+
+    __asm__ __volatile__ (
+        " mcr p15, 0, %0, c9, c12, 1 "
+        :
+        : "r"(1U << 31)
+        : "memory"
+    );
+}
+
+/*!
+ * @brief  	__get_cp15_pmccntr
+ * @param  	none
+ * @retval 	PMCCNTR
+ * @note   	read PMU cycle counter, wraps at 32 bits
+ */
+static inline kuint32_t __get_cp15_pmccntr(void)
+{
+    kuint32_t result;
+
+    __asm__ __volatile__ (
+        " mrc p15, 0, %0, c9, c13, 0 "
+        : "=r"(result)
+    );
+
+    return result;
+}
+
+/*!
+ * @brief  	__get_dcache_line_size
+ * @param  	none
+ * @retval 	the smallest D-Cache line size (unit: byte)
+ * @note   	CTR::DminLine: bit[19:16], log2 of the number of words
+ */
+static inline kuint32_t __get_dcache_line_size(void)
+{
+    kuint32_t result;
+
+    __asm__ __volatile__ (
+        " mrc p15, 0, %0, c0, c0, 1  "
+        : "=r"(result)
+    );
+
+    return (4U << ((result >> 16U) & 0xfU));
+}
+
+/*!
+ * @brief  	__clean_dcache_range
+ * @param  	start, size
+ * @retval 	none
+ * @note   	write back D-Cache lines to PoC (DCCMVAC), used before DMA reads memory
+ */
+static inline void __clean_dcache_range(kuaddr_t start, kusize_t size)
+{
+    kuint32_t line = __get_dcache_line_size();
+    kuaddr_t end = start + size;
+
+    for (start &= ~((kuaddr_t)line - 1); start < end; start += line)
+        mrt_set_cp15("0, %0, c7, c10, 1", start);
+
+    mrt_dsb();
+}
+
+/*!
+ * @brief  	__invalidate_dcache_range
+ * @param  	start, size
+ * @retval 	none
+ * @note   	discard D-Cache lines (DCIMVAC), used after DMA writes memory;
+ *          start and size should be aligned to line size, or the neighbours sharing the line will be lost
+ */
+static inline void __invalidate_dcache_range(kuaddr_t start, kusize_t size)
+{
+    kuint32_t line = __get_dcache_line_size();
+    kuaddr_t end = start + size;
+
+    for (start &= ~((kuaddr_t)line - 1); start < end; start += line)
+        mrt_set_cp15("0, %0, c7, c6, 1", start);
+
+    mrt_dsb();
+}
+
+/*!
+ * @brief  	__flush_dcache_range
+ * @param  	start, size
+ * @retval 	none
+ * @note   	write back and discard D-Cache lines (DCCIMVAC)
+ */
+static inline void __flush_dcache_range(kuaddr_t start, kusize_t size)
+{
+    kuint32_t line = __get_dcache_line_size();
+    kuaddr_t end = start + size;
+
+    for (start &= ~((kuaddr_t)line - 1); start < end; start += line)
+        mrt_set_cp15("0, %0, c7, c14, 1", start);
+
+    mrt_dsb();
+}
+
 /*!
  * @brief  	__get_cpsr
  * @param  	none
@@ -1356,6 +1356,7 @@ extern kint32_t DisplayInitialize(DisplayCtrl *sprt_disp, XAxiVdma *sprt_vdma, k
                                 kuint32_t dynClkAddr, kuint8_t *framePtr[DISPLAY_NUM_FRAMES], 
                                 kuint32_t stride, VideoMode *sprt_vmode);
 extern kint32_t DisplayChangeFrameBuffer(DisplayCtrl *sprt_disp, kuint32_t FrameAddr, kusize_t FrameSize);
+extern kint32_t DisplayParkFrameBuffer(DisplayCtrl *sprt_disp, kuint32_t FrameAddr);
 extern kint32_t DisplayStart(DisplayCtrl *sprt_disp);
 extern kint32_t DisplayStop(DisplayCtrl *sprt_dispctrl);
 
@@ -14,7 +14,10 @@
 #include <common/time.h>
 #include <board/board.h>
 #include <platform/fwk_mempool.h>
+#include <platform/of/fwk_of.h>
+#include <platform/irq/fwk_irq_types.h>
 #include <platform/mmc/fwk_sdcard.h>
+#include <kernel/wait.h>
 
 #include "imx6_common.h"
 
@@ -40,6 +43,45 @@
 #define IMX_SDMMC_CD_PORT_ENTRY()                       IMX6UL_GPIO_PROPERTY_ENTRY(1)
 #define IMX_SDMMC_CD_PIN_BIT                            IMX6UL_GPIO_PIN_OFFSET_BIT(19)
 #define IMX_SDMMC_IF_PORT_ENTRY()                       IMX6UL_USDHC_PROPERTY_ENTRY(1)          /*!< register base address */
+#define IMX_SDMMC_IF_COMPATIBLE                         "fsl,imx6ull-usdhc"
+
+/*!< ADMA2 */
+#define IMX_SDMMC_ADMA2_DESC_NUM                        (32U)
+#define IMX_SDMMC_ADMA2_DESC_MAX_LEN                    (0xfe00U)                               /*!< 16-bit length field, 127 blocks of 512 bytes */
+#define IMX_SDMMC_ADMA2_XFER_MAX_LEN                    (IMX_SDMMC_ADMA2_DESC_NUM * IMX_SDMMC_ADMA2_DESC_MAX_LEN)
+#define IMX_SDMMC_DMA_TIMEOUT_MS                        (1000U)
+#define IMX_SDMMC_DMA_RECHECK_MS                        (10U)
+
+/*!< ADMA2 descriptor attribute */
+enum __ERT_IMX_SDMMC_ADMA2_ATTR
+{
+    NR_ImxSdmmc_Adma2_Valid = mrt_bit(0U),                          /*!< this line is valid */
+    NR_ImxSdmmc_Adma2_End = mrt_bit(1U),                            /*!< the last descriptor */
+    NR_ImxSdmmc_Adma2_Int = mrt_bit(2U),                            /*!< generate DMA interrupt when this line is done */
+    NR_ImxSdmmc_Adma2_ActTran = mrt_bit(5U),                        /*!< Act2 = 1, Act1 = 0: transfer data */
+};
+
+#define IMX_SDMMC_ADMA2_LEN_U32(x)                      mrt_bit_mask((x), 0xffff0000U, 16U)
+
+/*!< ADMA2 descriptor: 32-bit address mode */
+struct imx6ull_sdmmc_adma2_desc
+{
+    kuint32_t attr;                                                 /*!< bit[15:0]: attribute; bit[31:16]: length */
+    kuint32_t address;
+};
+
+struct imx6ull_sdmmc_dma
+{
+    struct imx6ull_sdmmc_adma2_desc *sprt_desc;
+
+    /*!< data that descriptors has been prepared for, null if no DMA is pending */
+    struct fwk_sdcard_data *sprt_data;
+
+    kint32_t irq;
+    volatile kbool_t is_done;
+    volatile kuint32_t int_status;
+    struct wait_queue_head sgrt_wqh;
+};
 
 /*!< The functions */
 static kbool_t imx6ull_sdmmc_is_card_insert(struct fwk_sdcard_host *sprt_host);
@@ -57,6 +99,8 @@ static void imx6ull_sdmmc_reset(srt_imx_usdhc_t *sprt_usdhc, kuint32_t optBit, k
 static void imx6ull_sdmmc_data_configure(srt_imx_usdhc_t *sprt_usdhc, struct fwk_sdcard_data *sprt_data, void *ptrData);
 static kint32_t imx6ull_sdmmc_write_data(srt_imx_usdhc_t *sprt_usdhc, struct fwk_sdcard_data *sprt_data);
 static kint32_t imx6ull_sdmmc_read_data(srt_imx_usdhc_t *sprt_usdhc, struct fwk_sdcard_data *sprt_data);
+static kint32_t imx6ull_sdmmc_dma_transfer(srt_imx_usdhc_t *sprt_usdhc, struct imx6ull_sdmmc_dma *sprt_dma, 
+                                                            struct fwk_sdcard_data *sprt_data);
 
 /*!< API function */
 /*!
@@ -299,6 +343,8 @@ static void imx6ull_sdmmc_host_initial(void)
     /*!< Data Status Bit: Data Timeout Error, Data CRC Error, Data End Bit Error, Auto CMD12 Error */
     mrt_setbitl(NR_ImxUsdhc_IntDataTimeOutErr_Bit | NR_ImxUsdhc_IntDataCrcErr_Bit |
                NR_ImxUsdhc_IntDataEndBitErr_Bit | NR_ImxUsdhc_IntACmd12Err_Bit, &iIntStatusReg);
+    /*!< ADMA Error Status Bit */
+    mrt_setbitl(NR_ImxUsdhc_IntDmaErr_Bit, &iIntStatusReg);
     /*!< SDR104 Tuning Status Bit: Re-Tuning Event, Tuning Pass, Tuning Error */
     mrt_setbitl(NR_ImxUsdhc_IntReTuningEvent_Bit | NR_ImxUsdhc_IntTuningPass_Bit |
                NR_ImxUsdhc_IntTuningErr_Bit, &iIntStatusReg);
@@ -340,6 +386,52 @@ static void imx6ull_sdmmc_reset(srt_imx_usdhc_t *sprt_usdhc, kuint32_t optBit, k
 
 }
 
+/*!
+ * @brief   imx6ull_sdmmc_dma_get
+ * @param   sprt_data
+ * @retval  dma context, or null if ADMA2 has not been prepared for sprt_data
+ * @note    none
+ */
+static struct imx6ull_sdmmc_dma *imx6ull_sdmmc_dma_get(struct fwk_sdcard_data *sprt_data)
+{
+    struct fwk_sdcard_host *sprt_host;
+    struct imx6ull_sdmmc_dma *sprt_dma;
+
+    if (!sprt_data)
+        return mrt_nullptr;
+
+    sprt_host = (struct fwk_sdcard_host *)sprt_data->ptrHost;
+    if (!isValid(sprt_host))
+        return mrt_nullptr;
+
+    sprt_dma = (struct imx6ull_sdmmc_dma *)sprt_host->privData;
+    if ((!sprt_dma) || (sprt_dma->sprt_data != sprt_data))
+        return mrt_nullptr;
+
+    return sprt_dma;
+}
+
+/*!
+ * @brief   imx6ull_sdmmc_dma_abort
+ * @param   sprt_host
+ * @retval  none
+ * @note    drop the pending DMA, and mask the data interrupts
+ */
+static void imx6ull_sdmmc_dma_abort(struct fwk_sdcard_host *sprt_host)
+{
+    srt_imx_usdhc_t *sprt_usdhc = (srt_imx_usdhc_t *)sprt_host->iHostIfBase;
+    struct imx6ull_sdmmc_dma *sprt_dma = (struct imx6ull_sdmmc_dma *)sprt_host->privData;
+
+    if ((!sprt_dma) || (!sprt_dma->sprt_data))
+        return;
+
+    mrt_resetl(&sprt_usdhc->INT_SIGNAL_EN);
+    mrt_clrbitl(NR_ImxUsdhc_MixCtrl_DmaEnable, &sprt_usdhc->MIX_CTRL);
+    mrt_imx_clear_interrupt_flags(NR_ImxUsdhc_IntDmaErr_Bit | NR_ImxUsdhc_IntDmaInterrupt_Bit, &sprt_usdhc);
+
+    sprt_dma->sprt_data = mrt_nullptr;
+}
+
 /*!
  * @brief   imx6ull_sdmmc_reset_transfer
  * @param   none
@@ -359,6 +451,9 @@ static void imx6ull_sdmmc_reset_transfer(struct fwk_sdcard_host *sprt_host)
 
     if (mrt_isBitSetl(NR_ImxUsdhc_PresState_CmdInhibitDataLine, &sprt_usdhc->PRES_STATE))
         imx6ull_sdmmc_reset(sprt_usdhc, NR_ImxUsdhc_SysCtrl_SoftResetDataLine, 100U); 
+
+    /*!< the descriptors prepared are useless now */
+    imx6ull_sdmmc_dma_abort(sprt_host);
 }
 
 /*!
@@ -716,6 +811,7 @@ static kint32_t imx6ull_sdmmc_transfer_data(struct fwk_sdcard_data *sprt_data)
 {
     srt_imx_usdhc_t *sprt_usdhc;
     struct fwk_sdcard_host *sprt_host;
+    struct imx6ull_sdmmc_dma *sprt_dma;
     kint32_t iRetval;
 
     if (!sprt_data)
@@ -726,16 +822,22 @@ static kint32_t imx6ull_sdmmc_transfer_data(struct fwk_sdcard_data *sprt_data)
         return -ER_NULLPTR;
 
     sprt_usdhc = (srt_imx_usdhc_t *)sprt_host->iHostIfBase;
+    sprt_dma = imx6ull_sdmmc_dma_get(sprt_data);
 
     /*!< ------------------------------------------------------------ */
-    /*!< write or read */
-    iRetval = (sprt_data->txBuffer) ? imx6ull_sdmmc_write_data(sprt_usdhc, sprt_data) : imx6ull_sdmmc_read_data(sprt_usdhc, sprt_data);
+    /*!< ADMA2 has been started by command, or write/read by CPU */
+    if (sprt_dma)
+        iRetval = imx6ull_sdmmc_dma_transfer(sprt_usdhc, sprt_dma, sprt_data);
+    else
+        iRetval = (sprt_data->txBuffer) ? imx6ull_sdmmc_write_data(sprt_usdhc, sprt_data) : imx6ull_sdmmc_read_data(sprt_usdhc, sprt_data);
+
     switch (iRetval)
     {
         case -ER_BUSY:
             imx6ull_sdmmc_reset(sprt_usdhc, NR_ImxUsdhc_SysCtrl_ResetTuning, 100U);
             break;
 
+        case -ER_TIMEOUT:
         case -ER_SDATA_FAILD:
         case -ER_RDATA_FAILD:
             imx6ull_sdmmc_reset_transfer(sprt_host);
@@ -929,6 +1031,7 @@ static kint32_t imx6ull_sdmmc_read_data(srt_imx_usdhc_t *sprt_usdhc, struct fwk_
  */
 static void imx6ull_sdmmc_data_configure(srt_imx_usdhc_t *sprt_usdhc, struct fwk_sdcard_data *sprt_data, void *ptrData)
 {
+    struct imx6ull_sdmmc_dma *sprt_dma;
     kuint32_t iCmdXfrTyp;
     kuint32_t iMixCtrlReg;
     kuint32_t iBlockAttr;
@@ -998,6 +1101,23 @@ static void imx6ull_sdmmc_data_configure(srt_imx_usdhc_t *sprt_usdhc, struct fwk
     if (mrt_isBitSetw(NR_SdCard_CmdFlagsReadEnable, &sprt_data->flags))
         mrt_setbitl(NR_ImxUsdhc_MixCtrl_DataTransferDirection, &iMixCtrlReg);
 
+    /*!< descriptors are ready: select ADMA2, and notify by interrupt once the transfer is completed */
+    sprt_dma = imx6ull_sdmmc_dma_get(sprt_data);
+    if (sprt_dma)
+    {
+        sprt_dma->is_done = false;
+        sprt_dma->int_status = 0U;
+
+        mrt_clrbitl(IMX_USDHC_PROT_CTRL_DMASEL_MASK, &sprt_usdhc->PROT_CTRL);
+        mrt_setbitl(NR_ImxUsdhc_ProtCtrl_ADma2Select, &sprt_usdhc->PROT_CTRL);
+        mrt_writel((kuaddr_t)sprt_dma->sprt_desc, &sprt_usdhc->ADMA_SYS_ADDR);
+        mrt_setbitl(NR_ImxUsdhc_MixCtrl_DmaEnable, &iMixCtrlReg);
+
+        mrt_imx_clear_interrupt_flags(NR_ImxUsdhc_IntAllData_Bit | NR_ImxUsdhc_IntDmaErr_Bit | 
+                                                    NR_ImxUsdhc_IntDmaInterrupt_Bit, &sprt_usdhc);
+        mrt_writel(NR_ImxUsdhc_IntAllData_Bit | NR_ImxUsdhc_IntDmaErr_Bit, &sprt_usdhc->INT_SIGNAL_EN);
+    }
+
     /*!< BLK_ATT (Block Attribute) */
     iBlockAttr = mrt_readl(&sprt_usdhc->BLK_ATT);
     mrt_clrbitl(IMX_USDHC_BLK_ATT_BLKCNT_MASK | IMX_USDHC_BLK_ATT_BLKSIZE_MASK, &iBlockAttr);
@@ -1017,6 +1137,215 @@ static void imx6ull_sdmmc_data_configure(srt_imx_usdhc_t *sprt_usdhc, struct fwk
     *(kuint32_t *)ptrData = iCmdXfrTyp;
 }
 
+/*!< ------------------------------------------------------------------------- */
+/*!
+ * @brief   imx6ull_sdmmc_setup_dma
+ * @param   sprt_data
+ * @retval  errno. if failed, the data will be transferred by CPU
+ * @note    build ADMA2 descriptor table before sending read/write command
+ */
+static kint32_t imx6ull_sdmmc_setup_dma(struct fwk_sdcard_data *sprt_data)
+{
+    struct fwk_sdcard_host *sprt_host;
+    struct imx6ull_sdmmc_dma *sprt_dma;
+    struct imx6ull_sdmmc_adma2_desc *sprt_desc;
+    kuaddr_t iBuffer;
+    kusize_t iTotal, iLength;
+    kuint32_t iAlign;
+
+    if (!sprt_data)
+        return -ER_NULLPTR;
+
+    sprt_host = (struct fwk_sdcard_host *)sprt_data->ptrHost;
+    if (!isValid(sprt_host))
+        return -ER_NULLPTR;
+
+    sprt_dma = (struct imx6ull_sdmmc_dma *)sprt_host->privData;
+    if (!sprt_dma)
+        return -ER_NSUPPORT;
+
+    sprt_dma->sprt_data = mrt_nullptr;
+
+    iBuffer = (kuaddr_t)(sprt_data->txBuffer ? (const void *)sprt_data->txBuffer : (const void *)sprt_data->rxBuffer);
+    iTotal  = sprt_data->blockSize * sprt_data->blockCount;
+
+    /*!<
+     * ADMA2 requires 4 bytes aligned address and length.
+     * for reading, buffer should also be aligned to cache line, since it will be invalidated after transfer
+     */
+    iAlign = sprt_data->txBuffer ? 4U : __get_dcache_line_size();
+    if ((!iBuffer) || (!iTotal) || (iTotal > IMX_SDMMC_ADMA2_XFER_MAX_LEN) ||
+        (iBuffer & (iAlign - 1U)) || (iTotal & (iAlign - 1U)))
+        return -ER_NSUPPORT;
+
+    /*!< fill descriptors, each line covers IMX_SDMMC_ADMA2_DESC_MAX_LEN at most */
+    for (sprt_desc = sprt_dma->sprt_desc; iTotal; sprt_desc++)
+    {
+        iLength = mrt_ret_min2(iTotal, IMX_SDMMC_ADMA2_DESC_MAX_LEN);
+
+        sprt_desc->address = iBuffer;
+        sprt_desc->attr = IMX_SDMMC_ADMA2_LEN_U32(iLength) | NR_ImxSdmmc_Adma2_ActTran | NR_ImxSdmmc_Adma2_Valid;
+
+        iBuffer += iLength;
+        iTotal  -= iLength;
+    }
+
+    (sprt_desc - 1)->attr |= NR_ImxSdmmc_Adma2_End | NR_ImxSdmmc_Adma2_Int;
+
+    /*!< descriptors and data must reach memory before the controller reads them */
+    __clean_dcache_range((kuaddr_t)sprt_dma->sprt_desc, (kuaddr_t)sprt_desc - (kuaddr_t)sprt_dma->sprt_desc);
+
+    iBuffer = sprt_dma->sprt_desc->address;
+    iTotal  = sprt_data->blockSize * sprt_data->blockCount;
+    if (sprt_data->txBuffer)
+        __clean_dcache_range(iBuffer, iTotal);
+    else
+        __flush_dcache_range(iBuffer, iTotal);
+
+    /*!< stop multi blocks transfer by host itself: CMD23 if card supports, otherwise CMD12 */
+    if ((sprt_data->blockCount > 1U) && mrt_isBitSetw(NR_SdCard_CmdFlagsWithBlock, &sprt_data->flags))
+    {
+        if (mrt_isBitSetl(NR_SdCard_SupportSetBlockCount, &sprt_host->flagBit))
+            mrt_setbitw(NR_SdCard_CmdFlagsAuto23Enable, &sprt_data->flags);
+        else
+            mrt_setbitw(NR_SdCard_CmdFlagsAuto12Enable, &sprt_data->flags);
+    }
+
+    sprt_dma->sprt_data = sprt_data;
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   imx6ull_sdmmc_isr
+ * @param   ptrDev: host
+ * @retval  errno
+ * @note    data transfer completed or error occured
+ */
+static irq_return_t imx6ull_sdmmc_isr(void *ptrDev)
+{
+    struct fwk_sdcard_host *sprt_host = (struct fwk_sdcard_host *)ptrDev;
+    srt_imx_usdhc_t *sprt_usdhc = (srt_imx_usdhc_t *)sprt_host->iHostIfBase;
+    struct imx6ull_sdmmc_dma *sprt_dma = (struct imx6ull_sdmmc_dma *)sprt_host->privData;
+    kuint32_t iIntStatus;
+
+    iIntStatus = mrt_readl(&sprt_usdhc->INT_STATUS) & mrt_readl(&sprt_usdhc->INT_SIGNAL_EN);
+    if (!iIntStatus)
+        return ER_NORMAL;
+
+    /*!< mask signal only, status bits are left to the waiting thread to check and clear */
+    mrt_resetl(&sprt_usdhc->INT_SIGNAL_EN);
+
+    sprt_dma->int_status = iIntStatus;
+    sprt_dma->is_done = true;
+    wake_up(&sprt_dma->sgrt_wqh);
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   imx6ull_sdmmc_dma_is_finished
+ * @param   sprt_usdhc, sprt_dma, expires
+ * @retval  true: stop waiting
+ * @note    status is also polled, in case of interrupt is missed or scheduler is not running
+ */
+static kbool_t imx6ull_sdmmc_dma_is_finished(srt_imx_usdhc_t *sprt_usdhc, struct imx6ull_sdmmc_dma *sprt_dma, kutime_t expires)
+{
+    if (sprt_dma->is_done)
+        return true;
+
+    if (!mrt_isBitResetl(NR_ImxUsdhc_IntAllData_Bit | NR_ImxUsdhc_IntDmaErr_Bit, &sprt_usdhc->INT_STATUS))
+        return true;
+
+    return mrt_time_after(jiffies, expires);
+}
+
+/*!
+ * @brief   imx6ull_sdmmc_dma_transfer
+ * @param   sprt_usdhc, sprt_dma, sprt_data
+ * @retval  errno
+ * @note    ADMA2 has been started by read/write command, sleep until it is done
+ */
+static kint32_t imx6ull_sdmmc_dma_transfer(srt_imx_usdhc_t *sprt_usdhc, struct imx6ull_sdmmc_dma *sprt_dma, 
+                                                            struct fwk_sdcard_data *sprt_data)
+{
+    kutime_t expires = jiffies + msecs_to_jiffies(IMX_SDMMC_DMA_TIMEOUT_MS);
+    kuint32_t iIntStatus;
+    kint32_t iRetval = ER_NORMAL;
+
+    wait_event_timeout(&sprt_dma->sgrt_wqh, imx6ull_sdmmc_dma_is_finished(sprt_usdhc, sprt_dma, expires), 
+                                                            jiffies + msecs_to_jiffies(IMX_SDMMC_DMA_RECHECK_MS));
+
+    mrt_resetl(&sprt_usdhc->INT_SIGNAL_EN);
+    iIntStatus = sprt_dma->int_status | mrt_readl(&sprt_usdhc->INT_STATUS);
+
+    if (!mrt_isBitResetl(NR_ImxUsdhc_IntTuningErr_Bit, &iIntStatus))
+    {
+        mrt_imx_clear_interrupt_flags(NR_ImxUsdhc_IntTuningErr_Bit, &sprt_usdhc);
+        iRetval = -ER_BUSY;
+    }
+    else if (!mrt_isBitResetl(NR_ImxUsdhc_IntDataErr_Bit | NR_ImxUsdhc_IntDmaErr_Bit, &iIntStatus))
+        iRetval = sprt_data->txBuffer ? -ER_SDATA_FAILD : -ER_RDATA_FAILD;
+    else if (mrt_isBitResetl(NR_ImxUsdhc_IntDataComplete_Bit, &iIntStatus))
+        iRetval = -ER_TIMEOUT;
+
+    mrt_clrbitl(NR_ImxUsdhc_MixCtrl_DmaEnable, &sprt_usdhc->MIX_CTRL);
+    mrt_imx_clear_interrupt_flags(NR_ImxUsdhc_IntDmaErr_Bit | NR_ImxUsdhc_IntDmaInterrupt_Bit, &sprt_usdhc);
+
+    /*!< drop the lines that CPU may prefetched during transfer */
+    if (!sprt_data->txBuffer)
+        __invalidate_dcache_range(sprt_dma->sprt_desc->address, sprt_data->blockSize * sprt_data->blockCount);
+
+    sprt_dma->sprt_data = mrt_nullptr;
+
+    return iRetval;
+}
+
+/*!
+ * @brief   imx6ull_sdmmc_dma_initial
+ * @param   sprt_host
+ * @retval  none
+ * @note    prepare ADMA2; if anything goes wrong, host keeps working by PIO
+ */
+static void imx6ull_sdmmc_dma_initial(struct fwk_sdcard_host *sprt_host)
+{
+    struct fwk_device_node *sprt_node;
+    struct imx6ull_sdmmc_dma *sprt_dma;
+    kint32_t irq;
+
+    sprt_node = fwk_of_find_compatible_node(mrt_nullptr, mrt_nullptr, IMX_SDMMC_IF_COMPATIBLE);
+    if (!isValid(sprt_node))
+        return;
+
+    irq = fwk_of_irq_get(sprt_node, 0);
+    if (irq < 0)
+        return;
+
+    sprt_dma = (struct imx6ull_sdmmc_dma *)kzalloc(sizeof(*sprt_dma), GFP_KERNEL);
+    if (!isValid(sprt_dma))
+        return;
+
+    sprt_dma->sprt_desc = (struct imx6ull_sdmmc_adma2_desc *)
+                    kzalloc(IMX_SDMMC_ADMA2_DESC_NUM * sizeof(struct imx6ull_sdmmc_adma2_desc), GFP_KERNEL);
+    if (!isValid(sprt_dma->sprt_desc))
+        goto fail1;
+
+    init_waitqueue_head(&sprt_dma->sgrt_wqh);
+    sprt_dma->irq = irq;
+    sprt_host->privData = sprt_dma;
+
+    if (fwk_request_irq(irq, imx6ull_sdmmc_isr, IRQ_TYPE_NONE, "imx6ull-usdhc", sprt_host))
+        goto fail2;
+
+    return;
+
+fail2:
+    sprt_host->privData = mrt_nullptr;
+    kfree(sprt_dma->sprt_desc);
+fail1:
+    kfree(sprt_dma);
+}
+
 /*!
  * @brief   host_sdmmc_card_initial
  * @param   none
@@ -1067,6 +1396,11 @@ void *host_sdmmc_card_initial(struct fwk_sdcard *sprt_card)
     sprt_if->switchVoltage  = imx6ull_sdmmc_switch_voltage;
     sprt_if->addHeadTail    = mrt_nullptr;
 
+    /*!< ADMA2 is optional, transfer by CPU if irq is unavailable */
+    imx6ull_sdmmc_dma_initial(sprt_host);
+    if (sprt_host->privData)
+        sprt_if->setup_dma  = imx6ull_sdmmc_setup_dma;
+
     /*!< read but not use */
     iDoEmpty = mrt_readl(&sprt_usdhc->DATA_BUFF_ACC_PORT);
     iDoEmpty++;
@@ -1077,5 +1411,26 @@ void *host_sdmmc_card_initial(struct fwk_sdcard *sprt_card)
     return sprt_host;
 }
 
+/*!
+ * @brief   host_sdmmc_card_exit
+ * @param   sprt_host
+ * @retval  none
+ * @note    release ADMA2 resources
+ */
+void host_sdmmc_card_exit(struct fwk_sdcard_host *sprt_host)
+{
+    struct imx6ull_sdmmc_dma *sprt_dma = (struct imx6ull_sdmmc_dma *)sprt_host->privData;
+
+    if (!sprt_dma)
+        return;
+
+    imx6ull_sdmmc_dma_abort(sprt_host);
+    fwk_free_irq(sprt_dma->irq, sprt_host);
+
+    kfree(sprt_dma->sprt_desc);
+    kfree(sprt_dma);
+    sprt_host->privData = mrt_nullptr;
+}
+
 
 /* end of file */
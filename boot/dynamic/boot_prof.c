@@ -0,0 +1,275 @@
+/*
+ * Boot Timeline Profiler
+ *
+ * File Name:   boot_prof.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <configs/configs.h>
+#include <common/generic.h>
+#include <common/time.h>
+#include <boot/boot_prof.h>
+#include <kernel/sched.h>
+#include <kernel/spinlock.h>
+
+/*!< The defines */
+/*!< PMCR::D is set, PMCCNTR increases once every 64 cycles */
+#define BOOT_PROF_CYCLE_DIV                         (64U)
+
+/*!<
+ * -mpoke-function-name puts the name in front of every function:
+ * "name\0" (padded to 4 bytes), then a word of 0xff000000 + lenth of padded name
+ */
+#define BOOT_PROF_POKE_MARK                         (0xff000000U)
+#define BOOT_PROF_POKE_MASK                         (0xff000000U)
+#define BOOT_PROF_POKE_MAXLEN                       (256U)
+#define BOOT_PROF_ADDR_STRLEN                       (sizeof("0x00000000"))
+
+/*!< The globals */
+static struct boot_prof_event sgrt_boot_prof_events[BOOT_PROF_EVENTS];
+static kuint32_t g_boot_prof_count = 0;
+static kuint32_t g_boot_prof_dropped = 0;
+static kbool_t g_boot_prof_inited = false;
+
+/*!< the 32 bits counter is extended to 64 bits, it must be read at least once a wrap (~5 minutes) */
+static kuint32_t g_boot_prof_last = 0;
+static kuint64_t g_boot_prof_high = 0;
+static struct spin_lock sgrt_boot_prof_lock = SPIN_LOCK_INIT();
+
+static const kchar_t *g_boot_prof_type_names[NR_BOOT_PROF_TYPE_MAX] =
+{
+    [NR_BOOT_PROF_INITCALL] = "initcall",
+    [NR_BOOT_PROF_ASYNC]    = "async",
+    [NR_BOOT_PROF_PROBE]    = "probe",
+    [NR_BOOT_PROF_STAGE]    = "stage",
+};
+
+/*!< The functions */
+/*!
+ * @brief   read time since boot_prof_init
+ * @param   none
+ * @retval  unit: us
+ * @note    lock must be held
+ */
+static kuint64_t __boot_prof_clock_us(void)
+{
+#if defined(CONFIG_ARCH_ARMV7)
+    kuint32_t cycles = __get_cp15_pmccntr();
+
+    if (cycles < g_boot_prof_last)
+        g_boot_prof_high += (1ULL << 32);
+    g_boot_prof_last = cycles;
+
+    return ((g_boot_prof_high | cycles) * BOOT_PROF_CYCLE_DIV * 1000ULL) / (BOOT_PROF_CPU_HZ / 1000UL);
+
+#else
+    /*!< no cycle counter: resolution of jiffies, and it does not run with irq disabled */
+    return jiffies_to_usecs(jiffies);
+
+#endif
+}
+
+/*!< API function */
+/*!
+ * @brief   start counter of boot profiler
+ * @param   none
+ * @retval  none
+ * @note    call it as early as possible, time of every event is relative to it
+ */
+void boot_prof_init(void)
+{
+    if (g_boot_prof_inited)
+        return;
+
+#if defined(CONFIG_ARCH_ARMV7)
+    /*!< PMCR::C resets cycle counter to 0 */
+    __enable_cp15_pmccntr();
+#endif
+
+    g_boot_prof_last = 0;
+    g_boot_prof_high = 0;
+    g_boot_prof_inited = true;
+}
+
+/*!
+ * @brief   read time of boot profiler
+ * @param   none
+ * @retval  unit: us
+ * @note    none
+ */
+kuint64_t boot_prof_clock_us(void)
+{
+    kuint64_t now;
+
+    spin_lock_irqsave(&sgrt_boot_prof_lock);
+    now = __boot_prof_clock_us();
+    spin_unlock_irqrestore(&sgrt_boot_prof_lock);
+
+    return now;
+}
+
+/*!
+ * @brief   record the start of an event
+ * @param   type: refer to "__ERT_BOOT_PROF_TYPE"
+ * @param   func: function to be called
+ * @param   name: null to resolve from func
+ * @param   owner: driver of probe, or null
+ * @param   level: initcall section
+ * @retval  slot for boot_prof_end, or errno if log is full
+ * @note    none
+ */
+kint32_t boot_prof_begin(kuint32_t type, const void *func, const kchar_t *name, const kchar_t *owner, kuint32_t level)
+{
+    struct boot_prof_event *sprt_event;
+    struct thread *sprt_thread;
+    kint32_t slot;
+
+    if (!g_boot_prof_inited)
+        boot_prof_init();
+
+    sprt_thread = mrt_current;
+
+    spin_lock_irqsave(&sgrt_boot_prof_lock);
+
+    if (g_boot_prof_count >= BOOT_PROF_EVENTS)
+    {
+        g_boot_prof_dropped++;
+        spin_unlock_irqrestore(&sgrt_boot_prof_lock);
+
+        return -ER_FULL;
+    }
+
+    slot = g_boot_prof_count++;
+    sprt_event = &sgrt_boot_prof_events[slot];
+
+    sprt_event->type = type;
+    sprt_event->level = level;
+    sprt_event->func = func;
+    sprt_event->name = name;
+    sprt_event->owner = owner;
+    sprt_event->retval = 0;
+    sprt_event->tid = sprt_thread ? (kint32_t)sprt_thread->tid : -1;
+    sprt_event->end = 0;
+    sprt_event->start = __boot_prof_clock_us();
+
+    spin_unlock_irqrestore(&sgrt_boot_prof_lock);
+
+    return slot;
+}
+
+/*!
+ * @brief   record the end of an event
+ * @param   slot: returned by boot_prof_begin
+ * @param   retval: returned by function
+ * @retval  none
+ * @note    ignored if slot is errno
+ */
+void boot_prof_end(kint32_t slot, kint32_t retval)
+{
+    struct boot_prof_event *sprt_event;
+
+    if ((slot < 0) || (slot >= BOOT_PROF_EVENTS))
+        return;
+
+    sprt_event = &sgrt_boot_prof_events[slot];
+
+    spin_lock_irqsave(&sgrt_boot_prof_lock);
+
+    sprt_event->end = __boot_prof_clock_us();
+    sprt_event->retval = retval;
+
+    /*!< 0 means "not finished" */
+    if (!sprt_event->end)
+        sprt_event->end = 1;
+
+    spin_unlock_irqrestore(&sgrt_boot_prof_lock);
+}
+
+/*!
+ * @brief   number of recorded events
+ * @param   dropped: output, number of events that came after the log is full (can be null)
+ * @retval  number
+ * @note    none
+ */
+kuint32_t boot_prof_count(kuint32_t *dropped)
+{
+    if (dropped)
+        *dropped = g_boot_prof_dropped;
+
+    return g_boot_prof_count;
+}
+
+/*!
+ * @brief   get one recorded event
+ * @param   idx: 0 ~ boot_prof_count() - 1, in order of start
+ * @retval  event, null if idx is out of range
+ * @note    none
+ */
+struct boot_prof_event *boot_prof_get(kuint32_t idx)
+{
+    return (idx < g_boot_prof_count) ? &sgrt_boot_prof_events[idx] : mrt_nullptr;
+}
+
+/*!
+ * @brief   resolve name of function
+ * @param   func: function pointer (thumb bit is allowed)
+ * @param   buf, size: output if name is not found
+ * @retval  name
+ * @note    the name is read from the marker of -mpoke-function-name (CONFIG_BOOT_PROF_SYMBOLS);
+ *          if it is missing, the address is printed into buf
+ */
+const kchar_t *boot_prof_symbol(const void *func, kchar_t *buf, kusize_t size)
+{
+    kuaddr_t addr = ((kuaddr_t)func) & ~((kuaddr_t)1);
+#ifdef CONFIG_BOOT_PROF_SYMBOLS
+    kuint32_t mark, lenth, idx;
+    const kchar_t *name;
+#endif
+
+    if (!addr)
+        return "null";
+
+#ifdef CONFIG_BOOT_PROF_SYMBOLS
+    mark = *(const kuint32_t *)(addr - sizeof(kuint32_t));
+    lenth = mark & ~BOOT_PROF_POKE_MASK;
+
+    if (((mark & BOOT_PROF_POKE_MASK) == BOOT_PROF_POKE_MARK) &&
+        lenth && (lenth <= BOOT_PROF_POKE_MAXLEN) && !(lenth & (sizeof(kuint32_t) - 1)))
+    {
+        name = (const kchar_t *)(addr - sizeof(kuint32_t) - lenth);
+
+        /*!< the name is padded with '\0', it must end inside the marker */
+        for (idx = 0; (idx < lenth) && name[idx]; idx++);
+        if (idx && (idx < lenth))
+            return name;
+    }
+#endif
+
+    /*!< "%x" prints "0x" and up to 8 digits */
+    if (buf && (size >= BOOT_PROF_ADDR_STRLEN))
+    {
+        sprintk(buf, "%x", (kuint32_t)addr);
+        return buf;
+    }
+
+    return "unknown";
+}
+
+/*!
+ * @brief   name of event type
+ * @param   type
+ * @retval  name
+ * @note    none
+ */
+const kchar_t *boot_prof_type_name(kuint32_t type)
+{
+    return (type < NR_BOOT_PROF_TYPE_MAX) ? g_boot_prof_type_names[type] : "unknown";
+}
+
+/*!< end of file */
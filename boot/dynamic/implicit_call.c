@@ -14,6 +14,11 @@
 #include <common/generic.h>
 #include <boot/boot_text.h>
 #include <boot/implicit_call.h>
+#include <boot/boot_prof.h>
+#include <kernel/sched.h>
+#include <kernel/thread.h>
+#include <kernel/mutex.h>
+#include <kernel/wait.h>
 
 /*!< The defines */
 #define DYNAMIC_INIT_EXIT_WAYS                             IT_TRUE		/*!< 1: use API to init/exit; 0: use Macro defines */
@@ -53,6 +58,166 @@ const dync_exit_t *dync_exit_sections[] =
     [NR_DYNC_SEC_END]      = &__dync_exit_end,
 };
 
+/*!< level being run by dync_initcall_run_list */
+static kuint32_t g_dync_initcall_level = NR_DYNC_SEC_STATIC;
+
+/*!< async initcalls, queued per level */
+static struct dync_async_initcall *sprt_dync_async_list[NR_DYNC_SEC_BLK_END];
+static kuint32_t g_dync_async_pending[NR_DYNC_SEC_BLK_END];
+static kuint32_t g_dync_async_level = NR_DYNC_SEC_STATIC;      /*!< level being run by boot workers */
+static kuint32_t g_dync_async_total = 0;                       /*!< not finished of all levels */
+static kuint32_t g_dync_async_running = 0;
+static kuint32_t g_dync_async_events = 0;                      /*!< increased once an initcall finishes */
+static struct mutex_lock sgrt_dync_async_lock = MUTEX_LOCK_INIT();
+static struct wait_queue_head sgrt_dync_async_wqh;
+
+/*!< The functions */
+/*!
+ * @brief   finish one async initcall
+ * @param   sprt_async, retval
+ * @retval  none
+ * @note    lock must be held; the level of workers moves on once it is empty
+ */
+static void dync_initcall_async_finish(struct dync_async_initcall *sprt_async, kint32_t retval)
+{
+    if (sprt_async->state == NR_DYNC_ASYNC_RUNNING)
+        g_dync_async_running--;
+
+    sprt_async->retval = retval;
+    sprt_async->state = (retval < 0) ? NR_DYNC_ASYNC_FAILED : NR_DYNC_ASYNC_DONE;
+
+    if (retval < 0)
+        print_err("async initcall %s failed, errno: %d\n", sprt_async->name, retval);
+
+    g_dync_async_pending[sprt_async->level]--;
+    g_dync_async_total--;
+    g_dync_async_events++;
+
+    /*!< barrier: the next level starts only after this one is empty */
+    while ((g_dync_async_level < NR_DYNC_SEC_BLK_END) && !g_dync_async_pending[g_dync_async_level])
+        g_dync_async_level++;
+}
+
+/*!
+ * @brief   take one async initcall that can run now
+ * @param   none
+ * @retval  initcall, null if none
+ * @note    lock must be held
+ */
+static struct dync_async_initcall *dync_initcall_async_pick(void)
+{
+    struct dync_async_initcall *sprt_async, *sprt_dep;
+
+    if (g_dync_async_level >= NR_DYNC_SEC_BLK_END)
+        return mrt_nullptr;
+
+    for (sprt_async = sprt_dync_async_list[g_dync_async_level]; sprt_async; sprt_async = sprt_async->sprt_next)
+    {
+        if (sprt_async->state != NR_DYNC_ASYNC_QUEUED)
+            continue;
+
+        /*!< dependencies of earlier levels are finished already, those of later levels can not be waited for */
+        sprt_dep = sprt_async->sprt_dep;
+        if (sprt_dep && (sprt_dep->level == sprt_async->level) &&
+            ((sprt_dep->state == NR_DYNC_ASYNC_QUEUED) || (sprt_dep->state == NR_DYNC_ASYNC_RUNNING)))
+            continue;
+
+        return sprt_async;
+    }
+
+    return mrt_nullptr;
+}
+
+/*!
+ * @brief   run async initcalls until all levels are finished
+ * @param   none
+ * @retval  none
+ * @note    every boot worker runs it, the thread that starts workers runs it too if no worker can be created
+ */
+static void dync_initcall_async_worker(void)
+{
+    struct dync_async_initcall *sprt_async, *sprt_dep;
+    kuint32_t events;
+    kint32_t slot, retval;
+
+    for (;;)
+    {
+        mutex_lock(&sgrt_dync_async_lock);
+
+        if (!g_dync_async_total)
+        {
+            mutex_unlock(&sgrt_dync_async_lock);
+            break;
+        }
+
+        sprt_async = dync_initcall_async_pick();
+        if (sprt_async)
+        {
+            sprt_async->state = NR_DYNC_ASYNC_RUNNING;
+            g_dync_async_running++;
+        }
+        else if (!g_dync_async_running)
+        {
+            /*!< nothing runs and nothing can run: dependencies of this level are circular */
+            sprt_async = sprt_dync_async_list[g_dync_async_level];
+            for (; sprt_async; sprt_async = sprt_async->sprt_next)
+            {
+                if (sprt_async->state == NR_DYNC_ASYNC_QUEUED)
+                    dync_initcall_async_finish(sprt_async, -ER_CHECKERR);
+            }
+
+            mutex_unlock(&sgrt_dync_async_lock);
+            wake_up(&sgrt_dync_async_wqh);
+            continue;
+        }
+
+        events = g_dync_async_events;
+        mutex_unlock(&sgrt_dync_async_lock);
+
+        if (!sprt_async)
+        {
+            wait_event(&sgrt_dync_async_wqh, events != g_dync_async_events);
+            continue;
+        }
+
+        sprt_dep = sprt_async->sprt_dep;
+        if (sprt_dep && (sprt_dep->state != NR_DYNC_ASYNC_DONE))
+        {
+            print_err("async initcall %s: %s is not ready\n", sprt_async->name, sprt_dep->name);
+            retval = -ER_NREADY;
+        }
+        else
+        {
+            slot = boot_prof_begin(NR_BOOT_PROF_ASYNC, (const void *)sprt_async->func,
+                                    sprt_async->name, mrt_nullptr, sprt_async->level);
+            retval = sprt_async->func();
+            boot_prof_end(slot, retval);
+        }
+
+        mutex_lock(&sgrt_dync_async_lock);
+        dync_initcall_async_finish(sprt_async, retval);
+        mutex_unlock(&sgrt_dync_async_lock);
+
+        wake_up(&sgrt_dync_async_wqh);
+    }
+}
+
+/*!
+ * @brief   boot worker thread entry
+ * @param   args: none
+ * @retval  none
+ * @note    the worker stays suspended after all levels are finished
+ */
+static void *dync_initcall_async_entry(void *args)
+{
+    dync_initcall_async_worker();
+
+    for (;;)
+        schedule_self_suspend();
+
+    return args;
+}
+
 /* API functions */
 /*!
  * @brief   dync_initcall_run_list
@@ -63,19 +228,138 @@ const dync_exit_t *dync_exit_sections[] =
 kint32_t dync_initcall_run_list(const kuint32_t section)
 {
 	const dync_init_t *pFunc_init;
+    kint32_t slot, retval;
 
     if (section >= NR_DYNC_SEC_END)
         return -ER_NOMEM;
 
+    /*!< async initcalls called from here are queued on this level */
+    g_dync_initcall_level = (section < NR_DYNC_SEC_BLK_END) ? section : NR_DYNC_SEC_OTHERS;
+
 	for (pFunc_init = dync_init_sections[section]; (*pFunc_init) && (pFunc_init < dync_init_sections[section + 1]); pFunc_init++)
 	{
-		if (0 > ((*pFunc_init)()))
+        slot = boot_prof_begin(NR_BOOT_PROF_INITCALL, (const void *)(*pFunc_init), mrt_nullptr, mrt_nullptr, section);
+        retval = (*pFunc_init)();
+        boot_prof_end(slot, retval);
+
+		if (0 > retval)
 			return -ER_ERROR;
 	}
 
 	return ER_NORMAL;
 }
 
+/*!
+ * @brief   queue async initcall
+ * @param   sprt_async: defined by IMPORT_xxx_INIT_ASYNC
+ * @retval  errno
+ * @note    called by the stub in section; if there is no boot worker, it is called at once
+ */
+kint32_t dync_initcall_async(struct dync_async_initcall *sprt_async)
+{
+    struct dync_async_initcall **sprt_pos;
+    kuint32_t level;
+
+    if (!sprt_async || !sprt_async->func)
+        return -ER_NULLPTR;
+
+    if (sprt_async->state != NR_DYNC_ASYNC_IDLE)
+        return -ER_EXISTED;
+
+#if (!CONFIG_SCHDULE) || (!DYNC_ASYNC_WORKERS)
+    sprt_async->retval = sprt_async->func();
+    sprt_async->state = (sprt_async->retval < 0) ? NR_DYNC_ASYNC_FAILED : NR_DYNC_ASYNC_DONE;
+
+    return sprt_async->retval;
+
+#else
+    mutex_lock(&sgrt_dync_async_lock);
+
+    level = g_dync_initcall_level;
+    sprt_async->level = level;
+    sprt_async->retval = 0;
+    sprt_async->state = NR_DYNC_ASYNC_QUEUED;
+    sprt_async->sprt_next = mrt_nullptr;
+
+    /*!< keep the order of section */
+    for (sprt_pos = &sprt_dync_async_list[level]; *sprt_pos; sprt_pos = &(*sprt_pos)->sprt_next);
+    *sprt_pos = sprt_async;
+
+    g_dync_async_pending[level]++;
+    g_dync_async_total++;
+
+    /*!< workers start from the lowest level that has work */
+    if (g_dync_async_level > level)
+        g_dync_async_level = level;
+
+    mutex_unlock(&sgrt_dync_async_lock);
+
+    return ER_NORMAL;
+
+#endif
+}
+
+/*!
+ * @brief   start boot workers
+ * @param   none
+ * @retval  none
+ * @note    call it once the scheduler runs; 
+ *          if no worker can be created, the queued initcalls are run by the caller
+ */
+void dync_initcall_async_start(void)
+{
+    tid_t tid;
+    kuint32_t idx, workers = 0;
+
+    init_waitqueue_head(&sgrt_dync_async_wqh);
+
+    if (!g_dync_async_total)
+        return;
+
+    /*!< skip levels without async initcalls */
+    mutex_lock(&sgrt_dync_async_lock);
+    while ((g_dync_async_level < NR_DYNC_SEC_BLK_END) && !g_dync_async_pending[g_dync_async_level])
+        g_dync_async_level++;
+    mutex_unlock(&sgrt_dync_async_lock);
+
+    for (idx = 0; idx < DYNC_ASYNC_WORKERS; idx++)
+    {
+        tid = kernel_thread_create(-1, mrt_nullptr, dync_initcall_async_entry, mrt_nullptr);
+        if (tid < 0)
+            break;
+
+        thread_set_priority(mrt_tid_attr(tid), THREAD_PROTY_KWORKER);
+        thread_set_name(tid, "dync_initcall_async_entry");
+        workers++;
+    }
+
+    if (!workers)
+        dync_initcall_async_worker();
+}
+
+/*!
+ * @brief   wait for async initcall
+ * @param   sprt_async: null means all of them
+ * @retval  errno of initcall
+ * @note    for whom uses a device that is probed asynchronously
+ */
+kint32_t dync_initcall_async_wait(struct dync_async_initcall *sprt_async)
+{
+    if (!sprt_async)
+    {
+        wait_event(&sgrt_dync_async_wqh, !g_dync_async_total);
+        return ER_NORMAL;
+    }
+
+    if (sprt_async->state == NR_DYNC_ASYNC_IDLE)
+        return -ER_NOTFOUND;
+
+    wait_event(&sgrt_dync_async_wqh, (sprt_async->state == NR_DYNC_ASYNC_DONE) || 
+                                    (sprt_async->state == NR_DYNC_ASYNC_FAILED));
+
+    return sprt_async->retval;
+}
+
 /*!
  * @brief   dync_exitcall_run_list
  * @param   none
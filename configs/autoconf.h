@@ -10,6 +10,7 @@
 #define CONFIG_VFP 1
 #define CONFIG_BUILD_TYPE debug
 #define CONFIG_OPTIMIZE_CLASS 2
+#define CONFIG_BOOT_PROF_CPU_HZ (666666667)
 #define CONFIG_XTAL_FREQ_CLK (24000000)
 #define CONFIG_RTC_FREQ_CLK (32768)
 #define CONFIG_RAM_DDR_ORIGIN (0x00100000)
@@ -48,7 +49,7 @@
 #define CONFIG_VIDEO 1
 #define CONFIG_USB 1
 #define CONFIG_FB_MULTI_SUPPORT 1
-#define CONFIG_FBUFFER_NUM 2
+#define CONFIG_FBUFFER_NUM 3
 #define CONFIG_CPU_ZYNQ 1
 #define CONFIG_CLOCK_ZYNQ 1
 #define CONFIG_SDK_LED_ZYNQ 1
@@ -314,11 +314,49 @@ static kint32_t at24cxx_driver_ioctl(struct fwk_file *sprt_file, kuint32_t cmd,
     return (retval < 0) ? retval : ER_NORMAL;
 }
 
+/*!
+ * @brief   driver pread
+ * @param   sprt_file, buffer, size
+ * @param   offset: address of eeprom
+ * @retval  size read, or errno
+ * @note    none
+ */
+static kssize_t at24cxx_driver_pread(struct fwk_file *sprt_file, kbuffer_t *buffer, kssize_t size, kuint32_t offset)
+{
+    struct fwk_eeprom sgrt_eep = {};
+
+    sgrt_eep.addr = offset;
+    sgrt_eep.buf = (kuint8_t *)buffer;
+    sgrt_eep.size = size;
+
+    return __at24cxx_driver_read(sprt_file->private_data, &sgrt_eep);
+}
+
+/*!
+ * @brief   driver pwrite
+ * @param   sprt_file, buffer, size
+ * @param   offset: address of eeprom
+ * @retval  size written, or errno
+ * @note    none
+ */
+static kssize_t at24cxx_driver_pwrite(struct fwk_file *sprt_file, const kbuffer_t *buffer, kssize_t size, kuint32_t offset)
+{
+    struct fwk_eeprom sgrt_eep = {};
+
+    sgrt_eep.addr = offset;
+    sgrt_eep.buf = (kuint8_t *)buffer;
+    sgrt_eep.size = size;
+
+    return __at24cxx_driver_write(sprt_file->private_data, &sgrt_eep);
+}
+
 static const struct fwk_file_oprts sgrt_at24cxx_driver_oprts =
 {
     .open = at24cxx_driver_open,
     .close = at24cxx_driver_close,
     .unlocked_ioctl = at24cxx_driver_ioctl,
+    .pread = at24cxx_driver_pread,
+    .pwrite = at24cxx_driver_pwrite,
 };
 
 /*!< --------------------------------------------------------------------- */
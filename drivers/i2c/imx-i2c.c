@@ -690,7 +690,7 @@ static kint32_t imx_i2c_driver_probe(struct fwk_platdev *sprt_pdev)
 	struct fwk_i2c_adapter *sprt_adap;
 	struct fwk_device *sprt_dev;
 	kuaddr_t reg;
-	kint32_t retval;
+	kint32_t retval = -ER_ERROR;
 
 	sprt_data = kzalloc(sizeof(*sprt_data), GFP_KERNEL);
 	if (!isValid(sprt_data))
@@ -715,7 +715,12 @@ static kint32_t imx_i2c_driver_probe(struct fwk_platdev *sprt_pdev)
 
     sprt_data->sprt_clk = fwk_clk_get(sprt_dev, mrt_nullptr);
     if (!sprt_data->sprt_clk)
+    {
+        if (fwk_clk_is_deferred(sprt_dev, mrt_nullptr))
+            retval = fwk_device_defer_probe(sprt_dev, "clock provider is not registered");
+
         goto fail2;
+    }
 
 	sprt_adap->sgrt_dev.sprt_parent = sprt_dev;
 	sprt_adap->sgrt_dev.sprt_node = sprt_dev->sprt_node;
@@ -752,7 +757,7 @@ fail2:
 fail1:
 	kfree(sprt_data);
 
-	return -ER_ERROR;
+	return (retval == -ER_DEFER) ? retval : -ER_ERROR;
 }
 
 /*!
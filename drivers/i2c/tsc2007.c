@@ -385,11 +385,28 @@ static kssize_t tsc2007_driver_read(struct fwk_file *sprt_file, kbuffer_t *buffe
     return bytes;
 }
 
+/*!
+ * @brief   driver poll
+ * @param   sprt_file, sprt_pt
+ * @retval  POLLIN if a new sample can be read
+ * @note    none
+ */
+static kuint32_t tsc2007_driver_poll(struct fwk_file *sprt_file, struct fwk_poll_table *sprt_pt)
+{
+    struct tsc2007_drv_info *sprt_info;
+
+    sprt_info = sprt_file->private_data;
+    fwk_poll_wait(sprt_file, &sprt_info->sgrt_wqh, sprt_pt);
+
+    return sprt_info->is_can_read ? (POLLIN | POLLRDNORM) : 0;
+}
+
 static const struct fwk_file_oprts sgrt_tsc2007_driver_oprts =
 {
     .open = tsc2007_driver_open,
     .close = tsc2007_driver_close,
     .read = tsc2007_driver_read,
+    .poll = tsc2007_driver_poll,
 };
 
 /*!< --------------------------------------------------------------------- */
@@ -136,6 +136,22 @@ static kssize_t extkey_driver_read(struct fwk_file *sprt_file, kbuffer_t *ptrBuf
 	return 0;
 }
 
+/*!
+ * @brief   extkey_driver_poll
+ * @param   sprt_file, sprt_pt
+ * @retval  POLLIN if key is pressed since last read
+ * @note    none
+ */
+static kuint32_t extkey_driver_poll(struct fwk_file *sprt_file, struct fwk_poll_table *sprt_pt)
+{
+	struct extkey_drv_data *sprt_data;
+
+	sprt_data = (struct extkey_drv_data *)sprt_file->private_data;
+	fwk_poll_wait(sprt_file, &sprt_data->sgrt_wqh, sprt_pt);
+
+	return sprt_data->wake ? (POLLIN | POLLRDNORM) : 0;
+}
+
 /*!< extkey-template driver operation */
 const struct fwk_file_oprts sgrt_extkey_driver_oprts =
 {
@@ -143,6 +159,7 @@ const struct fwk_file_oprts sgrt_extkey_driver_oprts =
 	.close	= extkey_driver_close,
 	.write	= extkey_driver_write,
 	.read	= extkey_driver_read,
+	.poll	= extkey_driver_poll,
 };
 
 /*!< --------------------------------------------------------------------- */
@@ -30,6 +30,8 @@ struct loopback_drv_data
 };
 
 #define LOOPBACK_MAC_ADDR                           { 0x00, 0x0a, 0x35, 0x00, 0x01, 0x22 }
+#define LOOPBACK_SKB_CACHE_SMALL                    (32)
+#define LOOPBACK_SKB_CACHE_MTU                      (16)
 
 /*!< The globals */
 static struct loopback_drv_data sgrt_loopback_drv_data;
@@ -50,7 +52,7 @@ static kssize_t loopback_driver_recv(struct fwk_net_device *sprt_ndev, void *buf
     kuint32_t head_len;
 
     head_len = SKB_DATA_HEAD_LEN(NET_ETHER_HDR_LEN);
-    sprt_skb = fwk_alloc_skb(len + 2 * head_len, GFP_KERNEL);
+    sprt_skb = fwk_netdev_alloc_skb(sprt_ndev, len + 2 * head_len, GFP_KERNEL);
     if (!isValid(sprt_skb))
         return -ER_NOMEM;
 
@@ -66,14 +68,19 @@ static kssize_t loopback_driver_recv(struct fwk_net_device *sprt_ndev, void *buf
     fwk_skb_set_mac_header(sprt_skb, 0);
     fwk_skb_set_network_header(sprt_skb, NET_ETHER_HDR_LEN);
 
-    /*!< commit to rx queue */
-    fwk_netif_rx(sprt_skb);
+    /*!< skb belongs to rx thread once committed, it cannot be accessed any more */
+    len = sprt_skb->len;
+    fwk_skb_record_rx_queue(sprt_skb, 0);
+
+    /*!< commit to rx queue (dropped and released if queue is full) */
+    if (fwk_netif_rx(sprt_skb))
+        return -ER_FULL;
 
     sprt_ndev->last_rx = jiffies;
     sprt_ndev->sgrt_stats.rx_packets++;
-    sprt_ndev->sgrt_stats.rx_bytes += sprt_skb->len;
+    sprt_ndev->sgrt_stats.rx_bytes += len;
 
-    return sprt_skb->len;
+    return len;
 
 fail:
     kfree_skb(sprt_skb);
@@ -303,6 +310,10 @@ static kint32_t loopback_driver_probe(struct loopback_drv_data *sprt_data)
     sprt_ndev->private_data = sprt_data;
     sprt_data->sprt_ndev = sprt_ndev;
 
+    /*!< not fatal, skbs will be allocated from GFP_SOCK if failed */
+    if (fwk_skb_cache_create(sprt_ndev, LOOPBACK_SKB_CACHE_SMALL, LOOPBACK_SKB_CACHE_MTU))
+        print_warn("loopback: skb cache is not available\n");
+
     retval = fwk_register_netdevice(sprt_ndev);
     if (retval)
         goto fail;
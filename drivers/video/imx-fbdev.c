@@ -22,6 +22,7 @@
 #include <platform/gpio/fwk_gpiodesc.h>
 #include <platform/fwk_uaccess.h>
 #include <platform/video/fwk_fbmem.h>
+#include <kernel/wait.h>
 
 #include <imx6/imx6ull_periph.h>
 
@@ -56,12 +57,27 @@ struct imx_fbdev_drv
 
 	struct fwk_clk *sprt_clk[3];
 	struct imx_fbdev_backlight sgrt_blight;
+
+	kint32_t irq;
+	volatile kuint32_t vsync_cnt;						/*!< frames done */
+	struct wait_queue_head sgrt_wqh;
 };
 
 #define FBDEV_IMX_DRIVER_MINOR					0
 
+#define FBDEV_IMX_FRAME_SIZE					(480 * 272 * 4)
+#if (defined(CONFIG_FBUFFER_NUM) && (CONFIG_FBUFFER_NUM >= 2))
+#define FBDEV_IMX_FRAME_NUM						(2)
+#else
+#define FBDEV_IMX_FRAME_NUM						(1)
+#endif
+
+/*!< CTRL1 */
+#define FBDEV_IMX_CUR_FRAME_DONE_IRQ			mrt_bit(9)
+#define FBDEV_IMX_CUR_FRAME_DONE_IRQ_EN			mrt_bit(13)
+
 /* The globals */
-static kuint8_t g_imx_fbdev_buffer[480 * 272 * 4];
+static kuint8_t g_imx_fbdev_buffer[FBDEV_IMX_FRAME_SIZE * FBDEV_IMX_FRAME_NUM];
 
 /*!< API function */
 /*!
@@ -147,6 +163,13 @@ static void imx_fbdev_init(void *base, struct imx_fbdev_drv *sprt_drv)
 	 */
 	mrt_writel(mrt_bit_nr(0x7, 16), &sprt_lcdif->CTRL1);
 
+	/*!<
+	 * bit13: CUR_FRAME_DONE_IRQ_EN. 
+	 * bit9: CUR_FRAME_DONE_IRQ. Set when a frame is done, NEXT_BUF is loaded into CUR_BUF at this time.
+	 */
+	mrt_writel(FBDEV_IMX_CUR_FRAME_DONE_IRQ, &sprt_lcdif->CTRL1_CLR);
+	mrt_writel(FBDEV_IMX_CUR_FRAME_DONE_IRQ_EN, &sprt_lcdif->CTRL1_SET);
+
 	/*!<
 	 * TRANSFER_COUNT: eLCDIF Horizontal and Vertical Valid Data Count Register
 	 * bit[31:16]: Number of horizontal lines per frame which contain valid data.
@@ -242,12 +265,88 @@ static kint32_t imx_fbdev_close(struct fwk_fb_info *sprt_info, kint32_t user)
 	return ER_NORMAL;
 }
 
+/*!
+ * @brief   driver pan display
+ * @param   sprt_info, sprt_var
+ * @retval  errno
+ * @note    NEXT_BUF is taken by eLCDIF at the end of current frame
+ */
+static kint32_t imx_fbdev_pan_display(struct fwk_fb_info *sprt_info, struct fwk_fb_var_screen_info *sprt_var)
+{
+	struct imx_fbdev_drv *sprt_drv;
+	srt_imx_lcdif_t *sprt_lcdif;
+	kuaddr_t new_smem;
+
+	sprt_drv = fwk_fb_get_drvdata(sprt_info);
+	sprt_lcdif = (srt_imx_lcdif_t *)sprt_drv->base;
+
+	new_smem  = sprt_info->sgrt_fix.smem_start;
+	new_smem += sprt_var->yoffset * sprt_info->sgrt_fix.line_lenth;
+	new_smem += sprt_var->xoffset * (sprt_info->sgrt_var.bits_per_pixel >> 3);
+
+	mrt_writel(new_smem, &sprt_lcdif->NEXT_BUF);
+
+	return ER_NORMAL;
+}
+
+/*!
+ * @brief   driver wait for vsync
+ * @param   sprt_info, timeout: unit: ms, 0 means forever
+ * @retval  errno
+ * @note    woken up by frame done interrupt
+ */
+static kint32_t imx_fbdev_wait_vsync(struct fwk_fb_info *sprt_info, kuint32_t timeout)
+{
+	struct imx_fbdev_drv *sprt_drv;
+	kuint32_t count;
+	kutime_t expires;
+
+	sprt_drv = fwk_fb_get_drvdata(sprt_info);
+	count = sprt_drv->vsync_cnt;
+
+	if (!timeout)
+		wait_event_interruptible(&sprt_drv->sgrt_wqh, count != sprt_drv->vsync_cnt);
+	else
+	{
+		/*!< schedule_timeout() takes an absolute expiry, and the wait loops until the condition holds */
+		expires = jiffies + msecs_to_jiffies(timeout);
+		wait_event_interruptible_timeout(&sprt_drv->sgrt_wqh, 
+									(count != sprt_drv->vsync_cnt) || !mrt_time_after(expires, jiffies), expires);
+	}
+
+	return (count != sprt_drv->vsync_cnt) ? ER_NORMAL : -ER_TIMEOUT;
+}
+
 static const struct fwk_fb_oprts sgrt_fwk_fb_ops =
 {
 	.fb_open = imx_fbdev_open,
 	.fb_release = imx_fbdev_close,
+	.fb_pan_display = imx_fbdev_pan_display,
+	.fb_wait_vsync = imx_fbdev_wait_vsync,
 };
 
+/*!
+ * @brief  frame done --- interrupt handler
+ * @param  ptrDev
+ * @retval none
+ * @note   none
+ */
+static irq_return_t imx_fbdev_isr(void *ptrDev)
+{
+	struct imx_fbdev_drv *sprt_drv = (struct imx_fbdev_drv *)ptrDev;
+	srt_imx_lcdif_t *sprt_lcdif = (srt_imx_lcdif_t *)sprt_drv->base;
+
+	if (mrt_isBitSetl(FBDEV_IMX_CUR_FRAME_DONE_IRQ, &sprt_lcdif->CTRL1))
+	{
+		mrt_writel(FBDEV_IMX_CUR_FRAME_DONE_IRQ, &sprt_lcdif->CTRL1_CLR);
+		sprt_drv->vsync_cnt++;
+
+		wake_up_interruptible(&sprt_drv->sgrt_wqh);
+	}
+
+	return 0;
+}
+
 /*!< --------------------------------------------------------------------- */
 /*!
  * @brief   probe backlight
@@ -443,6 +542,12 @@ static kint32_t imx_fbdev_driver_probe(struct fwk_platdev *sprt_pdev)
 	sprt_drv->base = base;
 	sprt_drv->sprt_fb = sprt_fb;
 	sprt_drv->sprt_dev = &sprt_pdev->sgrt_dev;
+	sprt_drv->vsync_cnt = 0;
+	init_waitqueue_head(&sprt_drv->sgrt_wqh);
+
+	sprt_drv->irq = fwk_platform_get_irq(sprt_pdev, 0);
+	if (sprt_drv->irq < 0)
+		goto fail2;
 
 	sprt_drv->sprt_clk[0] = fwk_clk_get(&sprt_pdev->sgrt_dev, "pix");
 	if (!isValid(sprt_drv->sprt_clk[0]))
@@ -466,17 +571,38 @@ static kint32_t imx_fbdev_driver_probe(struct fwk_platdev *sprt_pdev)
 
 	sprt_fb->sprt_fbops = &sgrt_fwk_fb_ops;
 	sprt_fb->node = sprt_drv->minor;
+	sprt_fb->sgrt_fix.line_lenth = sprt_fb->sgrt_var.xres * (sprt_fb->sgrt_var.bits_per_pixel >> 3);
 	sprt_fb->sgrt_fix.smem_start = (kuaddr_t)(&g_imx_fbdev_buffer[0]);
-	sprt_fb->sgrt_fix.smem_len = sizeof(g_imx_fbdev_buffer);
+	sprt_fb->sgrt_fix.smem_len = sprt_fb->sgrt_fix.line_lenth * sprt_fb->sgrt_var.yres;
+	if (sprt_fb->sgrt_fix.smem_len > FBDEV_IMX_FRAME_SIZE)
+		goto fail6;
+
+	sprt_fb->sgrt_var.xoffset = sprt_fb->sgrt_var.yoffset = 0;
+	sprt_fb->sgrt_var.xres_virtual = sprt_fb->sgrt_var.xres;
+	sprt_fb->sgrt_var.yres_virtual = sprt_fb->sgrt_var.yres;
+	sprt_fb->screen_base = (kuint8_t *)sprt_fb->sgrt_fix.smem_start;
+	sprt_fb->screen_size = sprt_fb->sgrt_fix.smem_len;
+
+	/*!< the second frame is reached by panning */
+	if (sizeof(g_imx_fbdev_buffer) >= (2 * sprt_fb->sgrt_fix.smem_len))
+	{
+		sprt_fb->sgrt_var.yres_virtual <<= 1;
+		sprt_fb->screen_size <<= 1;
+	}
 
 	retval = fwk_register_framebuffer(sprt_fb);
 	if (retval < 0)
 		goto fail6;
 
+	if (fwk_request_irq(sprt_drv->irq, imx_fbdev_isr, IRQ_TYPE_NONE, "imx,lcdif", sprt_drv))
+		goto fail7;
+
 	imx_fbdev_init(base, sprt_drv);
 
 	return ER_NORMAL;
 
+fail7:
+	fwk_unregister_framebuffer(sprt_fb);
 fail6:
 	imx_fbdev_remove_backlight(&sprt_drv->sgrt_blight);
 fail5:
@@ -511,6 +637,9 @@ static kint32_t imx_fbdev_driver_remove(struct fwk_platdev *sprt_pdev)
 	sprt_drv = (struct imx_fbdev_drv *)fwk_platform_get_drvdata(sprt_pdev);
 	sprt_fb = sprt_drv->sprt_fb;
 
+	mrt_writel(FBDEV_IMX_CUR_FRAME_DONE_IRQ_EN, &((srt_imx_lcdif_t *)sprt_drv->base)->CTRL1_CLR);
+	fwk_free_irq(sprt_drv->irq, sprt_drv);
+
 	fwk_unregister_framebuffer(sprt_fb);
 	fwk_platform_set_drvdata(sprt_pdev, mrt_nullptr);
 
@@ -22,6 +22,10 @@
 #include <platform/gpio/fwk_gpiodesc.h>
 #include <platform/fwk_uaccess.h>
 #include <platform/video/fwk_fbmem.h>
+#include <kernel/sleep.h>
+#include <kernel/sched.h>
+#include <kernel/thread.h>
+#include <kernel/wait.h>
 
 #include <zynq7/zynq7_periph.h>
 
@@ -33,6 +37,16 @@
 #define XSDK_HDMI_DRAM_SIZE    \
                     (XSDK_HDMI_XPRES_MAX * XSDK_HDMI_YPRES_MAX * XSDK_HDMI_BPP_MAX)
 
+/*!< frames in framebuffer memory, 3 for triple buffering */
+#define XSDK_HDMI_FRAME_MAX                 (3)
+#ifdef CONFIG_FBUFFER_NUM
+#define XSDK_HDMI_FRAME_NUM                 CMP_MIN2(CONFIG_FBUFFER_NUM, XSDK_HDMI_FRAME_MAX)
+#else
+#define XSDK_HDMI_FRAME_NUM                 (1)
+#endif
+
+#define XSDK_HDMI_VBLANK_TIMEOUT            (100)       /*!< unit: ms */
+
 struct xsdk_hdmi_trigger
 {
 	kuint32_t hsync_active;
@@ -41,6 +55,31 @@ struct xsdk_hdmi_trigger
 	kuint32_t pixelclk_active;
 };
 
+/*!< 
+ * multi-buffer manager:
+ * the renderer draws into a free frame and submits it by panning, it never waits;
+ * at every vblank the newest submitted frame is parked, older ones are dropped.
+ * threads never exit, so the worker outlives the driver data: it is created once,
+ * and remove only unbinds the driver from it
+ */
+struct xsdk_hdmi_flip
+{
+    kint32_t front;                                     /*!< frame on screen */
+    kint32_t queued;                                    /*!< parked, taken by VDMA at the next frame sync */
+    kint32_t ready;                                     /*!< newest submitted frame, not parked yet */
+    kutime_t queued_stamp;
+    kutime_t ready_stamp;
+    kuint32_t num_frames;
+
+    struct xsdk_hdmi_drv *sprt_drv;                     /*!< bound driver, mrt_nullptr if there is none */
+    kbool_t busy;                                       /*!< worker is using sprt_drv */
+
+    struct fwk_fb_flip_stats sgrt_stats;
+    struct spin_lock sgrt_lock;
+    struct wait_queue_head sgrt_wqh;
+    tid_t tid;
+};
+
 struct xsdk_hdmi_drv
 {
     kuint32_t minor;
@@ -54,11 +93,21 @@ struct xsdk_hdmi_drv
     XAxiVdma sgrt_axivdma;
     XAxiVdma_Config sgrt_axicfg;
     XVtc_Config sgrt_vcfg;
+
+    struct xsdk_hdmi_flip *sprt_flip;
 };
 
 #define XSDK_HDMI_DRIVER_MINOR				0
 
 /* The globals */
+static struct xsdk_hdmi_flip sgrt_xsdk_hdmi_flip =
+{
+    .front = 0,
+    .queued = -1,
+    .ready = -1,
+    .sprt_drv = mrt_nullptr,
+    .tid = -1,
+};
 
 /*!< API function */
 /*!
@@ -127,6 +176,222 @@ static kint32_t xsdk_hdmi_init(void *base, struct xsdk_hdmi_drv *sprt_drv)
     return ER_NORMAL;
 }
 
+/*!
+ * @brief   wait for the start of vertical blanking
+ * @param   sprt_drv, timeout: unit: ms, 0 means forever
+ * @retval  errno
+ * @note    VTC has no interrupt line here, so its vblank status is polled
+ */
+static kint32_t xsdk_hdmi_poll_vblank(struct xsdk_hdmi_drv *sprt_drv, kuint32_t timeout)
+{
+    kuint32_t vtc_base;
+    kutime_t expires;
+
+    vtc_base = sprt_drv->sgrt_dctrl.vtc.Config.BaseAddress;
+    expires = jiffies + msecs_to_jiffies(timeout);
+
+    /*!< status bits are write-1-to-clear; drop the one of the last frame */
+    XVtc_WriteReg(vtc_base, XVTC_ISR_OFFSET, XVTC_IXR_G_VBLANK_MASK);
+
+    while (!(XVtc_ReadReg(vtc_base, XVTC_ISR_OFFSET) & XVTC_IXR_G_VBLANK_MASK))
+    {
+        if (timeout && mrt_time_after(jiffies, expires))
+            return -ER_TIMEOUT;
+
+        schedule_delay_ms(1);
+    }
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   driver wait for vsync
+ * @param   sprt_info, timeout: unit: ms
+ * @retval  errno
+ * @note    none
+ */
+static kint32_t xsdk_hdmi_wait_vsync(struct fwk_fb_info *sprt_info, kuint32_t timeout)
+{
+    return xsdk_hdmi_poll_vblank(fwk_fb_get_drvdata(sprt_info), timeout);
+}
+
+/*!
+ * @brief   address of frame
+ * @param   sprt_info, index
+ * @retval  physical address
+ * @note    none
+ */
+static inline kuint32_t xsdk_hdmi_frame_addr(struct fwk_fb_info *sprt_info, kint32_t index)
+{
+    return sprt_info->sgrt_fix.smem_start + index * sprt_info->sgrt_fix.smem_len;
+}
+
+/*!
+ * @brief   flip worker
+ * @param   args: flip manager
+ * @retval  none
+ * @note    sleeps if there is nothing to be shown
+ */
+static void *xsdk_hdmi_flip_entry(void *args)
+{
+    struct xsdk_hdmi_flip *sprt_flip = (struct xsdk_hdmi_flip *)args;
+    struct fwk_fb_flip_stats *sprt_stats = &sprt_flip->sgrt_stats;
+    struct xsdk_hdmi_drv *sprt_drv;
+    kint32_t index;
+    kuint32_t latency;
+
+    for (;;)
+    {
+        wait_event(&sprt_flip->sgrt_wqh, 
+                sprt_flip->sprt_drv && ((sprt_flip->ready >= 0) || (sprt_flip->queued >= 0)));
+
+        spin_lock(&sprt_flip->sgrt_lock);
+        sprt_drv = sprt_flip->sprt_drv;
+        sprt_flip->busy = !!sprt_drv;
+        spin_unlock(&sprt_flip->sgrt_lock);
+
+        if (!sprt_drv)
+            continue;
+
+        if (xsdk_hdmi_poll_vblank(sprt_drv, XSDK_HDMI_VBLANK_TIMEOUT))
+        {
+            spin_lock(&sprt_flip->sgrt_lock);
+            sprt_flip->busy = false;
+            spin_unlock(&sprt_flip->sgrt_lock);
+            continue;
+        }
+
+        spin_lock(&sprt_flip->sgrt_lock);
+
+        /*!< parked at the last vblank, it has been scanned out for a whole frame */
+        if (sprt_flip->queued >= 0)
+        {
+            sprt_flip->front = sprt_flip->queued;
+            sprt_flip->queued = -1;
+
+            latency = jiffies_to_msecs(jiffies - sprt_flip->queued_stamp);
+            sprt_stats->flips++;
+            sprt_stats->latency_last = latency;
+            sprt_stats->latency_max = CMP_MAX2(sprt_stats->latency_max, latency);
+            sprt_stats->latency_sum += latency;
+        }
+
+        /*!< parking only rewrites registers, so it is done under the lock as pan does */
+        index = sprt_flip->ready;
+        if (index >= 0)
+        {
+            sprt_flip->ready = -1;
+
+            if (DisplayParkFrameBuffer(&sprt_drv->sgrt_dctrl, xsdk_hdmi_frame_addr(sprt_drv->sprt_fb, index)))
+                sprt_stats->drops++;
+            else
+            {
+                sprt_flip->queued = index;
+                sprt_flip->queued_stamp = sprt_flip->ready_stamp;
+            }
+        }
+
+        sprt_flip->busy = false;
+        spin_unlock(&sprt_flip->sgrt_lock);
+    }
+
+    return args;
+}
+
+/*!
+ * @brief   start flip worker
+ * @param   sprt_drv
+ * @retval  errno
+ * @note    not needed with single frame; created once, and reused after the driver is probed again
+ */
+static kint32_t xsdk_hdmi_flip_start(struct xsdk_hdmi_drv *sprt_drv)
+{
+    struct xsdk_hdmi_flip *sprt_flip = sprt_drv->sprt_flip;
+
+    if ((sprt_flip->num_frames < 2) || (sprt_flip->tid >= 0))
+        return ER_NORMAL;
+
+    init_waitqueue_head(&sprt_flip->sgrt_wqh);
+
+    sprt_flip->tid = kernel_thread_create(-1, mrt_nullptr, xsdk_hdmi_flip_entry, sprt_flip);
+    if (sprt_flip->tid < 0)
+        return -ER_FAILD;
+
+    thread_set_priority(mrt_tid_attr(sprt_flip->tid), THREAD_PROTY_FBFLIP);
+    thread_set_name(sprt_flip->tid, "xsdk_hdmi_flip");
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   forget frames waiting for screen
+ * @param   sprt_drv
+ * @retval  none
+ * @note    a parked frame is kept by VDMA, so it becomes the front one
+ */
+static void __xsdk_hdmi_flip_reset(struct xsdk_hdmi_flip *sprt_flip)
+{
+    if (sprt_flip->queued >= 0)
+        sprt_flip->front = sprt_flip->queued;
+
+    if (sprt_flip->ready >= 0)
+        sprt_flip->sgrt_stats.drops++;
+
+    sprt_flip->queued = sprt_flip->ready = -1;
+}
+
+static void xsdk_hdmi_flip_reset(struct xsdk_hdmi_drv *sprt_drv)
+{
+    struct xsdk_hdmi_flip *sprt_flip = sprt_drv->sprt_flip;
+
+    spin_lock(&sprt_flip->sgrt_lock);
+    __xsdk_hdmi_flip_reset(sprt_flip);
+    spin_unlock(&sprt_flip->sgrt_lock);
+}
+
+/*!
+ * @brief   bind driver to flip manager
+ * @param   sprt_drv, num_frames
+ * @retval  none
+ * @note    none
+ */
+static void xsdk_hdmi_flip_bind(struct xsdk_hdmi_drv *sprt_drv, kuint32_t num_frames)
+{
+    struct xsdk_hdmi_flip *sprt_flip = &sgrt_xsdk_hdmi_flip;
+
+    spin_lock(&sprt_flip->sgrt_lock);
+
+    sprt_flip->front = 0;
+    sprt_flip->queued = sprt_flip->ready = -1;
+    sprt_flip->num_frames = num_frames;
+    sprt_flip->sprt_drv = sprt_drv;
+    memset(&sprt_flip->sgrt_stats, 0, sizeof(sprt_flip->sgrt_stats));
+
+    spin_unlock(&sprt_flip->sgrt_lock);
+
+    sprt_drv->sprt_flip = sprt_flip;
+}
+
+/*!
+ * @brief   unbind driver from flip manager
+ * @param   sprt_drv
+ * @retval  none
+ * @note    the worker is kept (threads never exit); it only stops using the driver data
+ */
+static void xsdk_hdmi_flip_unbind(struct xsdk_hdmi_drv *sprt_drv)
+{
+    struct xsdk_hdmi_flip *sprt_flip = sprt_drv->sprt_flip;
+
+    spin_lock(&sprt_flip->sgrt_lock);
+    __xsdk_hdmi_flip_reset(sprt_flip);
+    sprt_flip->sprt_drv = mrt_nullptr;
+    spin_unlock(&sprt_flip->sgrt_lock);
+
+    /*!< it may be waiting for vblank with the old driver data */
+    while (sprt_flip->busy)
+        schedule_delay_ms(10);
+}
+
 /*!
  * @brief   driver open
  * @param   sprt_inode, user
@@ -145,6 +410,9 @@ static kint32_t xsdk_hdmi_open(struct fwk_fb_info *sprt_info, kint32_t user)
 
     print_info("hdmi device is opened\n");
 
+    if (xsdk_hdmi_flip_start(sprt_drv))
+        print_warn("hdmi flip worker is not started, frames are parked at once\n");
+
     memset_ex(sprt_info->screen_base, 0x00000000, sprt_info->screen_size);
     print_info("clear full screen with black color\n");
 
@@ -164,6 +432,7 @@ static kint32_t xsdk_hdmi_close(struct fwk_fb_info *sprt_info, kint32_t user)
 
     sprt_drv = fwk_fb_get_drvdata(sprt_info);
 
+    xsdk_hdmi_flip_reset(sprt_drv);
     memset_ex(sprt_info->screen_base, 0x00000000, sprt_info->screen_size);
     retval = DisplayStop(&sprt_drv->sgrt_dctrl);
     if (!retval)
@@ -181,6 +450,7 @@ static kint32_t xsdk_hdmi_close(struct fwk_fb_info *sprt_info, kint32_t user)
 kint32_t xsdk_hdmi_ioctl(struct fwk_fb_info *sprt_info, kuint32_t cmd, kuaddr_t arg)
 {
     struct xsdk_hdmi_drv *sprt_drv;
+    struct xsdk_hdmi_flip *sprt_flip;
     struct fwk_fb_var_screen_info *sprt_var;
     kuaddr_t new_smem;
 
@@ -198,15 +468,25 @@ kint32_t xsdk_hdmi_ioctl(struct fwk_fb_info *sprt_info, kuint32_t cmd, kuaddr_t
                 (sprt_var->yoffset >= sprt_info->sgrt_var.yres_virtual))
                 return -ER_MORE;
 
-            if (sprt_var->yoffset >= sprt_info->sgrt_var.yres)
+            new_smem += (sprt_var->yoffset / sprt_info->sgrt_var.yres) * sprt_info->sgrt_fix.smem_len;
+            new_smem  = mrt_align(new_smem, 8);
+
+            sprt_flip = sprt_drv->sprt_flip;
+            spin_lock(&sprt_flip->sgrt_lock);
+
+            if (DisplayChangeFrameBuffer(&sprt_drv->sgrt_dctrl, new_smem, sprt_info->sgrt_fix.smem_len))
             {
-                new_smem += sprt_info->sgrt_fix.smem_len;
-                new_smem  = mrt_align(new_smem, 8);
+                spin_unlock(&sprt_flip->sgrt_lock);
+                return -ER_FAILD;
             }
 
             sprt_info->screen_base = (kuint8_t *)new_smem;
-            if (DisplayChangeFrameBuffer(&sprt_drv->sgrt_dctrl, new_smem, sprt_info->sgrt_fix.smem_len))
-                return -ER_FAILD;
+
+            /*!< the frame store is restarted with this frame, nothing is pending any more */
+            __xsdk_hdmi_flip_reset(sprt_flip);
+            sprt_flip->front = sprt_var->yoffset / sprt_info->sgrt_var.yres;
+
+            spin_unlock(&sprt_flip->sgrt_lock);
 
         default:
             break;
@@ -215,11 +495,148 @@ kint32_t xsdk_hdmi_ioctl(struct fwk_fb_info *sprt_info, kuint32_t cmd, kuaddr_t
     return ER_NORMAL;
 }
 
+/*!
+ * @brief   driver pan display
+ * @param   sprt_info, sprt_var
+ * @retval  errno
+ * @note    a whole frame is queued for the next vblank, without waiting for it;
+ *          other offsets repoint the parked frame store at once, under the same lock
+ */
+static kint32_t xsdk_hdmi_pan_display(struct fwk_fb_info *sprt_info, struct fwk_fb_var_screen_info *sprt_var)
+{
+    struct xsdk_hdmi_drv *sprt_drv;
+    struct xsdk_hdmi_flip *sprt_flip;
+    kuint32_t line_lenth, new_smem;
+    kint32_t index, retval;
+
+    sprt_drv = fwk_fb_get_drvdata(sprt_info);
+    sprt_flip = sprt_drv->sprt_flip;
+    index = sprt_var->yoffset / sprt_info->sgrt_var.yres;
+
+    if ((sprt_flip->tid >= 0) && !sprt_var->xoffset && !(sprt_var->yoffset % sprt_info->sgrt_var.yres))
+    {
+        spin_lock(&sprt_flip->sgrt_lock);
+
+        /*!< the older one is never shown */
+        if (sprt_flip->ready >= 0)
+            sprt_flip->sgrt_stats.drops++;
+
+        sprt_flip->ready = index;
+        sprt_flip->ready_stamp = jiffies;
+
+        spin_unlock(&sprt_flip->sgrt_lock);
+
+        wake_up(&sprt_flip->sgrt_wqh);
+        return ER_NORMAL;
+    }
+
+    line_lenth = sprt_info->sgrt_var.xres_virtual * (sprt_info->sgrt_var.bits_per_pixel >> 3);
+
+    new_smem  = sprt_info->sgrt_fix.smem_start;
+    new_smem += sprt_var->yoffset * line_lenth + sprt_var->xoffset * (sprt_info->sgrt_var.bits_per_pixel >> 3);
+
+    spin_lock(&sprt_flip->sgrt_lock);
+
+    retval = DisplayParkFrameBuffer(&sprt_drv->sgrt_dctrl, new_smem);
+    if (!retval)
+    {
+        /*!< it replaces whatever was pending */
+        __xsdk_hdmi_flip_reset(sprt_flip);
+
+        /*!< with the worker, it is retired to front at the next vblank */
+        if (sprt_flip->tid >= 0)
+        {
+            sprt_flip->queued = index;
+            sprt_flip->queued_stamp = jiffies;
+        }
+        else
+            sprt_flip->front = index;
+    }
+
+    spin_unlock(&sprt_flip->sgrt_lock);
+
+    if (retval)
+        return -ER_FAILD;
+
+    if (sprt_flip->tid >= 0)
+        wake_up(&sprt_flip->sgrt_wqh);
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   driver get free buffer
+ * @param   sprt_info, yoffset: output
+ * @retval  errno
+ * @note    with 3 frames there is always one: if not, the submitted one is taken back
+ */
+static kint32_t xsdk_hdmi_get_free_buffer(struct fwk_fb_info *sprt_info, kuint32_t *yoffset)
+{
+    struct xsdk_hdmi_drv *sprt_drv;
+    struct xsdk_hdmi_flip *sprt_flip;
+    kint32_t index;
+
+    sprt_drv = fwk_fb_get_drvdata(sprt_info);
+    sprt_flip = sprt_drv->sprt_flip;
+
+    spin_lock(&sprt_flip->sgrt_lock);
+
+    for (index = 0; index < (kint32_t)sprt_flip->num_frames; index++)
+    {
+        if ((index != sprt_flip->front) && 
+            (index != sprt_flip->queued) && 
+            (index != sprt_flip->ready))
+            break;
+    }
+
+    if (index >= (kint32_t)sprt_flip->num_frames)
+    {
+        index = sprt_flip->ready;
+        if (index >= 0)
+        {
+            sprt_flip->ready = -1;
+            sprt_flip->sgrt_stats.drops++;
+        }
+    }
+
+    spin_unlock(&sprt_flip->sgrt_lock);
+
+    if (index < 0)
+        return -ER_BUSY;
+
+    *yoffset = index * sprt_info->sgrt_var.yres;
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   driver get flip statistics
+ * @param   sprt_info, sprt_stats: output
+ * @retval  errno
+ * @note    none
+ */
+static kint32_t xsdk_hdmi_get_flip_stats(struct fwk_fb_info *sprt_info, struct fwk_fb_flip_stats *sprt_stats)
+{
+    struct xsdk_hdmi_drv *sprt_drv;
+
+    sprt_drv = fwk_fb_get_drvdata(sprt_info);
+
+    spin_lock(&sprt_drv->sprt_flip->sgrt_lock);
+    *sprt_stats = sprt_drv->sprt_flip->sgrt_stats;
+    spin_unlock(&sprt_drv->sprt_flip->sgrt_lock);
+
+    return ER_NORMAL;
+}
+
 static const struct fwk_fb_oprts sgrt_fwk_fb_ops =
 {
     .fb_open = xsdk_hdmi_open,
     .fb_release = xsdk_hdmi_close,
     .fb_ioctl = xsdk_hdmi_ioctl,
+    .fb_pan_display = xsdk_hdmi_pan_display,
+    .fb_wait_vsync = xsdk_hdmi_wait_vsync,
+    .fb_get_free_buffer = xsdk_hdmi_get_free_buffer,
+    .fb_get_flip_stats = xsdk_hdmi_get_flip_stats,
 };
 
 /*!< --------------------------------------------------------------------- */
@@ -412,6 +829,7 @@ static kint32_t xsdk_hdmi_driver_probe(struct fwk_platdev *sprt_pdev)
     void *base, *buffer;
     kuint32_t isHdmi = 0;
     kusize_t buffer_len, mem_size;
+    kuint32_t num_frames;
     kint32_t retval;
 
     sprt_node = sprt_pdev->sgrt_dev.sprt_node;
@@ -462,11 +880,14 @@ static kint32_t xsdk_hdmi_driver_probe(struct fwk_platdev *sprt_pdev)
     if (mem_size < buffer_len)
         goto fail3;
 
-#if (defined(CONFIG_FBUFFER_NUM) && (CONFIG_FBUFFER_NUM >= 2))
-    if (mem_size >= (buffer_len << 1))
-        buffer_len <<= 1;
-#endif
+    /*!< as many frames as memory allows */
+    for (num_frames = XSDK_HDMI_FRAME_NUM; num_frames > 1; num_frames--)
+    {
+        if (mem_size >= (buffer_len * num_frames))
+            break;
+    }
 
+    buffer_len *= num_frames;
     buffer = kmalloc(buffer_len, GFP_DRAM);
     if (!isValid(buffer))
         goto fail3;
@@ -479,27 +900,29 @@ static kint32_t xsdk_hdmi_driver_probe(struct fwk_platdev *sprt_pdev)
     sprt_fb->screen_base = (void *)sprt_fb->sgrt_fix.smem_start;
     sprt_fb->screen_size = sprt_fb->sgrt_fix.smem_len;
 
-    /*!< choose to enable double buffer */
-    if (buffer_len >= (2 * sprt_fb->sgrt_fix.smem_len))
-    {
-        sprt_fb->sgrt_var.yres_virtual <<= 1;
-        sprt_fb->screen_size <<= 1;
-    }
+    /*!< frames are stacked vertically in virtual screen */
+    sprt_fb->sgrt_var.yres_virtual *= num_frames;
+    sprt_fb->screen_size *= num_frames;
+
+    xsdk_hdmi_flip_bind(sprt_drv, num_frames);
     
     retval = fwk_register_framebuffer(sprt_fb);
     if (retval < 0)
-        goto fail3;
+        goto fail4;
 
     print_info("register a new framebuffer (hdmi)\n");
 
     retval = xsdk_hdmi_init(base, sprt_drv);
     if (retval)
-        goto fail4;
+        goto fail5;
 
     return ER_NORMAL;
 
-fail4:
+fail5:
     fwk_unregister_framebuffer(sprt_fb);
+fail4:
+    xsdk_hdmi_flip_unbind(sprt_drv);
+    kfree(buffer);
 fail3:
     xsdk_hdmi_driver_remove_axivdma(sprt_pdev);
 fail2:
@@ -525,6 +948,7 @@ static kint32_t xsdk_hdmi_driver_remove(struct fwk_platdev *sprt_pdev)
     sprt_fb = sprt_drv->sprt_fb;
 
     fwk_unregister_framebuffer(sprt_fb);
+    xsdk_hdmi_flip_unbind(sprt_drv);
     xsdk_hdmi_driver_remove_axivdma(sprt_pdev);
     fwk_platform_set_drvdata(sprt_pdev, mrt_nullptr);
 
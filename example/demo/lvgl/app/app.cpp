@@ -225,12 +225,12 @@ void lvgl_task_setup(void *args)
 /*!
  * @brief  main
  * @param  args
- * @retval none
+ * @retval time till the next lvgl timer (unit: ms), LV_NO_TIMER_READY if none
  * @note   none
  */
-void lvgl_task(void *args)
+kuint32_t lvgl_task(void *args)
 {
-    lv_timer_handler();
+    return lv_timer_handler();
 }
 
 /*!< end of file */
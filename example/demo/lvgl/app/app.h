@@ -30,7 +30,7 @@
 
 /*!< The functions */
 extern void lvgl_task_setup(void *args);
-extern void lvgl_task(void *args);
+extern kuint32_t lvgl_task(void *args);
 
 #endif
 
@@ -28,16 +28,36 @@
 
 #include "porting/lv_port_disp.h"
 #include "porting/lv_port_fs.h"
+#include "porting/lv_port_mem.h"
 #include "app/app.h"
 
 using namespace tsk;
 
 /*!< The defines */
 #define LVGL_TASK_STACK_SIZE                    THREAD_STACK_PAGE(1)    /*!< 1 page (4kbytes) */
+#define LVGL_TASK_SLEEP_MAX                     (500U)                  /*!< unit: ms, if no lvgl timer is ready */
+#define LVGL_TASK_MEM_REPORT                    (10U)                   /*!< unit: s, period of memory pool report */
 
 /*!< The globals */
 
 /*!< API functions */
+/*!
+ * @brief  report lvgl memory pool
+ * @param  none
+ * @retval none
+ * @note   debug level; lv_port_mem_stats() walks all blocks, so it is not done often
+ */
+static void lvgl_task_mem_report(void)
+{
+    struct lv_port_mem_stats sgrt_stats;
+
+    lv_port_mem_stats(&sgrt_stats);
+
+    print_debug("lvgl mem: used %d/%d, peak %d, free %d, biggest %d, frag %d%%, alloc %d, free %d, fail %d\n",
+                sgrt_stats.used, sgrt_stats.total, sgrt_stats.peak, sgrt_stats.free, sgrt_stats.free_biggest,
+                sgrt_stats.frag_pct, sgrt_stats.nr_alloc, sgrt_stats.nr_free, sgrt_stats.nr_fail);
+}
+
 /*!
  * @brief  display task
  * @param  none
@@ -48,6 +68,8 @@ static void *lvgl_task_entry(void *args)
 {
     struct fwk_disp_ctrl sgrt_dctrl;
     struct fwk_disp_info sgrt_disp;
+    kuint32_t time_till_next;
+    kutime_t report_expires;
 
     sgrt_dctrl.sprt_di = &sgrt_disp;
 
@@ -58,10 +80,20 @@ static void *lvgl_task_entry(void *args)
     lvgl_task_setup(&sgrt_dctrl);
     schedule_delay_ms(1);
 
+    report_expires = jiffies + secs_to_jiffies(LVGL_TASK_MEM_REPORT);
+
     for (;;)
     {
-        lvgl_task(&sgrt_dctrl);
-        schedule_delay_ms(100);
+        if (mrt_time_after_eq(jiffies, report_expires))
+        {
+            lvgl_task_mem_report();
+            report_expires = jiffies + secs_to_jiffies(LVGL_TASK_MEM_REPORT);
+        }
+
+        /*!< sleep until the next deadline of lvgl, nothing runs while the screen is idle */
+        time_till_next = lvgl_task(&sgrt_dctrl);
+        time_till_next = CMP_MIN2(time_till_next, LVGL_TASK_SLEEP_MAX);
+        schedule_delay_ms(CMP_MAX2(time_till_next, 1U));
     }
 
     return args;
@@ -14,6 +14,8 @@
 #include "lv_port_disp.h"
 #include <stdbool.h>
 #include <fs/fs_intr.h>
+#include <kernel/thread.h>
+#include <kernel/wait.h>
 
 /*********************
  *      DEFINES
@@ -28,9 +30,20 @@
 //     #define MY_DISP_VER_RES    240
 // #endif
 
+/*Each draw buffer holds 1/LV_PORT_DISP_BAND_DIV of the screen*/
+#define LV_PORT_DISP_BAND_DIV           (4)
+#define LV_PORT_DISP_VSYNC_TIMEOUT      (100)       /*unit: ms*/
+
 /**********************
  *      TYPEDEFS
  **********************/
+struct lv_port_flush_req
+{
+    lv_disp_drv_t *disp_drv;
+    lv_area_t sgrt_area;
+    lv_color_t *color_p;
+    bool last;                                  /*last area of a frame*/
+};
 
 /**********************
  *  STATIC PROTOTYPES
@@ -38,15 +51,22 @@
 static kint32_t disp_init(struct fwk_disp_ctrl *sprt_dctrl);
 
 static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void disp_wait(lv_disp_drv_t * disp_drv);
+static kint32_t disp_flush_worker_init(void);
 //static void gpu_fill(lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, lv_coord_t dest_width,
 //        const lv_area_t * fill_area, lv_color_t color);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
-static struct timer_list sgrt_lvgl_tick_timer;
 static kint32_t g_lvgl_fbdev_fd = -1;
 
+static struct lv_port_flush_req sgrt_lv_flush_req;
+static volatile bool g_lv_flush_pending = false;
+static struct wait_queue_head sgrt_lv_flush_wqh;
+static struct wait_queue_head sgrt_lv_flush_done_wqh;
+static tid_t g_lv_flush_tid = -1;
+
 /**********************
  *      MACROS
  **********************/
@@ -117,9 +137,41 @@ void lv_port_disp_init(void *args)
 
 #else
 
+    /*Two band buffers: LVGL renders into one while the other is copied to the framebuffer*/
     static lv_disp_draw_buf_t draw_buf_dsc_4;
-    lv_disp_draw_buf_init(&draw_buf_dsc_4, sprt_disp->buffer_bak, sprt_disp->buffer,
-                          sprt_disp->height * sprt_disp->width);   /*Initialize the display buffer*/
+    lv_color_t *buf_4_1 = mrt_nullptr, *buf_4_2 = mrt_nullptr;
+    kuint32_t rows;
+
+    for (rows = sprt_disp->height / LV_PORT_DISP_BAND_DIV; rows; rows >>= 1) {
+        buf_4_1 = kmalloc(rows * sprt_disp->width * sizeof(lv_color_t), GFP_KERNEL);
+        buf_4_2 = kmalloc(rows * sprt_disp->width * sizeof(lv_color_t), GFP_KERNEL);
+        if (isValid(buf_4_1) && isValid(buf_4_2))
+            break;
+
+        if (isValid(buf_4_1))
+            kfree(buf_4_1);
+        if (isValid(buf_4_2))
+            kfree(buf_4_2);
+    }
+
+    /*Not enough memory for two bands: fall back to one single-row buffer*/
+    if (!rows) {
+        rows = 1;
+        buf_4_1 = kmalloc(sprt_disp->width * sizeof(lv_color_t), GFP_KERNEL);
+        buf_4_2 = mrt_nullptr;
+        if (!isValid(buf_4_1)) {
+            LV_LOG_ERROR("no memory for draw buffer, display is not registered");
+            return;
+        }
+
+        LV_LOG_WARN("no memory for two draw buffers, using one row");
+    }
+
+    lv_disp_draw_buf_init(&draw_buf_dsc_4, buf_4_1, buf_4_2,
+                          rows * sprt_disp->width);   /*Initialize the display buffer*/
+
+    if (disp_flush_worker_init())
+        LV_LOG_WARN("flush worker is not started, flushing synchronously");
 
 #endif
 
@@ -138,6 +190,7 @@ void lv_port_disp_init(void *args)
 
     /*Used to copy the buffer's content to the display*/
     disp_drv.flush_cb = disp_flush;
+    disp_drv.wait_cb = disp_wait;
 
     /*Set a display buffer*/
     disp_drv.draw_buf = &draw_buf_dsc_4;
@@ -164,7 +217,6 @@ void lv_port_disp_logo(struct fwk_disp_ctrl *sprt_dctrl)
     void *buffer;
     kuint8_t bytes_per_pixel;
     kssize_t size;
-    kuint32_t flags;
 
     bytes_per_pixel = sprt_disp->bpp >> 3;
     size = sprt_disp->width * sprt_disp->height * bytes_per_pixel;
@@ -172,7 +224,7 @@ void lv_port_disp_logo(struct fwk_disp_ctrl *sprt_dctrl)
     if (!isValid(buffer))
         return;
 
-    local_irq_save(&flags);
+    /*!< FatFs locks the volume by itself, other threads may use the card meanwhile */
     sprt_file = file_open(CONFIG_POWER_LOGO, O_RDONLY);
     if (!isValid(sprt_file))
         goto END1;
@@ -186,26 +238,16 @@ void lv_port_disp_logo(struct fwk_disp_ctrl *sprt_dctrl)
 END2:
     file_close(sprt_file);
 END1:
-    local_irq_restore(&flags);
     kfree(buffer);
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
-static void lvgl_disp_tick_inc(kuint32_t args)
-{
-    struct timer_list *sprt_tim = (struct timer_list *)args;
-
-    lv_tick_inc(10);
-    mod_timer(sprt_tim, jiffies + msecs_to_jiffies(10));
-}
-
 /*Initialize your display and the required peripherals.*/
 static kint32_t disp_init(struct fwk_disp_ctrl *sprt_dctrl)
 {
     /*You code here*/
-    struct timer_list *sprt_tim = &sgrt_lvgl_tick_timer;
     kint32_t fd;
     struct fwk_fb_fix_screen_info sgrt_fix;
 	struct fwk_fb_var_screen_info sgrt_var;
@@ -234,11 +276,6 @@ static kint32_t disp_init(struct fwk_disp_ctrl *sprt_dctrl)
     fwk_display_ctrl_init(sprt_disp, fb_buffer1, fb_buffer2, sgrt_fix.smem_len, 
                         sgrt_var.xres, sgrt_var.yres, sgrt_var.bits_per_pixel);
 
-    /*!< add timer tick */
-    setup_timer(sprt_tim, lvgl_disp_tick_inc, (kuint32_t)sprt_tim);
-    sprt_tim->expires = jiffies + msecs_to_jiffies(10);
-    add_timer(sprt_tim);
-
     fwk_display_frame_exchange(sprt_disp);
     lv_port_disp_logo(sprt_dctrl);
 
@@ -246,7 +283,9 @@ static kint32_t disp_init(struct fwk_disp_ctrl *sprt_dctrl)
     mrt_dsb();
     mrt_barrier();
 
-    virt_ioctl(fd, NR_FB_IOSET_VARINFO, &sgrt_var);
+    if (virt_ioctl(fd, NR_FB_IOPAN_DISPLAY, &sgrt_var))
+        virt_ioctl(fd, NR_FB_IOSET_VARINFO, &sgrt_var);
+
     return ER_NORMAL;
 
     virt_munmap(fb_buffer2, sgrt_fix.smem_len);
@@ -274,64 +313,175 @@ void disp_disable_update(void)
     disp_flush_enabled = false;
 }
 
+/*!
+ * @brief   copy a rendered area to framebuffer
+ * @param   sprt_disp, buffer: destination, area, color_p: source
+ * @retval  none
+ * @note    pixel format is converted if LVGL color depth differs from screen
+ */
+static void disp_copy_area(struct fwk_disp_info *sprt_disp, void *buffer,
+                            const lv_area_t *area, lv_color_t *color_p)
+{
+    struct fwk_blit_surface sgrt_dst, sgrt_src;
+    kint32_t dst_format, src_format;
+    kuint32_t width, height;
+
+    dst_format = fwk_blit_format_by_bpp(mrt_fwk_disp_bpp_get(sprt_disp->bpp));
+    src_format = fwk_blit_format_by_bpp(LV_COLOR_DEPTH);
+    if ((dst_format < 0) || (src_format < 0))
+        return;
+
+    width  = area->x2 - area->x1 + 1;
+    height = area->y2 - area->y1 + 1;
+
+    fwk_blit_surface_init(&sgrt_dst, buffer, sprt_disp->width, sprt_disp->height, dst_format);
+    fwk_blit_surface_init(&sgrt_src, color_p, width, height, src_format);
+    fwk_blit_copy(&sgrt_dst, area->x1, area->y1, &sgrt_src, 0, 0, width, height);
+}
+
+/*!
+ * @brief   show the back buffer
+ * @param   sprt_disp
+ * @retval  none
+ * @note    the old front buffer is brought up to date with the damaged areas after vblank
+ */
+static void disp_page_flip(struct fwk_disp_info *sprt_disp)
+{
+    struct fwk_fb_var_screen_info sgrt_var;
+    kint32_t fd = g_lvgl_fbdev_fd;
+    kuint32_t timeout = LV_PORT_DISP_VSYNC_TIMEOUT;
+
+    fwk_display_frame_exchange(sprt_disp);
+    virt_ioctl(fd, NR_FB_IOGET_VARINFO, &sgrt_var);
+    sgrt_var.yoffset = sgrt_var.yoffset ? 0 : sgrt_var.yres;
+
+    /*!< flip at vblank, then the old front buffer is free to be drawn */
+    if (virt_ioctl(fd, NR_FB_IOPAN_DISPLAY, &sgrt_var))
+        virt_ioctl(fd, NR_FB_IOSET_VARINFO, &sgrt_var);
+    else
+        virt_ioctl(fd, NR_FB_IOWAIT_VSYNC, &timeout);
+
+    fwk_display_frame_sync(sprt_disp, sprt_disp->buf_size);
+}
+
+/*!
+ * @brief   write a flush request to screen
+ * @param   sprt_req
+ * @retval  none
+ * @note    with page flipping, areas go to the back buffer, which is shown after the last one
+ */
+static void disp_flush_area(struct lv_port_flush_req *sprt_req)
+{
+    struct fwk_disp_ctrl *sprt_dctrl;
+    struct fwk_disp_info *sprt_disp;
+
+    sprt_dctrl = (struct fwk_disp_ctrl *)sprt_req->disp_drv->user_data;
+    sprt_disp  = sprt_dctrl->sprt_di;
+
+    if ((g_lvgl_fbdev_fd < 0) || !sprt_disp->buffer_bak) {
+        disp_copy_area(sprt_disp, sprt_disp->buffer, &sprt_req->sgrt_area, sprt_req->color_p);
+        return;
+    }
+
+    disp_copy_area(sprt_disp, sprt_disp->buffer_bak, &sprt_req->sgrt_area, sprt_req->color_p);
+
+    /*!< frame sync only copies the areas that LVGL has redrawn */
+    fwk_display_add_damage(sprt_disp, sprt_req->sgrt_area.x1, sprt_req->sgrt_area.y1, 
+                            sprt_req->sgrt_area.x2 + 1, sprt_req->sgrt_area.y2 + 1);
+
+    if (sprt_req->last)
+        disp_page_flip(sprt_disp);
+}
+
+/*!
+ * @brief   flush worker
+ * @param   args
+ * @retval  none
+ * @note    pixel transfer overlaps with LVGL rendering the next area into the other draw buffer
+ */
+static void *disp_flush_entry(void *args)
+{
+    struct lv_port_flush_req *sprt_req = &sgrt_lv_flush_req;
+
+    for (;;) {
+        wait_event(&sgrt_lv_flush_wqh, g_lv_flush_pending);
+
+        disp_flush_area(sprt_req);
+
+        g_lv_flush_pending = false;
+        lv_disp_flush_ready(sprt_req->disp_drv);
+        wake_up(&sgrt_lv_flush_done_wqh);
+    }
+
+    return args;
+}
+
+/*!
+ * @brief   start flush worker
+ * @param   none
+ * @retval  errno
+ * @note    without it, areas are flushed synchronously
+ */
+static kint32_t disp_flush_worker_init(void)
+{
+    init_waitqueue_head(&sgrt_lv_flush_wqh);
+    init_waitqueue_head(&sgrt_lv_flush_done_wqh);
+
+    g_lv_flush_tid = kernel_thread_create(-1, mrt_nullptr, disp_flush_entry, mrt_nullptr);
+    if (g_lv_flush_tid < 0)
+        return -ER_FAILD;
+
+    thread_set_priority(mrt_tid_attr(g_lv_flush_tid), THREAD_PROTY_LVFLUSH);
+    thread_set_name(g_lv_flush_tid, "lv_disp_flush");
+
+    return ER_NORMAL;
+}
+
 /*Flush the content of the internal buffer the specific area on the display
  *You can use DMA or any hardware acceleration to do this operation in the background but
  *'lv_disp_flush_ready()' has to be called when finished.*/
 static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
 {
-    if (disp_flush_enabled) {
-        /*The most simple case (but also the slowest) to put all pixels to the screen one-by-one*/
-
-        struct fwk_disp_ctrl *sprt_dctrl;
-        struct fwk_disp_info *sprt_disp;
-        kuint8_t  pixelbits;
-        lv_disp_t *sprt_refr;
-        lv_disp_draw_buf_t *sprt_draw;
-        
-        sprt_dctrl = (struct fwk_disp_ctrl *)disp_drv->user_data;
-        sprt_disp  = sprt_dctrl->sprt_di;
-        pixelbits  = mrt_fwk_disp_bpp_get(sprt_disp->bpp);
-
-        sprt_refr = _lv_refr_get_disp_refreshing();
-        sprt_draw = lv_disp_get_draw_buf(sprt_refr);
-
-        if ((pixelbits == 32) &&
-            (!disp_drv->direct_mode) &&
-            (sprt_draw->flushing_last)) {
-            kint32_t fd = g_lvgl_fbdev_fd;
-            struct fwk_fb_var_screen_info sgrt_var;
-
-            if (fd < 0)
-                goto END;
-
-            fwk_display_frame_exchange(sprt_disp);
-            virt_ioctl(fd, NR_FB_IOGET_VARINFO, &sgrt_var);
-            if (!sgrt_var.yoffset)
-                sgrt_var.yoffset += sgrt_var.yres;
-            else
-                sgrt_var.yoffset = 0;
-            
-            virt_ioctl(fd, NR_FB_IOSET_VARINFO, &sgrt_var);
-            fwk_display_frame_sync(sprt_disp, sprt_disp->buf_size);
-        }
-        else {
-            kuint32_t offset, length;
+    struct lv_port_flush_req *sprt_req = &sgrt_lv_flush_req;
 
-            pixelbits >>= 3;
-            for (int32_t y = area->y1; y <= area->y2; y++) {
-                offset = mrt_fwk_disp_advance_pos(area->x1, y, sprt_disp->width);
-                length = area->x2 - area->x1 + 1;
+    if (!disp_flush_enabled) {
+        lv_disp_flush_ready(disp_drv);
+        return;
+    }
 
-                memcpy(sprt_disp->buffer + offset * pixelbits, color_p, length * pixelbits);
-                color_p += length;
-            }
-        }
+    /*LVGL waits for lv_disp_flush_ready() before the next call, so one request is in flight at most*/
+    sprt_req->disp_drv = disp_drv;
+    sprt_req->sgrt_area = *area;
+    sprt_req->color_p = color_p;
+    sprt_req->last = lv_disp_flush_is_last(disp_drv);
+
+    if (g_lv_flush_tid < 0) {
+        disp_flush_area(sprt_req);
+
+        /*IMPORTANT!!!
+         *Inform the graphics library that you are ready with the flushing*/
+        lv_disp_flush_ready(disp_drv);
+        return;
     }
 
-END:
-    /*IMPORTANT!!!
-     *Inform the graphics library that you are ready with the flushing*/
-    lv_disp_flush_ready(disp_drv);
+    mrt_barrier();
+    g_lv_flush_pending = true;
+    wake_up(&sgrt_lv_flush_wqh);
+}
+
+/*Called by LVGL, again and again, while the draw buffer it wants is still being flushed.
+ *Only the worker completes a request: the area and color_p are in use until it calls lv_disp_flush_ready()*/
+static void disp_wait(lv_disp_drv_t * disp_drv)
+{
+    kutime_t expires = jiffies + msecs_to_jiffies(LV_PORT_DISP_VSYNC_TIMEOUT);
+
+    /*schedule_timeout() takes an absolute expiry, and the wait only returns once the condition holds*/
+    wait_event_timeout(&sgrt_lv_flush_done_wqh,
+                       !g_lv_flush_pending || !mrt_time_after(expires, jiffies), expires);
+
+    /*A flip waits for vblank, so this is slow rather than lost; LVGL just calls it again*/
+    if (g_lv_flush_pending)
+        LV_LOG_WARN("flush is taking longer than %d ms", LV_PORT_DISP_VSYNC_TIMEOUT);
 }
 
 /*OPTIONAL: GPU INTERFACE*/
@@ -0,0 +1,182 @@
+/*
+ * LVGL Memory Porting Interface
+ *
+ * File Name:   lv_port_mem.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <common/error_types.h>
+#include <common/mem_manage.h>
+#include <kernel/mutex.h>
+
+#include "lv_port_mem.h"
+
+/*!< The defines */
+/*!< stored in front of each allocation, keeps user memory 8 bytes aligned */
+#define LV_PORT_MEM_HEADER_SIZE                 (mrt_num_align8(sizeof(kusize_t)))
+#define mrt_lv_port_mem_header(ptr)             ((kusize_t *)((kuint8_t *)(ptr) - LV_PORT_MEM_HEADER_SIZE))
+
+/*!< The globals */
+static kuint8_t g_lv_port_mem_pool[LV_PORT_MEM_SIZE];
+static struct mem_info sgrt_lv_port_mem_info;
+static struct mutex_lock sgrt_lv_port_mem_lock = MUTEX_LOCK_INIT();
+static struct lv_port_mem_stats sgrt_lv_port_mem_stats;
+static kbool_t g_lv_port_mem_inited = false;
+
+/*!< The functions */
+/*!
+ * @brief   build pool at the first use
+ * @param   none
+ * @retval  errno
+ * @note    lv_init() allocates before any porting code runs, so it can not be done in lv_port_disp_init()
+ */
+static kint32_t lv_port_mem_init(void)
+{
+    kint32_t retval;
+
+    if (g_lv_port_mem_inited)
+        return ER_NORMAL;
+
+    retval = memory_block_create(&sgrt_lv_port_mem_info, (kuaddr_t)g_lv_port_mem_pool, sizeof(g_lv_port_mem_pool));
+    if (retval)
+        return retval;
+
+    sgrt_lv_port_mem_stats.total = sgrt_lv_port_mem_info.lenth;
+    g_lv_port_mem_inited = true;
+
+    return ER_NORMAL;
+}
+
+/*!< API function */
+/*!
+ * @brief   allocate memory for lvgl
+ * @param   size
+ * @retval  memory, null if failed
+ * @note    LV_MEM_CUSTOM_ALLOC
+ */
+void *lv_port_mem_alloc(kusize_t size)
+{
+    struct mem_info *sprt_info = &sgrt_lv_port_mem_info;
+    kusize_t *ptr = mrt_nullptr;
+
+    mutex_lock(&sgrt_lv_port_mem_lock);
+
+    if (!lv_port_mem_init())
+        ptr = sprt_info->alloc(sprt_info, size + LV_PORT_MEM_HEADER_SIZE);
+
+    if (!ptr)
+    {
+        sgrt_lv_port_mem_stats.nr_fail++;
+        goto END;
+    }
+
+    *ptr = size;
+    ptr = (kusize_t *)((kuint8_t *)ptr + LV_PORT_MEM_HEADER_SIZE);
+
+    sgrt_lv_port_mem_stats.nr_alloc++;
+    sgrt_lv_port_mem_stats.used += size;
+    sgrt_lv_port_mem_stats.peak = CMP_MAX2(sgrt_lv_port_mem_stats.peak, sgrt_lv_port_mem_stats.used);
+
+END:
+    mutex_unlock(&sgrt_lv_port_mem_lock);
+
+    return ptr;
+}
+
+/*!
+ * @brief   free memory of lvgl
+ * @param   ptr
+ * @retval  none
+ * @note    LV_MEM_CUSTOM_FREE
+ */
+void lv_port_mem_free(void *ptr)
+{
+    struct mem_info *sprt_info = &sgrt_lv_port_mem_info;
+    kusize_t *sprt_head;
+
+    if (!ptr)
+        return;
+
+    sprt_head = mrt_lv_port_mem_header(ptr);
+
+    mutex_lock(&sgrt_lv_port_mem_lock);
+
+    sgrt_lv_port_mem_stats.nr_free++;
+    sgrt_lv_port_mem_stats.used -= CMP_MIN2(*sprt_head, sgrt_lv_port_mem_stats.used);
+    sprt_info->free(sprt_info, sprt_head);
+
+    mutex_unlock(&sgrt_lv_port_mem_lock);
+}
+
+/*!
+ * @brief   resize memory of lvgl
+ * @param   ptr, size
+ * @retval  new memory, null if failed (ptr is kept then)
+ * @note    LV_MEM_CUSTOM_REALLOC
+ */
+void *lv_port_mem_realloc(void *ptr, kusize_t size)
+{
+    void *ptr_new;
+    kusize_t old_size;
+
+    if (!ptr)
+        return lv_port_mem_alloc(size);
+
+    /*!< shrinking in place: the pool can not split a used block */
+    old_size = *mrt_lv_port_mem_header(ptr);
+    if (size <= old_size)
+        return ptr;
+
+    ptr_new = lv_port_mem_alloc(size);
+    if (!ptr_new)
+        return mrt_nullptr;
+
+    kmemcpy(ptr_new, ptr, old_size);
+    lv_port_mem_free(ptr);
+
+    return ptr_new;
+}
+
+/*!
+ * @brief   get usage and fragmentation of pool
+ * @param   sprt_stats: output
+ * @retval  none
+ * @note    walks all blocks, do not call it frequently
+ */
+void lv_port_mem_stats(struct lv_port_mem_stats *sprt_stats)
+{
+    struct mem_block *sprt_block;
+    kusize_t free = 0, biggest = 0, remain;
+
+    if (!sprt_stats)
+        return;
+
+    mutex_lock(&sgrt_lv_port_mem_lock);
+
+    for (sprt_block = sgrt_lv_port_mem_info.sprt_mem; g_lv_port_mem_inited && sprt_block;
+                                                            sprt_block = sprt_block->sprt_next)
+    {
+        if (sprt_block->remain <= (MEM_BLOCK_HEADER_SIZE + LV_PORT_MEM_HEADER_SIZE))
+            continue;
+
+        /*!< usable part, each allocation costs one more block header */
+        remain = sprt_block->remain - MEM_BLOCK_HEADER_SIZE - LV_PORT_MEM_HEADER_SIZE;
+        free += remain;
+        biggest = CMP_MAX2(biggest, remain);
+    }
+
+    *sprt_stats = sgrt_lv_port_mem_stats;
+    sprt_stats->free = free;
+    sprt_stats->free_biggest = biggest;
+    sprt_stats->frag_pct = free ? (100 - (kuint32_t)((kuint64_t)biggest * 100 / free)) : 0;
+
+    mutex_unlock(&sgrt_lv_port_mem_lock);
+}
+
+/*!< end of file */
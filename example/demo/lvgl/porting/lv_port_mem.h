@@ -0,0 +1,60 @@
+/*
+ * LVGL Memory Porting Interface
+ *
+ * File Name:   lv_port_mem.h
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+#ifndef __LV_PORT_MEM_H_
+#define __LV_PORT_MEM_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/*!< The includes */
+#include <common/basic_types.h>
+#include <common/time.h>
+
+/*!< The defines */
+/*!< size of the pool that lv_mem_alloc() is served from */
+#ifdef CONFIG_LV_PORT_MEM_SIZE
+#define LV_PORT_MEM_SIZE                        (CONFIG_LV_PORT_MEM_SIZE)
+#else
+#define LV_PORT_MEM_SIZE                        (8U * 1024U * 1024U)
+#endif
+
+/*!< tick of lvgl, read from jiffies instead of being counted by a timer */
+#define LV_PORT_TICK_GET()                      (jiffies_to_msecs(jiffies))
+
+typedef struct lv_port_mem_stats
+{
+    kusize_t total;                             /*!< pool size */
+    kusize_t used;                              /*!< bytes requested and not yet freed */
+    kusize_t peak;                              /*!< maximum of used */
+    kusize_t free;                              /*!< bytes left in all blocks */
+    kusize_t free_biggest;                      /*!< the largest block that can be allocated */
+    kuint32_t frag_pct;                         /*!< 100 - free_biggest * 100 / free */
+
+    kuint32_t nr_alloc;
+    kuint32_t nr_free;
+    kuint32_t nr_fail;
+
+} srt_lv_port_mem_stats_t;
+
+/*!< The functions */
+extern void *lv_port_mem_alloc(kusize_t size);
+extern void lv_port_mem_free(void *ptr);
+extern void *lv_port_mem_realloc(void *ptr, kusize_t size);
+extern void lv_port_mem_stats(struct lv_port_mem_stats *sprt_stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /*!< __LV_PORT_MEM_H_ */
@@ -14,6 +14,7 @@
 #include <platform/fwk_inode.h>
 #include <platform/fwk_fcntl.h>
 #include <platform/mmc/fwk_sdcard.h>
+#include <kernel/sched.h>
 #include <fs/fs_intr.h>
 #include <fs/fs_fatfs.h>
 
@@ -26,6 +27,11 @@
 /*!< The globals */
 static DECLARE_LIST_HEAD(sgrt_fatfs_drvList);
 
+#if _FS_REENTRANT
+/*!< one lock for each volume: files of different volumes are accessed in parallel */
+static struct mutex_lock sgrt_fatfs_vol_lock[_VOLUMES];
+#endif
+
 /*!< The functions */
 static kint32_t fatfs_disk_mount(struct fwk_gendisk *sprt_gdisk);
 static kint32_t fatfs_disk_unmount(struct fwk_gendisk *sprt_gdisk);
@@ -196,6 +202,29 @@ static kint32_t fatfs_disk_rmdir(struct fwk_gendisk *sprt_gdisk, const kchar_t *
     return ER_NORMAL;
 }
 
+/*!
+ * @brief   build cluster link map table of file
+ * @param   sprt_fp, items: size of table that follows FIL
+ * @retval  none
+ * @note    with CLMT, f_lseek and f_read look clusters up in table instead of walking FAT chain;
+ *          FatFs can not extend a file in fast seek mode, so only read-only files get one
+ */
+static void fatfs_file_build_clmt(FIL *sprt_fp, kuint32_t items)
+{
+    DWORD *cltbl;
+
+    if (items < 4)
+        return;
+
+    cltbl = (DWORD *)(sprt_fp + 1);
+    cltbl[0] = items;
+    sprt_fp->cltbl = cltbl;
+
+    /*!< too many fragments: fall back to normal seek */
+    if (f_lseek(sprt_fp, CREATE_LINKMAP))
+        sprt_fp->cltbl = mrt_nullptr;
+}
+
 /*!
  * @brief   open file in disk
  * @param   sprt_blkdev, sprt_file
@@ -209,6 +238,7 @@ static kint32_t fatfs_file_open(struct fwk_block_device *sprt_blkdev, struct fs_
     FIL *sprt_fp;
     kchar_t *name;
     kuint8_t mode = 0;
+    kuint32_t items = 0;
 
     sprt_gdisk = sprt_blkdev->sprt_gdisk;
     sprt_fdisk = mrt_fatfs_disk_get(sprt_gdisk);
@@ -218,8 +248,12 @@ static kint32_t fatfs_file_open(struct fwk_block_device *sprt_blkdev, struct fs_
         ((*name == '/' ) && (*(name + 1) == '\0')))
         return -ER_UNVALID;
     
+    if (!(sprt_file->mode & (O_WRONLY | O_CREAT | O_APPEND)))
+        items = sprt_fdisk->clmt_items;
+
     /*!< struct FIL hope to satisfy x bytes alignment, it is not suggest to use "new" */
-    sprt_fp = (FIL *)kzalloc(sizeof(FIL), GFP_KERNEL);
+    /*!< CLMT follows FIL in the same allocation */
+    sprt_fp = (FIL *)kzalloc(sizeof(FIL) + items * sizeof(DWORD), GFP_KERNEL);
     if (!isValid(sprt_fp))
         return -ER_NOMEM;
 
@@ -239,6 +273,7 @@ static kint32_t fatfs_file_open(struct fwk_block_device *sprt_blkdev, struct fs_
     if (f_open(sprt_fp, (const TCHAR *)name, mode))
         goto fail;
 
+    fatfs_file_build_clmt(sprt_fp, items);
     sprt_file->private_data = sprt_fp;
     return ER_NORMAL;
 
@@ -396,6 +431,70 @@ static const struct fwk_block_device_oprts sgrt_fatfs_bops =
     .fpos   = fatfs_file_tell,
 };
 
+#if _FS_REENTRANT
+/*!
+ * @brief   create sync object of volume
+ * @param   vol: volume number, sobj: output
+ * @retval  1: success, 0: failed
+ * @note    called by f_mount
+ */
+int ff_cre_syncobj(BYTE vol, _SYNC_t *sobj)
+{
+    if (vol >= _VOLUMES)
+        return 0;
+
+    mutex_init(&sgrt_fatfs_vol_lock[vol]);
+    *sobj = &sgrt_fatfs_vol_lock[vol];
+
+    return 1;
+}
+
+/*!
+ * @brief   delete sync object of volume
+ * @param   sobj
+ * @retval  1: success, 0: failed
+ * @note    called by f_mount (unmount)
+ */
+int ff_del_syncobj(_SYNC_t sobj)
+{
+    mutex_init(sobj);
+    return 1;
+}
+
+/*!
+ * @brief   lock volume
+ * @param   sobj
+ * @retval  1: got it, 0: timeout (FR_TIMEOUT)
+ * @note    before scheduler is running, there is only one thread, the lock is always granted
+ */
+int ff_req_grant(_SYNC_t sobj)
+{
+    kutime_t timeout = jiffies + msecs_to_jiffies(_FS_TIMEOUT);
+
+    while (mutex_try_lock(sobj) == -ER_BUSY)
+    {
+        if (mrt_time_after(jiffies, timeout))
+            return 0;
+
+        schedule_thread();
+    }
+
+    return 1;
+}
+
+/*!
+ * @brief   unlock volume
+ * @param   sobj
+ * @retval  none
+ * @note    none
+ */
+void ff_rel_grant(_SYNC_t sobj)
+{
+    mutex_unlock(sobj);
+}
+
+#endif
+
 /*!
  * @brief   fatfs create and initial
  * @param   number: disk type
@@ -416,6 +515,7 @@ struct fatfs_disk *fs_alloc_fatfs(kuint16_t number)
 
     sprintk(sprt_fdisk->diskPath, "%d:/\0", number);
     sprt_fdisk->disk_number = number;
+    sprt_fdisk->clmt_items = FATFS_CLMT_ITEMS;
 
     sprt_gdisk->mount = fatfs_disk_mount;
     sprt_gdisk->unmount = fatfs_disk_unmount;
@@ -470,6 +570,18 @@ void fs_unregister_fatfs(struct fatfs_disk *sprt_fdisk)
     list_head_del(&sprt_fdisk->sgrt_link);
 }
 
+/*!
+ * @brief   set size of cluster link map table
+ * @param   sprt_fdisk, items: refer to "FATFS_CLMT_ITEMS"
+ * @retval  none
+ * @note    used by files opened after it
+ */
+void fs_fatfs_set_clmt(struct fatfs_disk *sprt_fdisk, kuint32_t items)
+{
+    if (isValid(sprt_fdisk))
+        sprt_fdisk->clmt_items = items;
+}
+
 /*!< ------------------------------------------------------------- */
 /*!
  * @brief   fs_fatfs_init
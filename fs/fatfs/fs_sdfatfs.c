@@ -12,11 +12,40 @@
 
 #include <platform/fwk_mempool.h>
 #include <platform/mmc/fwk_sdcard.h>
+#include <platform/block/fwk_blkqueue.h>
 #include <fs/fs_fatfs.h>
 
 /*!< The globals */
 static struct fwk_sdcard sgrt_fwk_sddisk;
 static struct fatfs_disk *sprt_fatfs_sddisk;
+static struct fwk_request_queue *sprt_sddisk_queue;
+
+/*!< The functions */
+/*!
+ * @brief   transfer sectors between memory and card
+ * @param   sprt_queue, buffer, sector, count
+ * @retval  errno
+ * @note    request queue callback
+ */
+static kint32_t fs_sdfatfs_read_sectors(struct fwk_request_queue *sprt_queue, void *buffer, kuint32_t sector, kuint32_t count)
+{
+    struct fwk_sdcard *sprt_card = (struct fwk_sdcard *)fwk_blk_queue_data(sprt_queue);
+
+    return fwk_sdcard_rw_blocks(sprt_card, buffer, sector, count, NR_SdCard_ReadToHost) ? ER_NORMAL : -ER_FAILD;
+}
+
+static kint32_t fs_sdfatfs_write_sectors(struct fwk_request_queue *sprt_queue, const void *buffer, kuint32_t sector, kuint32_t count)
+{
+    struct fwk_sdcard *sprt_card = (struct fwk_sdcard *)fwk_blk_queue_data(sprt_queue);
+
+    return fwk_sdcard_rw_blocks(sprt_card, (void *)buffer, sector, count, NR_SdCard_WriteToCard) ? ER_NORMAL : -ER_FAILD;
+}
+
+static const struct fwk_blk_queue_oprts sgrt_fs_sdfatfs_queue_oprts =
+{
+    .read_sectors = fs_sdfatfs_read_sectors,
+    .write_sectors = fs_sdfatfs_write_sectors,
+};
 
 /*!< API function */
 /*!
@@ -25,12 +54,21 @@ static struct fatfs_disk *sprt_fatfs_sddisk;
  * @retval  none
  * @note    write SD Card by Fatfs
  */
-DRESULT fs_sdfatfs_write(kuint8_t physicalDrive, const kuint8_t *buffer, kuint32_t sector, kuint8_t count)
+DRESULT fs_sdfatfs_write(kuint8_t physicalDrive, const kuint8_t *buffer, kuint32_t sector, kuint32_t count)
 {
     if (physicalDrive != SDDISK)
         return RES_PARERR;
 
-    if (!fwk_sdcard_rw_blocks(&sgrt_fwk_sddisk, (void *)buffer, sector, count, NR_SdCard_WriteToCard))
+    /*!< without queue (out of memory), access card directly */
+    if (!sprt_sddisk_queue)
+    {
+        if (!fwk_sdcard_rw_blocks(&sgrt_fwk_sddisk, (void *)buffer, sector, count, NR_SdCard_WriteToCard))
+            return RES_ERROR;
+
+        return RES_OK;
+    }
+
+    if (fwk_blk_write(sprt_sddisk_queue, buffer, sector, count))
         return RES_ERROR;
 
     return RES_OK;
@@ -42,12 +80,20 @@ DRESULT fs_sdfatfs_write(kuint8_t physicalDrive, const kuint8_t *buffer, kuint32
  * @retval  none
  * @note    read SD Card by Fatfs
  */
-DRESULT fs_sdfatfs_read(kuint8_t physicalDrive, kuint8_t *buffer, kuint32_t sector, kuint8_t count)
+DRESULT fs_sdfatfs_read(kuint8_t physicalDrive, kuint8_t *buffer, kuint32_t sector, kuint32_t count)
 {
     if (physicalDrive != SDDISK)
         return RES_PARERR;
 
-    if (!fwk_sdcard_rw_blocks(&sgrt_fwk_sddisk, buffer, sector, count, NR_SdCard_ReadToHost))
+    if (!sprt_sddisk_queue)
+    {
+        if (!fwk_sdcard_rw_blocks(&sgrt_fwk_sddisk, buffer, sector, count, NR_SdCard_ReadToHost))
+            return RES_ERROR;
+
+        return RES_OK;
+    }
+
+    if (fwk_blk_read(sprt_sddisk_queue, buffer, sector, count))
         return RES_ERROR;
 
     return RES_OK;
@@ -90,7 +136,9 @@ DRESULT fs_sdfatfs_ioctl(kuint8_t physicalDrive, kuint8_t command, void *buffer)
             break;
 
         case CTRL_SYNC:
-            result = RES_OK;
+            /*!< write back dirty sectors held by request queue */
+            if (sprt_sddisk_queue && fwk_blk_flush(sprt_sddisk_queue))
+                result = RES_ERROR;
             break;
         default:
             result = RES_PARERR;
@@ -158,6 +206,9 @@ DSTATUS fs_sdfatfs_release(kuint8_t physicalDrive)
     if (physicalDrive != SDDISK)
         return STA_NOINIT;
 
+    if (sprt_sddisk_queue)
+        fwk_blk_flush(sprt_sddisk_queue);
+
 	fwk_sdcard_inactive_device(&sgrt_fwk_sddisk);
 
 	return 0;
@@ -180,6 +231,16 @@ kint32_t __plat_init fs_sdfatfs_init(void)
     if (!isValid(sprt_fdisk))
         return -ER_NOMEM;
 
+    /*!< FAT and directory sectors are cached by queue; it is optional */
+    sprt_sddisk_queue = fwk_blk_alloc_queue("sddisk", _MAX_SS, 0, &sgrt_fs_sdfatfs_queue_oprts, &sgrt_fwk_sddisk);
+    if (!isValid(sprt_sddisk_queue))
+    {
+        print_warn("sd card request queue unavailable, sectors will not be cached\n");
+        sprt_sddisk_queue = mrt_nullptr;
+    }
+
+    sprt_fdisk->sgrt_gdisk.sprt_queue = sprt_sddisk_queue;
+
     retval = fs_register_fatfs(sprt_fdisk);
     if (retval)
     {
@@ -203,6 +264,8 @@ kint32_t __plat_init fs_sdfatfs_init(void)
     return ER_NORMAL;
 
 fail:
+    fwk_blk_free_queue(sprt_sddisk_queue);
+    sprt_sddisk_queue = mrt_nullptr;
     kfree(sprt_fdisk);
     return retval;
 }
@@ -222,6 +285,9 @@ void __plat_exit fs_sdfatfs_exit(void)
 
     fs_unregister_fatfs(sprt_fdisk);
     sprt_fdisk = mrt_nullptr;
+
+    fwk_blk_free_queue(sprt_sddisk_queue);
+    sprt_sddisk_queue = mrt_nullptr;
 }
 
 IMPORT_ROOTFS_INIT(fs_sdfatfs_init);
@@ -0,0 +1,204 @@
+/*
+ * General File Asynchronous I/O Interface
+ *
+ * File Name:   fs_aio.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+#include <platform/fwk_mempool.h>
+#include <kernel/sched.h>
+#include <kernel/thread.h>
+#include <kernel/wait.h>
+#include <kernel/mailbox.h>
+#include <fs/fs_intr.h>
+
+/*!< The defines */
+#define FS_AIO_MAILBOX_NAME                     "fs-aio"
+
+/*!< The globals */
+static DECLARE_LIST_HEAD(sgrt_fs_aio_list);
+static struct mutex_lock sgrt_fs_aio_lock = MUTEX_LOCK_INIT();
+static struct wait_queue_head sgrt_fs_aio_wqh;
+static struct wait_queue_head sgrt_fs_aio_done_wqh;
+static struct mailbox *sprt_fs_aio_mb;
+static tid_t g_fs_aio_tid = -1;
+
+/*!< The functions */
+/*!
+ * @brief   notify owner that request is completed
+ * @param   sprt_aio
+ * @retval  none
+ * @note    aiocb must not be touched after status is set, owner may release it at once
+ */
+static void fs_aio_complete(struct fs_aiocb *sprt_aio)
+{
+    struct fs_stream *sprt_fs = sprt_aio->sprt_fs;
+    struct mail sgrt_mail;
+    struct mail_msg sgrt_msg;
+
+    if (sprt_aio->complete)
+        sprt_aio->complete(sprt_aio);
+
+    if (sprt_aio->mb_name && sprt_fs_aio_mb)
+    {
+        mail_init(sprt_fs_aio_mb, &sgrt_mail);
+
+        sgrt_msg.type = NR_MAIL_TYPE_AIO;
+        sgrt_msg.code = (kuint32_t)sprt_aio->result;
+        sgrt_msg.buffer = (kuint8_t *)&sprt_aio;
+        sgrt_msg.size = sizeof(sprt_aio);
+
+        sgrt_mail.sprt_msg = &sgrt_msg;
+        sgrt_mail.num_msgs = 1;
+
+        if (mail_send(sprt_aio->mb_name, &sgrt_mail))
+            print_warn("fs aio: send mail to %s failed\n", sprt_aio->mb_name);
+    }
+
+    mutex_lock(&sgrt_fs_aio_lock);
+    sprt_fs->nr_aio--;
+    sprt_aio->status = NR_FS_AIO_Done;
+    mutex_unlock(&sgrt_fs_aio_lock);
+
+    wake_up(&sgrt_fs_aio_done_wqh);
+}
+
+/*!
+ * @brief   I/O worker
+ * @param   args
+ * @retval  none
+ * @note    requests are serviced in submission order
+ */
+static void *fs_aio_entry(void *args)
+{
+    struct fs_aiocb *sprt_aio;
+
+    for (;;)
+    {
+        wait_event(&sgrt_fs_aio_wqh, !mrt_list_head_empty(&sgrt_fs_aio_list));
+
+        mutex_lock(&sgrt_fs_aio_lock);
+        sprt_aio = mrt_list_first_valid_entry(&sgrt_fs_aio_list, struct fs_aiocb, sgrt_link);
+        if (sprt_aio)
+            list_head_del(&sprt_aio->sgrt_link);
+        mutex_unlock(&sgrt_fs_aio_lock);
+
+        if (!sprt_aio)
+            continue;
+
+        sprt_aio->result = file_read(sprt_aio->sprt_fs, sprt_aio->buffer, sprt_aio->size);
+        fs_aio_complete(sprt_aio);
+    }
+
+    return args;
+}
+
+/*!
+ * @brief   start I/O worker
+ * @param   none
+ * @retval  errno
+ * @note    streams may submit the first request at the same time: the check and the
+ *          creation are done under the lock, so the worker and its queues are set up once
+ */
+static kint32_t fs_aio_worker_init(void)
+{
+    kint32_t retval = ER_NORMAL;
+
+    mutex_lock(&sgrt_fs_aio_lock);
+
+    if (g_fs_aio_tid >= 0)
+        goto out;
+
+    init_waitqueue_head(&sgrt_fs_aio_wqh);
+    init_waitqueue_head(&sgrt_fs_aio_done_wqh);
+
+    g_fs_aio_tid = kernel_thread_create(-1, mrt_nullptr, fs_aio_entry, mrt_nullptr);
+    if (g_fs_aio_tid < 0)
+    {
+        retval = -ER_FAILD;
+        goto out;
+    }
+
+    thread_set_priority(mrt_tid_attr(g_fs_aio_tid), THREAD_PROTY_FSAIO);
+    thread_set_name(g_fs_aio_tid, "fs_aio_entry");
+
+    /*!< source of completion mails */
+    sprt_fs_aio_mb = mailbox_create(g_fs_aio_tid, FS_AIO_MAILBOX_NAME);
+    if (!isValid(sprt_fs_aio_mb))
+        sprt_fs_aio_mb = mrt_nullptr;
+
+out:
+    mutex_unlock(&sgrt_fs_aio_lock);
+    return retval;
+}
+
+/*!< API function */
+/*!
+ * @brief   read file asynchronously
+ * @param   sprt_aio: sprt_fs, buffer and size must be filled; complete, mb_name are optional
+ * @retval  errno
+ * @note    data is read from the current position of stream, like file_read;
+ *          requests of a stream complete in order, so the next one can be queued
+ *          before the previous is consumed (decoding overlaps with I/O)
+ */
+kint32_t file_read_async(struct fs_aiocb *sprt_aio)
+{
+    kint32_t retval;
+
+    if (!sprt_aio || !isValid(sprt_aio->sprt_fs) || !sprt_aio->buffer)
+        return -ER_NULLPTR;
+
+    retval = fs_aio_worker_init();
+    if (retval)
+        return retval;
+
+    sprt_aio->result = 0;
+    sprt_aio->status = NR_FS_AIO_Pending;
+    init_list_head(&sprt_aio->sgrt_link);
+
+    mutex_lock(&sgrt_fs_aio_lock);
+    sprt_aio->sprt_fs->nr_aio++;
+    list_head_add_tail(&sgrt_fs_aio_list, &sprt_aio->sgrt_link);
+    mutex_unlock(&sgrt_fs_aio_lock);
+
+    wake_up(&sgrt_fs_aio_wqh);
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   wait for asynchronous request
+ * @param   sprt_aio
+ * @retval  size of data read, or errno
+ * @note    none
+ */
+kssize_t file_aio_wait(struct fs_aiocb *sprt_aio)
+{
+    if (!sprt_aio)
+        return -ER_NULLPTR;
+
+    wait_event(&sgrt_fs_aio_done_wqh, file_aio_is_done(sprt_aio));
+
+    return sprt_aio->result;
+}
+
+/*!
+ * @brief   wait for all asynchronous requests of stream
+ * @param   sprt_fs
+ * @retval  none
+ * @note    none
+ */
+void file_aio_flush(struct fs_stream *sprt_fs)
+{
+    if (!sprt_fs || (g_fs_aio_tid < 0))
+        return;
+
+    wait_event(&sgrt_fs_aio_done_wqh, !sprt_fs->nr_aio);
+}
+
+/* end of file */
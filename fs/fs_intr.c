@@ -12,6 +12,7 @@
 
 #include <platform/fwk_mempool.h>
 #include <platform/fwk_inode.h>
+#include <platform/fwk_fcntl.h>
 #include <platform/fwk_fs.h>
 #include <platform/block/fwk_gendisk.h>
 #include <fs/fs_intr.h>
@@ -20,6 +21,109 @@
 
 /*!< The globals */
 
+/*!< The functions */
+/*!
+ * @brief   drop read-ahead window
+ * @param   sprt_fs
+ * @retval  errno
+ * @note    the file pointer of device is behind the window, move it back to reader
+ */
+static kint32_t file_readahead_drop(struct fs_stream *sprt_fs)
+{
+    struct fs_readahead *sprt_ra = &sprt_fs->sgrt_ra;
+    kuint32_t end;
+
+    if (!sprt_ra->lenth)
+        return ER_NORMAL;
+
+    end = sprt_ra->start + sprt_ra->lenth;
+    sprt_ra->lenth = 0;
+
+    if (sprt_ra->pos == end)
+        return ER_NORMAL;
+
+    return sprt_fs->sprt_bops->lseek(sprt_fs, sprt_ra->pos);
+}
+
+/*!
+ * @brief   read file through read-ahead window
+ * @param   sprt_fs, buf, size
+ * @retval  size of data read
+ * @note    the window grows (MIN, x2, ... MAX) while reads continue where the previous one ended,
+ *          and collapses on random access; reads larger than window bypass it
+ */
+static kssize_t file_readahead(struct fs_stream *sprt_fs, void *buf, kusize_t size)
+{
+    struct fs_readahead *sprt_ra = &sprt_fs->sgrt_ra;
+    struct fwk_block_device_oprts *sprt_bops = sprt_fs->sprt_bops;
+    kuint32_t pos, copied = 0;
+    kssize_t retval;
+    kbool_t is_sequential;
+
+    pos = sprt_ra->lenth ? sprt_ra->pos : sprt_bops->fpos(sprt_fs);
+    is_sequential = (pos == sprt_ra->next);
+
+    /*!< hit window */
+    if (sprt_ra->lenth)
+    {
+        copied = mrt_ret_min2((kuint32_t)size, sprt_ra->start + sprt_ra->lenth - pos);
+        memcpy(buf, sprt_ra->buffer + (pos - sprt_ra->start), copied);
+        sprt_ra->pos += copied;
+
+        if (copied == size)
+            goto out;
+
+        /*!< window exhausted, the file pointer of device is just behind it */
+        sprt_ra->lenth = 0;
+    }
+
+    if (is_sequential)
+        sprt_ra->size = sprt_ra->size ? CMP_MIN2(sprt_ra->size << 1, FS_READAHEAD_MAX) : FS_READAHEAD_MIN;
+    else
+        sprt_ra->size = 0;
+
+    if (sprt_ra->size && !sprt_ra->buffer)
+    {
+        sprt_ra->buffer = kmalloc(FS_READAHEAD_MAX, GFP_KERNEL);
+        if (!isValid(sprt_ra->buffer))
+        {
+            sprt_ra->buffer = mrt_nullptr;
+            sprt_ra->size = 0;
+        }
+    }
+
+    if ((size - copied) >= sprt_ra->size)
+    {
+        retval = sprt_bops->read(sprt_fs, (kuint8_t *)buf + copied, size - copied, 0);
+        if (retval < 0)
+            return copied ? copied : retval;
+
+        copied += retval;
+        goto out;
+    }
+
+    /*!< refill window */
+    retval = sprt_bops->read(sprt_fs, sprt_ra->buffer, sprt_ra->size, 0);
+    if (retval < 0)
+        return copied ? copied : retval;
+
+    sprt_ra->start = pos + copied;
+    sprt_ra->lenth = retval;
+    sprt_ra->pos = sprt_ra->start;
+
+    retval = CMP_MIN2((kssize_t)(size - copied), retval);
+    memcpy((kuint8_t *)buf + copied, sprt_ra->buffer, retval);
+    sprt_ra->pos += retval;
+    copied += retval;
+
+    if (sprt_ra->pos == (sprt_ra->start + sprt_ra->lenth))
+        sprt_ra->lenth = 0;
+
+out:
+    sprt_ra->next = pos + copied;
+    return copied;
+}
+
 /*!< API function */
 /*!
  * @brief   open file
@@ -46,6 +150,7 @@ struct fs_stream *file_open(const kchar_t *name, kuint32_t mode)
     sprt_fs->full_name = (kchar_t *)name;
     sprt_fs->mode = mode;
     sprt_fs->sprt_dnode = sprt_inode;
+    mutex_init(&sprt_fs->sgrt_lock);
 
     sgrt_file.sprt_foprts = sprt_inode->sprt_foprts;
     if (sgrt_file.sprt_foprts->open)
@@ -93,6 +198,9 @@ void file_close(struct fs_stream *sprt_fs)
     sprt_dnode = sprt_fs->sprt_dnode;
     sprt_blkdev = sprt_dnode->sprt_blkdev;
 
+    /*!< I/O worker may still be reading this stream */
+    file_aio_flush(sprt_fs);
+
     if (sprt_fs->sprt_bops->close)
     {
         retval = sprt_fs->sprt_bops->close(sprt_blkdev, sprt_fs);
@@ -105,6 +213,9 @@ void file_close(struct fs_stream *sprt_fs)
     if (sgrt_file.sprt_foprts->close)
         sgrt_file.sprt_foprts->close(sprt_dnode, &sgrt_file);
 
+    if (sprt_fs->sgrt_ra.buffer)
+        kfree(sprt_fs->sgrt_ra.buffer);
+
     kfree(sprt_fs);
 }
 
@@ -116,10 +227,20 @@ void file_close(struct fs_stream *sprt_fs)
  */
 kssize_t file_write(struct fs_stream *sprt_fs, const void *buf, kusize_t size)
 {
+    kssize_t retval;
+
     if (!sprt_fs->sprt_bops->write)
         return -ER_ERROR;
 
-    return sprt_fs->sprt_bops->write(sprt_fs, buf, size, 0);
+    mutex_lock(&sprt_fs->sgrt_lock);
+
+    retval = file_readahead_drop(sprt_fs);
+    if (!retval)
+        retval = sprt_fs->sprt_bops->write(sprt_fs, buf, size, 0);
+
+    mutex_unlock(&sprt_fs->sgrt_lock);
+
+    return retval;
 }
 
 /*!
@@ -130,10 +251,24 @@ kssize_t file_write(struct fs_stream *sprt_fs, const void *buf, kusize_t size)
  */
 kssize_t file_read(struct fs_stream *sprt_fs, void *buf, kusize_t size)
 {
-    if (!sprt_fs->sprt_bops->read)
+    struct fwk_block_device_oprts *sprt_bops = sprt_fs->sprt_bops;
+    kssize_t retval;
+
+    if (!sprt_bops->read)
         return -ER_ERROR;
 
-    return sprt_fs->sprt_bops->read(sprt_fs, buf, size, 0);
+    /*!< window needs lseek/fpos to keep file pointer coherent */
+    if (!sprt_bops->lseek || !sprt_bops->fpos || !(sprt_fs->mode & O_RDONLY))
+        return sprt_bops->read(sprt_fs, buf, size, 0);
+
+    if (!size)
+        return 0;
+
+    mutex_lock(&sprt_fs->sgrt_lock);
+    retval = file_readahead(sprt_fs, buf, size);
+    mutex_unlock(&sprt_fs->sgrt_lock);
+
+    return retval;
 }
 
 /*!
@@ -158,10 +293,29 @@ kssize_t file_size(struct fs_stream *sprt_fs)
  */
 kint32_t file_lseek(struct fs_stream *sprt_fs, kuint32_t offset)
 {
+    struct fs_readahead *sprt_ra = &sprt_fs->sgrt_ra;
+    kint32_t retval;
+
     if (!sprt_fs->sprt_bops->lseek)
         return -ER_ERROR;
 
-    return sprt_fs->sprt_bops->lseek(sprt_fs, offset);
+    mutex_lock(&sprt_fs->sgrt_lock);
+
+    /*!< inside window, device need not seek */
+    if (sprt_ra->lenth && (offset >= sprt_ra->start) && (offset < (sprt_ra->start + sprt_ra->lenth)))
+    {
+        sprt_ra->pos = offset;
+        retval = ER_NORMAL;
+    }
+    else
+    {
+        sprt_ra->lenth = 0;
+        retval = sprt_fs->sprt_bops->lseek(sprt_fs, offset);
+    }
+
+    mutex_unlock(&sprt_fs->sgrt_lock);
+
+    return retval;
 }
 
 /*!
@@ -175,6 +329,9 @@ kssize_t file_tell(struct fs_stream *sprt_fs)
     if (!sprt_fs->sprt_bops->fpos)
         return -ER_ERROR;
 
+    if (sprt_fs->sgrt_ra.lenth)
+        return sprt_fs->sgrt_ra.pos;
+
     return sprt_fs->sprt_bops->fpos(sprt_fs);
 }
 
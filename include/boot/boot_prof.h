@@ -0,0 +1,79 @@
+/*
+ * Boot Timeline Profiler
+ *
+ * File Name:   boot_prof.h
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+#ifndef __BOOT_PROF_H
+#define __BOOT_PROF_H
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/*!< The includes */
+#include <common/generic.h>
+
+/*!< The defines */
+/*!< events kept in boot log, the later ones are dropped */
+#ifdef CONFIG_BOOT_PROF_EVENTS
+#define BOOT_PROF_EVENTS                            (CONFIG_BOOT_PROF_EVENTS)
+#else
+#define BOOT_PROF_EVENTS                            (256)
+#endif
+
+/*!< cpu frequency, PMU cycle counter is converted to micro seconds by it */
+#ifdef CONFIG_BOOT_PROF_CPU_HZ
+#define BOOT_PROF_CPU_HZ                            (CONFIG_BOOT_PROF_CPU_HZ)
+#else
+#define BOOT_PROF_CPU_HZ                            (792000000UL)
+#endif
+
+#define BOOT_PROF_SYMBOL_LEN                        (64)
+
+enum __ERT_BOOT_PROF_TYPE
+{
+    NR_BOOT_PROF_INITCALL = 0,                      /*!< synchronous initcall */
+    NR_BOOT_PROF_ASYNC,                             /*!< initcall run by boot worker */
+    NR_BOOT_PROF_PROBE,                             /*!< driver probe */
+    NR_BOOT_PROF_STAGE,                             /*!< other step of start_kernel */
+
+    NR_BOOT_PROF_TYPE_MAX,
+};
+
+typedef struct boot_prof_event
+{
+    kuint32_t type;                                 /*!< refer to "__ERT_BOOT_PROF_TYPE" */
+    kuint32_t level;                                /*!< initcall section, 0 for others */
+    const void *func;                               /*!< function called, name is resolved from it if "name" is null */
+    const kchar_t *name;                            /*!< device name for probe */
+    const kchar_t *owner;                           /*!< driver name for probe */
+
+    kuint64_t start;                                /*!< unit: us */
+    kuint64_t end;                                  /*!< unit: us, 0 if not finished */
+    kint32_t retval;
+    kint32_t tid;                                   /*!< -1: before scheduler runs */
+
+} srt_boot_prof_event_t;
+
+/*!< The functions */
+extern void boot_prof_init(void);
+extern kuint64_t boot_prof_clock_us(void);
+extern kint32_t boot_prof_begin(kuint32_t type, const void *func, const kchar_t *name, const kchar_t *owner, kuint32_t level);
+extern void boot_prof_end(kint32_t slot, kint32_t retval);
+extern kuint32_t boot_prof_count(kuint32_t *dropped);
+extern struct boot_prof_event *boot_prof_get(kuint32_t idx);
+extern const kchar_t *boot_prof_symbol(const void *func, kchar_t *buf, kusize_t size);
+extern const kchar_t *boot_prof_type_name(kuint32_t type);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /*!< __BOOT_PROF_H */
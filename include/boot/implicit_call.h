@@ -27,6 +27,28 @@
 #define IMPORT_DYNC_INIT_ENTRY(prefix, x, sec)		__used const dync_init_t prefix##_##x sec = (dync_init_t)x
 #define IMPORT_DYNC_EXIT_ENTRY(prefix, x, sec)		__used const dync_exit_t prefix##_##x sec = (dync_exit_t)x
 
+/*!<
+ * asynchronous initcall:
+ * the section keeps a stub, which queues x on the level being run instead of calling it;
+ * after the scheduler starts, boot workers run the queued ones, level by level:
+ * every async initcall of a level returns before any of the next level starts.
+ * So an async initcall runs after all synchronous ones, and must not be depended by them
+ */
+#define IMPORT_DYNC_ASYNC_ENTRY(prefix, x, dep, sec)	\
+	struct dync_async_initcall dync_async_##x = { .func = x, .name = #x, .sprt_dep = dep };	\
+	static kint32_t x##_async(void) { return dync_initcall_async(&dync_async_##x); }	\
+	IMPORT_DYNC_INIT_ENTRY(prefix, x##_async, sec)
+
+/*!< refer an async initcall of other file as dependency */
+#define DECLARE_DYNC_ASYNC(x)						extern struct dync_async_initcall dync_async_##x
+
+/*!< number of boot workers, 0: async initcalls are called at once, as synchronous ones */
+#ifdef CONFIG_DYNC_ASYNC_WORKERS
+#define DYNC_ASYNC_WORKERS							(CONFIG_DYNC_ASYNC_WORKERS)
+#else
+#define DYNC_ASYNC_WORKERS							(2)
+#endif
+
 enum __ERT_DYNC_SECTION_DEF
 {
 	NR_DYNC_SEC_STATIC		= 0,					/*!< save persistent params */
@@ -46,6 +68,28 @@ enum __ERT_DYNC_SECTION_DEF
 	NR_DYNC_SEC_END,
 };
 
+enum __ERT_DYNC_ASYNC_STATE
+{
+	NR_DYNC_ASYNC_IDLE = 0,
+	NR_DYNC_ASYNC_QUEUED,
+	NR_DYNC_ASYNC_RUNNING,
+	NR_DYNC_ASYNC_DONE,
+	NR_DYNC_ASYNC_FAILED,
+};
+
+typedef struct dync_async_initcall
+{
+	dync_init_t func;
+	const kchar_t *name;
+	struct dync_async_initcall *sprt_dep;			/*!< optional, runs first if it is in the same level */
+
+	kuint32_t level;								/*!< refer to "__ERT_DYNC_SECTION_DEF" */
+	kuint32_t state;								/*!< refer to "__ERT_DYNC_ASYNC_STATE" */
+	kint32_t retval;
+	struct dync_async_initcall *sprt_next;			/*!< next one of the same level */
+
+} srt_dync_async_initcall_t;
+
 /*!< *(.dync_init.0), *(.dync_exit.0) */
 #define __DYNC_STC_INIT_SEC							__DYNC_INIT_SEC(0)
 #define __DYNC_STC_EXIT_SEC							__DYNC_EXIT_SEC(0)
@@ -147,6 +191,18 @@ extern const dync_exit_t *dync_exit_sections[];
 #define IMPORT_DEVICE_INIT(x)					    IMPORT_DYNC_INIT_ENTRY(bsp,  x, __DYNC_DEV_INIT_SEC)
 #define IMPORT_DRIVER_INIT(x)					    IMPORT_DYNC_INIT_ENTRY(drv,  x, __DYNC_DRV_INIT_SEC)
 
+/* async init */
+#define IMPORT_PLATFORM_INIT_ASYNC(x)				IMPORT_DYNC_ASYNC_ENTRY(plat, x, mrt_nullptr, __DYNC_PLAT_INIT_SEC)
+#define IMPORT_PATTERN_INIT_ASYNC(x)				IMPORT_DYNC_ASYNC_ENTRY(patt, x, mrt_nullptr, __DYNC_PATT_INIT_SEC)
+#define IMPORT_DEVICE_INIT_ASYNC(x)					IMPORT_DYNC_ASYNC_ENTRY(bsp,  x, mrt_nullptr, __DYNC_DEV_INIT_SEC)
+#define IMPORT_DRIVER_INIT_ASYNC(x)					IMPORT_DYNC_ASYNC_ENTRY(drv,  x, mrt_nullptr, __DYNC_DRV_INIT_SEC)
+
+/*!< dep: name of another async initcall, which must return successfully before x is called */
+#define IMPORT_PLATFORM_INIT_ASYNC_DEP(x, dep)		IMPORT_DYNC_ASYNC_ENTRY(plat, x, &dync_async_##dep, __DYNC_PLAT_INIT_SEC)
+#define IMPORT_PATTERN_INIT_ASYNC_DEP(x, dep)		IMPORT_DYNC_ASYNC_ENTRY(patt, x, &dync_async_##dep, __DYNC_PATT_INIT_SEC)
+#define IMPORT_DEVICE_INIT_ASYNC_DEP(x, dep)		IMPORT_DYNC_ASYNC_ENTRY(bsp,  x, &dync_async_##dep, __DYNC_DEV_INIT_SEC)
+#define IMPORT_DRIVER_INIT_ASYNC_DEP(x, dep)		IMPORT_DYNC_ASYNC_ENTRY(drv,  x, &dync_async_##dep, __DYNC_DRV_INIT_SEC)
+
 /* exit */
 #define IMPORT_EARLY_EXIT(x)				        IMPORT_DYNC_EXIT_ENTRY(early,x, __DYNC_EARLY_EXIT_SEC)
 #define IMPORT_LATE_EXIT(x)					        IMPORT_DYNC_EXIT_ENTRY(late, x, __DYNC_LATE_EXIT_SEC)
@@ -160,6 +216,9 @@ extern const dync_exit_t *dync_exit_sections[];
 /*!< The functions */
 extern kint32_t dync_initcall_run_list(const kuint32_t section);
 extern void dync_exitcall_run_list(const kuint32_t section);
+extern kint32_t dync_initcall_async(struct dync_async_initcall *sprt_async);
+extern void dync_initcall_async_start(void);
+extern kint32_t dync_initcall_async_wait(struct dync_async_initcall *sprt_async);
 
 extern kint32_t board_early_initcall(void);
 extern kint32_t board_late_initcall(void);
@@ -244,6 +244,69 @@ static inline kbool_t atomic_is_bitset(kint32_t nr, void *ptr_addr)
 	return !!result;
 }
 
+/*!
+ * @brief   atomic_list_push
+ * @param   ptr_top: address of the list top, ptr_node: new node
+ * @retval  none
+ * @note    lock-free stack push, the first word of node must be used as "next" pointer
+ */
+static inline void atomic_list_push(void **ptr_top, void *ptr_node)
+{
+	kutype_t flag;
+	void *top, *expect;
+
+	do {
+		expect = *(void * volatile *)ptr_top;
+		*(void **)ptr_node = expect;
+
+		__asm__ __volatile__ (
+			"   dmb 0xf			\n\t"
+			"   ldrex %0, [%2]		\n\t"
+			"	mov %1, #0x1		\n\t"
+			"	teq %0, %3			\n\t"
+			"	bne 1f				\n\t"
+			"	strex %1, %4, [%2]	\n\t"
+			" 1:	                \n\t"
+			: "=&r"(top), "=&r"(flag)
+			: "r"(ptr_top), "r"(expect), "r"(ptr_node)
+			: "cc", "memory"
+		);
+
+	} while (flag);
+}
+
+/*!
+ * @brief   atomic_list_pop
+ * @param   ptr_top: address of the list top
+ * @retval  node popped (null if list is empty)
+ * @note    lock-free stack pop;
+ *          "next" is loaded inside the exclusive section, any push/pop (or interrupt) in between
+ *          clears the monitor and forces a retry, so it is free of the ABA problem
+ */
+static inline void *atomic_list_pop(void **ptr_top)
+{
+	kutype_t flag;
+	void *top, *next;
+
+	__asm__ __volatile__ (
+		" 1:	                \n\t"
+		"   ldrex %0, [%3]		\n\t"
+		"	teq %0, #0x0		\n\t"
+		"	beq 2f				\n\t"
+		"	ldr %1, [%0]		\n\t"
+		"	strex %2, %1, [%3]	\n\t"
+		"	teq %2, #0x0		\n\t"
+		"	bne 1b				\n\t"
+		"	dmb 0xf				\n\t"
+		" 2:	                \n\t"
+		: "=&r"(top), "=&r"(next), "=&r"(flag)
+		: "r"(ptr_top)
+		: "cc", "memory"
+	);
+
+	return top;
+}
+
 #ifdef __cplusplus
     }
 #endif
@@ -69,6 +69,9 @@ enum __ERT_ERROR_CODE
 	ER_SDATA_FAILD,
 	ER_RDATA_FAILD,
 	ER_STOP_FAILD,					
+
+	/*!< driver model */
+	ER_DEFER,						/*!< probe deferred: a resource provider is not registered yet */
 };
 
 /*!< The functions */
@@ -30,6 +30,16 @@
 /*!< The defines */
 #define FATFS_DISK_PATH_LEN                 (10)
 
+/*!< 
+ * items of cluster link map table (CLMT) built for each file opened read-only;
+ * a file with n fragments needs (n + 1) * 2 items, 0 disables fast seek
+ */
+#ifdef CONFIG_FATFS_CLMT_ITEMS
+#define FATFS_CLMT_ITEMS                    (CONFIG_FATFS_CLMT_ITEMS)
+#else
+#define FATFS_CLMT_ITEMS                    (64)
+#endif
+
 /*!< for the whole disk */
 typedef struct fatfs_disk
 {
@@ -43,6 +53,7 @@ typedef struct fatfs_disk
 
     kuint16_t disk_number;
     kbool_t is_mounted;
+    kuint32_t clmt_items;                   /*!< refer to "FATFS_CLMT_ITEMS" */
 
     struct list_head sgrt_link;
 
@@ -54,9 +65,9 @@ typedef struct fatfs_disk
 /*!< The functions */
 /*!< sd card */
 extern DRESULT fs_sdfatfs_write(kuint8_t physicalDrive, 
-                                const kuint8_t *buffer, kuint32_t sector, kuint8_t count);
+                                const kuint8_t *buffer, kuint32_t sector, kuint32_t count);
 extern DRESULT fs_sdfatfs_read(kuint8_t physicalDrive, 
-                                kuint8_t *buffer, kuint32_t sector, kuint8_t count);
+                                kuint8_t *buffer, kuint32_t sector, kuint32_t count);
 extern DRESULT fs_sdfatfs_ioctl(kuint8_t physicalDrive, kuint8_t command, void *buffer);
 extern DSTATUS fs_sdfatfs_status(kuint8_t physicalDrive);
 extern DSTATUS fs_sdfatfs_initial(kuint8_t physicalDrive);
@@ -65,6 +76,7 @@ extern DSTATUS fs_sdfatfs_release(kuint8_t physicalDrive);
 extern struct fatfs_disk *fs_alloc_fatfs(kuint16_t number);
 extern kint32_t fs_register_fatfs(struct fatfs_disk *sprt_fdisk);
 extern void fs_unregister_fatfs(struct fatfs_disk *sprt_fdisk);
+extern void fs_fatfs_set_clmt(struct fatfs_disk *sprt_fdisk, kuint32_t items);
 
 #ifdef __cplusplus
     }
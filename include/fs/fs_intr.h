@@ -23,8 +23,27 @@
 #include <common/io_stream.h>
 #include <platform/fwk_kobj.h>
 #include <platform/block/fwk_gendisk.h>
+#include <kernel/mutex.h>
 
 /*!< The defines */
+/*!< read-ahead window: starts at MIN, doubles on each sequential refill, up to MAX */
+#ifdef CONFIG_FS_READAHEAD_MAX
+#define FS_READAHEAD_MAX                        (CONFIG_FS_READAHEAD_MAX)
+#else
+#define FS_READAHEAD_MAX                        (32 * 1024)
+#endif
+#define FS_READAHEAD_MIN                        (4 * 1024)
+
+struct fs_readahead
+{
+    kuint8_t *buffer;
+    kuint32_t start;                            /*!< file offset of buffer[0] */
+    kuint32_t lenth;                            /*!< valid bytes (0: window is empty) */
+    kuint32_t pos;                              /*!< reader offset, inside window */
+    kuint32_t next;                             /*!< offset that a sequential read starts at */
+    kuint32_t size;                             /*!< current window size (0: random access) */
+};
+
 struct fs_stream
 {
     kchar_t *full_name;
@@ -32,9 +51,42 @@ struct fs_stream
     struct fwk_inode *sprt_dnode;
     struct fwk_block_device_oprts *sprt_bops;
 
+    struct fs_readahead sgrt_ra;
+    kuint32_t nr_aio;                           /*!< asynchronous requests not completed */
+    struct mutex_lock sgrt_lock;
+
     void *private_data;
 };
 
+enum __ERT_FS_AIO_STATUS
+{
+    NR_FS_AIO_Pending = 0,
+    NR_FS_AIO_Done,
+};
+
+struct fs_aiocb;
+typedef void (*fs_aio_complete_t)(struct fs_aiocb *sprt_aio);
+
+typedef struct fs_aiocb
+{
+    struct fs_stream *sprt_fs;
+    void *buffer;
+    kusize_t size;
+
+    /*!< 
+     * completion: called by I/O worker, and/or a mail (NR_MAIL_TYPE_AIO) is sent to mailbox "mb_name";
+     * code of mail is the result, buffer of mail holds the address of aiocb
+     */
+    fs_aio_complete_t complete;
+    const kchar_t *mb_name;
+    void *private_data;
+
+    kssize_t result;                            /*!< bytes read or errno */
+    volatile kuint32_t status;
+    struct list_head sgrt_link;
+
+} srt_fs_aiocb_t;
+
 /*!< The functions */
 extern struct fs_stream *file_open(const kchar_t *name, kuint32_t mode);
 extern void file_close(struct fs_stream *sprt_fs);
@@ -44,6 +96,22 @@ extern kssize_t file_size(struct fs_stream *sprt_fs);
 extern kint32_t file_lseek(struct fs_stream *sprt_fs, kuint32_t offset);
 extern kssize_t file_tell(struct fs_stream *sprt_fs);
 
+extern kint32_t file_read_async(struct fs_aiocb *sprt_aio);
+extern kssize_t file_aio_wait(struct fs_aiocb *sprt_aio);
+extern void file_aio_flush(struct fs_stream *sprt_fs);
+
+/*!< API functions */
+/*!
+ * @brief   check if asynchronous request is completed
+ * @param   sprt_aio
+ * @retval  completed(true) / pending(false)
+ * @note    none
+ */
+static inline kbool_t file_aio_is_done(struct fs_aiocb *sprt_aio)
+{
+    return (sprt_aio->status == NR_FS_AIO_Done);
+}
+
 #ifdef __cplusplus
     }
 #endif
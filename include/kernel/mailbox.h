@@ -30,6 +30,7 @@ enum __ERT_KERNEL_MAIL_TYPE
     NR_MAIL_TYPE_ABS,
     NR_MAIL_TYPE_REL,
     NR_MAIL_TYPE_SERIAL,
+    NR_MAIL_TYPE_AIO,
 };
 
 struct mail_msg
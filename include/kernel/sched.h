@@ -29,6 +29,8 @@ struct mailbox;
 
 #define THREAD_NAME_SIZE                        (32)
 
+struct fwk_file_table;
+
 struct thread
 {
     /*!< thread name */
@@ -57,6 +59,9 @@ struct thread
 
     struct spin_lock sgrt_lock;
     struct mailbox *sprt_mb;
+
+    /*!< descriptor table of thread group, null: the global one */
+    struct fwk_file_table *sprt_files;
 };
 
 #define mrt_thread_set_flags(signal, sprt_tsk)	\
@@ -81,6 +81,10 @@ typedef kint32_t tid_t;
 
 #define THREAD_PROTY_SOCKRX                 (19)
 #define THREAD_PROTY_SOCKTX                 (20)
+#define THREAD_PROTY_BDFLUSH                (__THREAD_HIGHER_DEFAULT(10))
+#define THREAD_PROTY_FSAIO                  (__THREAD_HIGHER_DEFAULT(10))
+#define THREAD_PROTY_FBFLIP                 (__THREAD_HIGHER_DEFAULT(20))
+#define THREAD_PROTY_LVFLUSH                (__THREAD_HIGHER_DEFAULT(5))
 
 #define __THREAD_IS_LOW_PRIO(prio, prio2)	((prio2) <= (prio))
 #define __THREAD_HIGHER_DEFAULT(val)		(THREAD_PROTY_DEFAULT - (val))	
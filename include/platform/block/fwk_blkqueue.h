@@ -0,0 +1,152 @@
+/*
+ * Hardware Abstraction Layer Block Request Queue
+ *
+ * File Name:   fwk_blkqueue.h
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+#ifndef __FWK_BLKQUEUE_H_
+#define __FWK_BLKQUEUE_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+#include <kernel/mutex.h>
+
+/*!< The defines */
+/*!< number of sector buffers per queue (write-back LRU cache) */
+#ifdef CONFIG_BLK_CACHE_SECTORS
+#define FWK_BLK_CACHE_SECTORS                   (CONFIG_BLK_CACHE_SECTORS)
+#else
+#define FWK_BLK_CACHE_SECTORS                   (64)
+#endif
+
+/*!< dirty sectors are written back by bdflush at this period, unit: ms */
+#ifdef CONFIG_BLK_FLUSH_PERIOD
+#define FWK_BLK_FLUSH_PERIOD                    (CONFIG_BLK_FLUSH_PERIOD)
+#else
+#define FWK_BLK_FLUSH_PERIOD                    (1000)
+#endif
+
+/*!< the largest request that merging can build, unit: sector */
+#define FWK_BLK_MAX_SECTORS                     (64)
+/*!< sectors read ahead on a cache miss, merged with the missed one */
+#define FWK_BLK_READAHEAD                       (8)
+/*!< requests held in the queue before it has to be run */
+#define FWK_BLK_MAX_REQUESTS                    (32)
+#define FWK_BLK_HASH_SIZE                       (32)
+
+enum __ERT_BLK_REQUEST_DIR
+{
+    NR_BLK_RequestRead = 0,
+    NR_BLK_RequestWrite,
+};
+
+enum __ERT_BLK_BUFFER_STATE
+{
+    NR_BLK_BufferValid = mrt_bit(0),
+    NR_BLK_BufferDirty = mrt_bit(1),
+};
+
+struct fwk_request_queue;
+
+struct fwk_blk_queue_oprts
+{
+    kint32_t (*read_sectors) (struct fwk_request_queue *sprt_queue, void *buffer, kuint32_t sector, kuint32_t count);
+    kint32_t (*write_sectors) (struct fwk_request_queue *sprt_queue, const void *buffer, kuint32_t sector, kuint32_t count);
+};
+
+typedef struct fwk_blk_buffer
+{
+    kuint32_t sector;
+    kuint32_t flags;
+    kuint8_t *data;
+
+    struct list_head sgrt_lru;
+    struct list_head sgrt_hash;
+
+} srt_fwk_blk_buffer_t;
+
+typedef struct fwk_blk_request
+{
+    kuint32_t sector;
+    kuint32_t count;
+    kuint8_t *buffer;
+
+    /*!< owner of buffer, it will be marked clean after written back */
+    struct fwk_blk_buffer *sprt_bh;
+
+} srt_fwk_blk_request_t;
+
+typedef struct fwk_blk_stats
+{
+    kuint32_t hits;
+    kuint32_t misses;
+    kuint32_t reads;                            /*!< requests issued to device */
+    kuint32_t writes;
+    kuint32_t merges;                           /*!< requests folded into a neighbour */
+    kuint32_t writebacks;                       /*!< dirty sectors written back */
+    kuint32_t wberrors;                         /*!< dirty sectors dropped, since write-back failed */
+
+} srt_fwk_blk_stats_t;
+
+typedef struct fwk_request_queue
+{
+    kchar_t name[DEVICE_NAME_LEN];
+    kuint32_t sector_size;
+    void *queuedata;
+    const struct fwk_blk_queue_oprts *sprt_oprts;
+
+    /*!< pending requests, sorted by sector */
+    struct fwk_blk_request sgrt_reqs[FWK_BLK_MAX_REQUESTS];
+    kuint32_t nr_reqs;
+    kuint32_t dir;
+    kuint8_t *bounce;
+
+    /*!< sector cache */
+    struct fwk_blk_buffer *sprt_bufs;
+    kuint32_t nr_bufs;
+    kuint32_t nr_dirty;
+    struct list_head sgrt_lru;
+    struct list_head sgrt_hash[FWK_BLK_HASH_SIZE];
+
+    struct fwk_blk_stats sgrt_stats;
+    struct mutex_lock sgrt_lock;
+    struct list_head sgrt_link;
+
+} srt_fwk_request_queue_t;
+
+/*!< The functions */
+extern struct fwk_request_queue *fwk_blk_alloc_queue(const kchar_t *name, kuint32_t sector_size, kuint32_t nr_bufs,
+                                            const struct fwk_blk_queue_oprts *sprt_oprts, void *queuedata);
+extern void fwk_blk_free_queue(struct fwk_request_queue *sprt_queue);
+extern kint32_t fwk_blk_read(struct fwk_request_queue *sprt_queue, void *buffer, kuint32_t sector, kuint32_t count);
+extern kint32_t fwk_blk_write(struct fwk_request_queue *sprt_queue, const void *buffer, kuint32_t sector, kuint32_t count);
+extern kint32_t fwk_blk_flush(struct fwk_request_queue *sprt_queue);
+extern void fwk_blk_foreach_queue(void (*func)(struct fwk_request_queue *sprt_queue, void *data), void *data);
+
+/*!< API functions */
+/*!
+ * @brief   get private data of queue
+ * @param   sprt_queue
+ * @retval  queuedata
+ * @note    none
+ */
+static inline void *fwk_blk_queue_data(struct fwk_request_queue *sprt_queue)
+{
+    return sprt_queue->queuedata;
+}
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /*!< __FWK_BLKQUEUE_H_ */
@@ -23,6 +23,7 @@
 #include <platform/block/fwk_blkdev.h>
 
 struct fs_stream;
+struct fwk_request_queue;
 
 /*!< The defines */
 typedef struct fwk_gendisk
@@ -42,6 +43,7 @@ typedef struct fwk_gendisk
     struct fwk_block_device_oprts *sprt_bops;
 
     struct fwk_block_device *sprt_blkdev;
+    struct fwk_request_queue *sprt_queue;
 
 } srt_fwk_gendisk_t;
 
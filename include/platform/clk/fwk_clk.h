@@ -116,6 +116,7 @@ extern struct fwk_clk *fwk_create_clk(struct fwk_clk_hw *sprt_hw, const kchar_t
 extern kint32_t fwk_init_clk(struct fwk_device *sprt_dev, struct fwk_clk *sprt_clk);
 
 extern struct fwk_clk *fwk_clk_get(struct fwk_device *sprt_dev, const kchar_t *name);
+extern kbool_t fwk_clk_is_deferred(struct fwk_device *sprt_dev, const kchar_t *name);
 extern void fwk_clk_put(struct fwk_clk *sprt_clk);
 extern void fwk_clk_enable(struct fwk_clk *sprt_clk);
 extern void fwk_clk_disable(struct fwk_clk *sprt_clk);
@@ -34,17 +34,32 @@
 
 #define FILE_DESC_OVER_BASE(fd)								(fd < DEVICE_MAJOR_BASE)
 
+/*!< two-level free map: one bit per descriptor, and one bit per word of it that is full */
+#define FILE_DESC_BITMAP_BITS								(32)
+#define FILE_DESC_BITMAP_NUM								((NETWORK_SOCKETS_BASE + FILE_DESC_BITMAP_BITS - 1) / FILE_DESC_BITMAP_BITS)
+
+struct thread;
+
+/*!<
+ * descriptor table, shared by a thread group: threads created by a thread use its table.
+ * fd_array and fds are never moved or freed while the table is alive, so readers do not lock
+ */
 struct fwk_file_table
 {
 	kint32_t max_fdarr;										/*!< size of fd_array */
 	kint32_t max_fds; 										/*!< The maximum number of current file objects = max_fdarr + array number of fds */
 	kint32_t max_fdset;										/*!< The maximum number of current file descriptors */
-	kint32_t ref_fdarr; 									/*!< The number of descriptors that have been assigned on fd_array */
+	kint32_t ref_fdarr; 									/*!< The number of descriptors that have been assigned */
+	kint32_t users;											/*!< threads using this table */
+
+	kuint32_t open_fds[FILE_DESC_BITMAP_NUM];				/*!< bit set: descriptor is allocated */
+	kuint32_t full_fds;										/*!< bit n set: open_fds[n] is full */
 
 	struct fwk_file **fds;
 	struct fwk_file *fd_array[FILE_DESC_NUM_MAX];
 
-	struct mutex_lock sgrt_mutex;
+	struct list_head sgrt_vmas;								/*!< regions mapped by virt_mmap, in order of address */
+	struct mutex_lock sgrt_mutex;							/*!< for writers */
 };
 
 /*!< for open mode */
@@ -149,9 +164,64 @@ struct fwk_file_table
 #define F_GETSIG											11
 #endif
 
+/*!< for virt_mmap */
+#ifndef PROT_READ
+#define PROT_NONE											0x0
+#define PROT_READ											0x1
+#define PROT_WRITE											0x2
+#define PROT_EXEC											0x4
+#endif
+
+#ifndef MAP_SHARED
+#define MAP_SHARED											0x01
+#define MAP_PRIVATE											0x02
+#define MAP_FIXED											0x10
+#endif
+
+/*!< the most segments of virt_readv/virt_writev */
+#define FWK_IOV_MAX											(64)
+
+/*!< for virt_poll, events and revents */
+#ifndef POLLIN
+#define POLLIN												0x0001
+#define POLLPRI												0x0002
+#define POLLOUT												0x0004
+#define POLLERR												0x0008
+#define POLLHUP												0x0010
+#define POLLNVAL											0x0020
+#define POLLRDNORM											0x0040
+#define POLLRDBAND											0x0080
+#define POLLWRNORM											0x0100
+#define POLLWRBAND											0x0200
+#endif
+
+struct fwk_pollfd
+{
+	kint32_t fd;											/*!< ignored if < 0 */
+	kint16_t events;										/*!< requested */
+	kint16_t revents;										/*!< returned */
+};
+
+/*!< for virt_select: file descriptors, and the first sockets */
+#define FWK_FD_SETSIZE										(256)
+#define FWK_FD_BITS											(32)
+
+typedef struct fwk_fd_set
+{
+	kuint32_t fds_bits[FWK_FD_SETSIZE / FWK_FD_BITS];
+
+} srt_fwk_fd_set_t;
+
+#define FWK_FD_ZERO(set)									memset((set), 0, sizeof(struct fwk_fd_set))
+#define FWK_FD_SET(fd, set)									((set)->fds_bits[(fd) / FWK_FD_BITS] |= mrt_bit((fd) % FWK_FD_BITS))
+#define FWK_FD_CLR(fd, set)									((set)->fds_bits[(fd) / FWK_FD_BITS] &= ~mrt_bit((fd) % FWK_FD_BITS))
+#define FWK_FD_ISSET(fd, set)								(!!((set)->fds_bits[(fd) / FWK_FD_BITS] & mrt_bit((fd) % FWK_FD_BITS)))
+
 /*!< The functions */
 /*!< -------------------------------------------------------------- */
 extern kint32_t fwk_file_system_init(void);
+extern void fwk_files_inherit(struct thread *sprt_thread, struct thread *sprt_parent);
+extern kint32_t fwk_files_unshare(void);
 
 /*!< -------------------------------------------------------------- */
 extern kint32_t virt_open(const kchar_t *dev, kuint32_t mode);
@@ -161,40 +231,13 @@ extern kssize_t virt_read(kint32_t fd, void *buf, kusize_t size);
 extern kssize_t virt_ioctl(kint32_t fd, kuint32_t request, ...);
 extern void *virt_mmap(void *addr, kusize_t length, kint32_t prot, kint32_t flags, kint32_t fd, kuint32_t offset);
 extern kint32_t virt_munmap(void *addr, kusize_t length);
-
-/*!< API function */
-/*!
- * @brief   Get avaliable index
- * @param   none
- * @retval  none
- * @note    none
- */
-static inline kint32_t fwk_get_fd_available(struct fwk_file_table *sprt_table)
-{
-	return (sprt_table->ref_fdarr < sprt_table->max_fdarr) ? (sprt_table->ref_fdarr) : (-1);
-}
-
-/*!
- * @brief   fwk_fdtable_get
- * @param   none
- * @retval  none
- * @note    none
- */
-static inline void fwk_fdtable_get(struct fwk_file_table *sprt_table)
-{
-	sprt_table->ref_fdarr = (sprt_table->ref_fdarr < sprt_table->max_fdarr) ? (sprt_table->ref_fdarr + 1) : sprt_table->max_fdarr;
-}
-
-/*!
- * @brief   fwk_fdtable_put
- * @param   none
- * @retval  none
- * @note    none
- */
-static inline void fwk_fdtable_put(struct fwk_file_table *sprt_table)
-{
-	sprt_table->ref_fdarr = (sprt_table->ref_fdarr > DEVICE_MAJOR_BASE) ? (sprt_table->ref_fdarr - 1) : DEVICE_MAJOR_BASE;
-}
+extern kssize_t virt_readv(kint32_t fd, const struct fwk_iovec *sprt_iov, kint32_t iovcnt);
+extern kssize_t virt_writev(kint32_t fd, const struct fwk_iovec *sprt_iov, kint32_t iovcnt);
+extern kssize_t virt_pread(kint32_t fd, void *buf, kusize_t size, kuint32_t offset);
+extern kssize_t virt_pwrite(kint32_t fd, const void *buf, kusize_t size, kuint32_t offset);
+extern kint32_t virt_poll(struct fwk_pollfd *sprt_fds, kuint32_t nfds, kint32_t timeout);
+extern kint32_t virt_select(kint32_t nfds, struct fwk_fd_set *sprt_rfds, struct fwk_fd_set *sprt_wfds,
+							struct fwk_fd_set *sprt_efds, struct time_spec *sprt_tm);
 
 #ifdef __cplusplus
     }
@@ -21,6 +21,7 @@
 #include <platform/fwk_basic.h>
 #include <platform/fwk_inode.h>
 #include <platform/fwk_uaccess.h>
+#include <kernel/wait.h>
 
 /*!< The defines */
 #define RET_INODE_FROM_FILE(file)								((file)->sprt_inode)
@@ -39,6 +40,31 @@ struct fwk_file
 	void *private_data;
 };
 
+/*!< one segment of virt_readv/virt_writev */
+struct fwk_iovec
+{
+	void *iov_base;
+	kusize_t iov_len;
+};
+
+/*!< one wait queue that virt_poll is waiting on */
+struct fwk_poll_entry
+{
+	struct wait_queue_head *sprt_wqh;
+	struct wait_queue sgrt_wq;
+};
+
+/*!< passed to "poll" of file, wait queues are added to it by fwk_poll_wait */
+struct fwk_poll_table
+{
+	struct thread *sprt_task;
+
+	kuint32_t num;
+	kuint32_t max;
+	kbool_t is_overflow;									/*!< entries run out, waiter has to rescan periodically */
+	struct fwk_poll_entry *sprt_entry;
+};
+
 /*!< Device operation API */
 struct fwk_file_oprts
 {
@@ -49,11 +75,19 @@ struct fwk_file_oprts
 	kint32_t (*unlocked_ioctl) (struct fwk_file *, kuint32_t, kuaddr_t);
 	kint32_t (*compat_ioctl) (struct fwk_file *, kuint32_t, kuaddr_t);
 	kint32_t (*mmap) (struct fwk_file *, struct fwk_vm_area *);
+	kuint32_t (*poll) (struct fwk_file *, struct fwk_poll_table *);
+
+	/*!< optional: vectored and positional I/O, return the bytes transferred */
+	kssize_t (*readv) (struct fwk_file *, const struct fwk_iovec *, kuint32_t);
+	kssize_t (*writev) (struct fwk_file *, const struct fwk_iovec *, kuint32_t);
+	kssize_t (*pread) (struct fwk_file *, kbuffer_t *, kssize_t, kuint32_t);
+	kssize_t (*pwrite) (struct fwk_file *, const kbuffer_t *, kssize_t, kuint32_t);
 };
 
 /*!< The functions */
 extern struct fwk_file *fwk_do_filp_open(kchar_t *name, kuint32_t mode);
 extern void fwk_do_filp_close(struct fwk_file *sprt_file);
+extern void fwk_poll_wait(struct fwk_file *sprt_file, struct wait_queue_head *sprt_wqh, struct fwk_poll_table *sprt_pt);
 
 #ifdef __cplusplus
     }
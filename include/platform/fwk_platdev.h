@@ -74,6 +74,8 @@ extern struct fwk_platdev *fwk_platdevice_alloc(const kchar_t *name, kint32_t id
 extern kint32_t fwk_platdevice_add(struct fwk_platdev *sprt_platdev);
 extern kint32_t fwk_register_platdevice(struct fwk_platdev *sprt_platdev);
 extern kint32_t fwk_unregister_platdevice(struct fwk_platdev *sprt_platdev);
+extern void fwk_bus_device_lock(void);
+extern void fwk_bus_device_unlock(void);
 
 /*!< API functions */
 /*!
@@ -46,6 +46,8 @@ extern kint32_t fwk_driver_register(struct fwk_driver *sprt_driver);
 extern kint32_t fwk_driver_unregister(struct fwk_driver *sprt_driver);
 extern kint32_t fwk_register_platdriver(struct fwk_platdrv *sprt_platdrv);
 extern kint32_t fwk_unregister_platdriver(struct fwk_platdrv *sprt_platdrv);
+extern void fwk_bus_driver_lock(void);
+extern void fwk_bus_driver_unlock(void);
 
 /*!< API function */
 /*!
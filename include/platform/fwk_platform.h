@@ -57,6 +57,11 @@ typedef struct fwk_device
 	struct fwk_pinctrl_dev_info *sprt_pctlinfo;
 	void *privData;
 
+	/*!< deferred probe: the device is on the deferred list while sgrt_deferred is not empty */
+	struct list_head sgrt_deferred;
+	struct fwk_driver *sprt_defer_driver;
+	const kchar_t *defer_reason;
+
 } srt_fwk_device_t;
 
 typedef struct fwk_driver
@@ -123,6 +128,11 @@ extern kint32_t fwk_device_driver_probe(struct fwk_device *sprt_dev);
 extern kint32_t fwk_device_driver_remove(struct fwk_device *sprt_dev);
 extern kint32_t fwk_device_driver_match(struct fwk_device *sprt_dev, struct fwk_bus_type *sprt_bus_type, void *ptr_data);
 
+extern kint32_t fwk_device_defer_probe(struct fwk_device *sprt_dev, const kchar_t *reason);
+extern void fwk_deferred_probe_del(struct fwk_device *sprt_dev);
+extern void fwk_deferred_probe_trigger(void);
+extern void fwk_deferred_probe_foreach(void (*func)(struct fwk_device *sprt_dev, void *data), void *data);
+
 extern kint32_t fwk_device_initial(struct fwk_device *sprt_dev);
 extern struct fwk_device *fwk_device_create(kuint32_t type, kuint32_t devNum, kchar_t *fmt, ...);
 extern kint32_t fwk_device_destroy(struct fwk_device *sprt_dev);
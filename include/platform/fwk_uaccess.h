@@ -21,16 +21,29 @@
 #include <platform/fwk_basic.h>
 
 /*!< The defines */
+/*!< memory type of mapped region */
+enum __ERT_FWK_VM_TYPE
+{
+    NR_FWK_VM_NORMAL = 0,                           /*!< cacheable */
+    NR_FWK_VM_WC,                                   /*!< non-cacheable, writes are buffered and merged: framebuffer */
+    NR_FWK_VM_UNCACHED,                             /*!< strongly ordered: DMA descriptors and rings */
+    NR_FWK_VM_DEVICE,                               /*!< device registers */
+
+    NR_FWK_VM_TYPE_MAX,
+};
+
 struct fwk_vm_area
 {
     kuaddr_t virt_addr;
     kusize_t size;
     kuint32_t offset;
+    kuint32_t mem_type;                             /*!< set by "mmap" of driver, refer to "__ERT_FWK_VM_TYPE" */
 };
 
 /*!< The functions */
 extern kusize_t fwk_copy_from_user(void *ptr_dst, const void *ptr_user, kusize_t size);
 extern kusize_t fwk_copy_to_user(void *ptr_user, void *ptr_Src, kusize_t size);
+extern kint32_t fwk_vm_set_memtype(kuaddr_t start, kusize_t size, kuint32_t mem_type);
 
 #ifdef __cplusplus
     }
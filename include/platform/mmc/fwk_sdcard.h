@@ -806,6 +806,7 @@ enum __ERT_SDCARD_SW_VOLTAGE
 
 /*!< The functions */
 extern void *host_sdmmc_card_initial(struct fwk_sdcard *sprt_card);
+extern void host_sdmmc_card_exit(struct fwk_sdcard_host *sprt_host);
 
 extern void *fwk_sdcard_allocate_device(void *sprt_sd);
 extern void fwk_sdcard_free_device(struct fwk_sdcard *sprt_card);
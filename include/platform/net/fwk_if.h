@@ -95,6 +95,8 @@ struct fwk_network_object
     struct radix_link sgrt_radix;
 };
 
+struct fwk_poll_table;
+
 /*!< network node: operations */
 struct fwk_network_if_ops
 {
@@ -109,6 +111,7 @@ struct fwk_network_if_ops
                         kint32_t flags, const struct fwk_sockaddr *sprt_dest, fwk_socklen_t addrlen);
     kssize_t (*recvfrom)(struct fwk_network_com *sprt_socket, void *buf, size_t len, 
                         kint32_t flags, struct fwk_sockaddr *sprt_src, fwk_socklen_t *addrlen);
+    kuint32_t (*poll)(struct fwk_network_com *sprt_socket, struct fwk_poll_table *sprt_pt);
 
     kint32_t (*link_up)(struct fwk_network_if *sprt_if);
     kint32_t (*link_down)(struct fwk_network_if *sprt_if);
@@ -40,6 +40,7 @@ extern kssize_t lwip_udp_raw_recvfrom(struct udp_pcb *sprt_upcb, void *buf,
 extern kssize_t lwip_udp_raw_sendto(struct udp_pcb *sprt_upcb, const ip_addr_t *sprt_dest, 
                                         u16_t dest_port, const void *buf, kusize_t size);
 extern struct udp_pcb *lwip_udp_raw_bind(const ip_addr_t *sprt_ip, u16_t port);
+extern kuint32_t lwip_udp_raw_poll_events(struct udp_pcb *sprt_upcb, struct fwk_poll_table *sprt_pt);
 
 #ifdef __cplusplus
     }
@@ -25,6 +25,30 @@
 /*!< The defines */
 typedef kint32_t netdev_tx_t;
 struct fwk_sk_buff;
+struct fwk_skb_cache;
+
+#define NETDEV_RXQ_RING_SIZE                                        (256)
+
+/*!< 
+ * lock-free single-producer/single-consumer ring
+ * the producer (driver, interrupt context) only writes "head", the consumer (rx thread) only writes "tail",
+ * so none of them needs a lock. size must be power of 2
+ */
+struct fwk_skb_ring
+{
+    volatile kuint32_t head;                                            /*!< next slot to be produced */
+    volatile kuint32_t tail;                                            /*!< next slot to be consumed */
+    kuint32_t mask;                                                     /*!< = size - 1 */
+
+    struct fwk_sk_buff **sprt_slots;
+};
+
+struct fwk_netdev_queue_stats
+{
+    kuint64_t packets;
+    kuint64_t bytes;
+    kuint64_t dropped;
+};
 
 struct fwk_netdev_stats
 {
@@ -58,10 +82,23 @@ struct fwk_netdev_queue
     struct fwk_sk_buff *sprt_skb;
 
     struct fwk_net_device *sprt_ndev;								/*!< destination/source network device */
+    kuint32_t queue_index;
     kuint64_t tx_maxrate;
     kuint64_t trans_timeout;										/*!< statistics on the number of times the queue times out */
     kuint64_t trans_start;											/*!< The time of the last sent */
     kuint64_t state;												/*!< state */
+
+    struct fwk_netdev_queue_stats sgrt_stats;                       /*!< tx statistics of this queue */
+};
+
+struct fwk_netdev_rx_queue
+{
+    struct fwk_skb_ring sgrt_ring;                                  /*!< driver (producer) ---> rx thread (consumer) */
+
+    struct fwk_net_device *sprt_ndev;
+    kuint32_t queue_index;
+
+    struct fwk_netdev_queue_stats sgrt_stats;                       /*!< rx statistics of this queue */
 };
 
 enum __ERT_FWK_NETDEVICE_PRIV
@@ -104,6 +141,11 @@ struct fwk_net_device
     kuint32_t real_num_tx_queues;									/*!< number of TX queues currently active in device */
     kuint64_t tx_queue_len;											/*!< max frame per queue allowned */
 
+    struct fwk_skb_cache *sprt_skb_cache;                           /*!< skb recycle cache, see fwk_netdev_alloc_skb() */
+    struct fwk_netdev_rx_queue *sprt_rx;                            /*!< packet receive queue (one ring per queue) */
+    kuint32_t num_rx_queues;										/*!< number of RX queues allocated at alloc_netdev_mq() time */
+    kuint32_t real_num_rx_queues;									/*!< number of RX queues currently active in device */
+
     struct fwk_device sgrt_dev;
 //	struct fwk_phy_device *sprt_phydev;
     void *private_data;
@@ -124,6 +166,7 @@ struct fwk_netdev_ops
     kint32_t (*ndo_add_slave) (struct fwk_net_device *sprt_ndev, struct fwk_net_device *sprt_slave_dev);
     kint32_t (*ndo_del_slave) (struct fwk_net_device *sprt_ndev, struct fwk_net_device *sprt_slave_dev);
     kint32_t (*ndo_set_tx_maxrate) (struct fwk_net_device *sprt_ndev, kint32_t queue_index, kuint32_t maxrate);
+    kuint16_t (*ndo_select_queue) (struct fwk_net_device *sprt_ndev, struct fwk_sk_buff *sprt_skb);
 };
 
 struct fwk_ethtool_ops
@@ -139,6 +182,9 @@ extern void fwk_free_netdev(struct fwk_net_device *sprt_ndev);
 extern struct fwk_net_device *fwk_ifname_to_ndev(const kchar_t *name);
 extern kint32_t fwk_register_netdevice(struct fwk_net_device *sprt_ndev);
 extern kint32_t fwk_unregister_netdevice(struct fwk_net_device *sprt_ndev);
+extern void fwk_netdevice_lock(void);
+extern void fwk_netdevice_unlock(void);
+extern struct fwk_net_device *fwk_next_netdevice(struct fwk_net_device *sprt_ndev);
 
 #define fwk_alloc_netdev(sizeof_priv, name, setup)	\
                 fwk_alloc_netdev_mq(sizeof_priv, name, setup, 1)
@@ -39,6 +39,7 @@ extern kuint16_t fwk_ip_transport_csum(struct fwk_ip_hdr *sprt_iphdr, kuint8_t *
 extern kuint16_t fwk_ip_slow_csum(struct fwk_ip_hdr *sprt_iphdr, kuint16_t offset);
 
 extern struct fwk_sk_buff_head *fwk_netif_rxq_get(void);
+extern kuint32_t fwk_netif_flow_hash(struct fwk_sk_buff *sprt_skb);
 
 extern kint32_t fwk_netif_open(const kchar_t *name);
 extern kint32_t fwk_netif_close(const kchar_t *name);
@@ -34,7 +34,8 @@ struct fwk_sk_buff
 
     struct fwk_net_device *sprt_ndev;                                   /*!< net_device */
 
-    kuint16_t queue_mapping;
+    kuint16_t queue_mapping;                                            /*!< rx: recorded queue + 1 (0 = not recorded); tx: selected queue */
+    kuint32_t hash;                                                     /*!< flow hash (0 = not calculated yet) */
 
     /*!< 
      * represents the sum of the length of the data area (tail - data) and the length of the data area of the shard structure. 
@@ -65,6 +66,37 @@ struct fwk_sk_buff
      */
     kuint32_t truesize;                           						
     srt_atomic_t users;                              					/*!< The number of times skb has been referenced by clones, which is used for memory requests and cloning */
+
+    /*!< These elements are set only once by skb cache, see fwk_skb_cache_create() for details. */
+    struct fwk_skb_cache *sprt_cache;                                   /*!< owner cache (null: allocated from GFP_SOCK) */
+    kuint32_t cache_class;                                              /*!< refer to "__ERT_SKB_CACHE_CLASS" */
+};
+
+/*!< skb recycle cache (per net device) */
+enum __ERT_SKB_CACHE_CLASS
+{
+    NR_SKB_CACHE_SMALL = 0,                                             /*!< protocol headers only (arp, tcp ack, icmp, ...) */
+    NR_SKB_CACHE_MTU,                                                   /*!< full frame (mtu + hardware header) */
+
+    NR_SKB_CACHE_MAX,
+};
+
+#define SKB_CACHE_SMALL_SIZE                                (256)
+
+struct fwk_skb_cache_class
+{
+    void *free_list;                                                    /*!< lock-free stack, linked by sk_buff::sprt_next */
+    kuint32_t data_size;                                                /*!< data area of per skb */
+    kuint32_t count;                                                    /*!< number of skbs pre-allocated */
+
+    srt_atomic_t hits;                                                  /*!< allocated from free_list */
+    srt_atomic_t misses;                                                /*!< free_list is empty (or size is too large), fall back to GFP_SOCK */
+};
+
+struct fwk_skb_cache
+{
+    struct fwk_skb_cache_class sgrt_class[NR_SKB_CACHE_MAX];
+    void *buffer;                                                       /*!< memory of all pre-allocated skbs */
 };
 
 struct fwk_sk_buff_head
@@ -87,6 +119,12 @@ extern struct fwk_sk_buff *fwk_alloc_skb(kuint32_t data_size, nrt_gfp_t flags);
 extern void kfree_skb(struct fwk_sk_buff *sprt_skb);
 extern kint32_t fwk_skb_enqueue(struct fwk_sk_buff_head *sprt_head, struct fwk_sk_buff *sprt_skb);
 extern struct fwk_sk_buff *fwk_skb_dequeue(struct fwk_sk_buff_head *sprt_head);
+extern kint32_t fwk_skb_cache_create(struct fwk_net_device *sprt_ndev, kuint32_t small_count, kuint32_t mtu_count);
+extern void fwk_skb_cache_destroy(struct fwk_net_device *sprt_ndev);
+extern struct fwk_sk_buff *fwk_netdev_alloc_skb(struct fwk_net_device *sprt_ndev, kuint32_t data_size, nrt_gfp_t flags);
+extern kbool_t fwk_skb_recycle(struct fwk_sk_buff *sprt_skb);
+extern kint32_t fwk_skb_ring_init(struct fwk_skb_ring *sprt_ring, kuint32_t size, nrt_gfp_t flags);
+extern void fwk_skb_ring_destroy(struct fwk_skb_ring *sprt_ring);
 
 /*!< API functions */
 /*!
@@ -363,6 +401,115 @@ static inline void fwk_skb_unlink(struct fwk_sk_buff_head *sprt_head, struct fwk
     sprt_head->qlen--;
 }
 
+/*!< ---------------------------------------------------------------------------- */
+/*!
+ * @brief   get the number of skbs in ring
+ * @param   sprt_ring
+ * @retval  count
+ * @note    none
+ */
+static inline kuint32_t fwk_skb_ring_count(struct fwk_skb_ring *sprt_ring)
+{
+    return sprt_ring->head - sprt_ring->tail;
+}
+
+/*!
+ * @brief   check if ring is empty
+ * @param   sprt_ring
+ * @retval  empty(true) / false
+ * @note    none
+ */
+static inline kbool_t fwk_skb_ring_empty(struct fwk_skb_ring *sprt_ring)
+{
+    return (sprt_ring->head == sprt_ring->tail);
+}
+
+/*!
+ * @brief   check if ring is full
+ * @param   sprt_ring
+ * @retval  full(true) / false
+ * @note    none
+ */
+static inline kbool_t fwk_skb_ring_full(struct fwk_skb_ring *sprt_ring)
+{
+    return (fwk_skb_ring_count(sprt_ring) > sprt_ring->mask);
+}
+
+/*!
+ * @brief   put skb to ring (producer only)
+ * @param   sprt_ring, sprt_skb
+ * @retval  errno
+ * @note    slot must be visible before head is published
+ */
+static inline kint32_t fwk_skb_ring_produce(struct fwk_skb_ring *sprt_ring, struct fwk_sk_buff *sprt_skb)
+{
+    kuint32_t head = sprt_ring->head;
+
+    if ((head - sprt_ring->tail) > sprt_ring->mask)
+        return -ER_FULL;
+
+    sprt_ring->sprt_slots[head & sprt_ring->mask] = sprt_skb;
+    mrt_dmb();
+    sprt_ring->head = head + 1;
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   get skb from ring (consumer only)
+ * @param   sprt_ring
+ * @retval  skb (null if empty)
+ * @note    slot must be read before tail is published
+ */
+static inline struct fwk_sk_buff *fwk_skb_ring_consume(struct fwk_skb_ring *sprt_ring)
+{
+    struct fwk_sk_buff *sprt_skb;
+    kuint32_t tail = sprt_ring->tail;
+
+    if (tail == sprt_ring->head)
+        return mrt_nullptr;
+
+    mrt_dmb();
+    sprt_skb = sprt_ring->sprt_slots[tail & sprt_ring->mask];
+    mrt_dmb();
+    sprt_ring->tail = tail + 1;
+
+    return sprt_skb;
+}
+
+/*!
+ * @brief   record rx queue which skb came from
+ * @param   sprt_skb, rx_queue
+ * @retval  none
+ * @note    called by driver before fwk_netif_rx()
+ */
+static inline void fwk_skb_record_rx_queue(struct fwk_sk_buff *sprt_skb, kuint16_t rx_queue)
+{
+    sprt_skb->queue_mapping = rx_queue + 1;
+}
+
+/*!
+ * @brief   check if rx queue is recorded
+ * @param   sprt_skb
+ * @retval  recorded(true) / false
+ * @note    none
+ */
+static inline kbool_t fwk_skb_rx_queue_recorded(struct fwk_sk_buff *sprt_skb)
+{
+    return (sprt_skb->queue_mapping != 0);
+}
+
+/*!
+ * @brief   get rx queue recorded
+ * @param   sprt_skb
+ * @retval  rx queue
+ * @note    none
+ */
+static inline kuint16_t fwk_skb_get_rx_queue(struct fwk_sk_buff *sprt_skb)
+{
+    return sprt_skb->queue_mapping - 1;
+}
+
 #ifdef __cplusplus
     }
 #endif
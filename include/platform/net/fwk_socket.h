@@ -104,6 +104,7 @@ extern kint32_t network_bind(kint32_t sockfd, const struct fwk_sockaddr *addr, f
 extern kint32_t network_accept(kint32_t sockfd, struct fwk_sockaddr *addr, fwk_socklen_t *addrlen);
 extern kssize_t network_sendto(kint32_t sockfd, const void *buf, kssize_t len, 
                             kint32_t flags, const struct fwk_sockaddr *sprt_dest, fwk_socklen_t addrlen);
+extern kuint32_t network_poll(kint32_t sockfd, struct fwk_poll_table *sprt_pt);
 extern kssize_t network_recvfrom(kint32_t sockfd, void *buf, size_t len, 
                             kint32_t flags, struct fwk_sockaddr *sprt_src, fwk_socklen_t *addrlen);
 
@@ -0,0 +1,111 @@
+/*
+ * Display 2D Blit Engine
+ *
+ * File Name:   fwk_blit.h
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+#ifndef __FWK_BLIT_H_
+#define __FWK_BLIT_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+
+/*!< The defines */
+/*!< pixel formats, little endian: RGB888 is stored as B, G, R bytes (bmp order) */
+enum __ERT_FWK_BLIT_FORMAT
+{
+    NR_FWK_BLIT_RGB565 = 0,
+    NR_FWK_BLIT_RGB888,
+    NR_FWK_BLIT_ARGB8888,
+
+    NR_FWK_BLIT_FORMAT_MAX,
+};
+
+#define FWK_BLIT_ALPHA_OPAQUE                   (0xff)
+
+/*!< a rectangular pixel area in memory */
+typedef struct fwk_blit_surface
+{
+    void *buffer;                               /*!< address of row 0 */
+    kuint32_t width;
+    kuint32_t height;
+    kint32_t pitch;                             /*!< bytes from one row to the next, negative if bottom-up */
+    kuint32_t format;
+
+} srt_fwk_blit_surface_t;
+
+/*!< span kernels, count: unit: pixel */
+typedef void (*fwk_blit_fill_t)(void *dst, kuint32_t color, kuint32_t count);
+typedef void (*fwk_blit_copy_t)(void *dst, const void *src, kuint32_t count);
+typedef void (*fwk_blit_blend_t)(void *dst, const void *src, kuint32_t count, kuint32_t alpha);
+
+/*!< The functions */
+extern kint32_t fwk_blit_format_by_bpp(kuint32_t bpp);
+extern kuint32_t fwk_blit_pack_color(kuint32_t format, kuint32_t argb);
+extern fwk_blit_fill_t fwk_blit_get_fill(kuint32_t format);
+extern fwk_blit_copy_t fwk_blit_get_copy(kuint32_t src_format, kuint32_t dst_format);
+extern fwk_blit_blend_t fwk_blit_get_blend(kuint32_t src_format, kuint32_t dst_format);
+
+extern kint32_t fwk_blit_fill(struct fwk_blit_surface *sprt_dst, kuint32_t x, kuint32_t y,
+                            kuint32_t width, kuint32_t height, kuint32_t color);
+extern kint32_t fwk_blit_copy(struct fwk_blit_surface *sprt_dst, kuint32_t dx, kuint32_t dy,
+                            struct fwk_blit_surface *sprt_src, kuint32_t sx, kuint32_t sy, kuint32_t width, kuint32_t height);
+extern kint32_t fwk_blit_blend(struct fwk_blit_surface *sprt_dst, kuint32_t dx, kuint32_t dy,
+                            struct fwk_blit_surface *sprt_src, kuint32_t sx, kuint32_t sy,
+                            kuint32_t width, kuint32_t height, kuint32_t alpha);
+
+/*!< API functions */
+/*!
+ * @brief   bytes of one pixel
+ * @param   format
+ * @retval  bytes
+ * @note    none
+ */
+static inline kuint32_t fwk_blit_bytes_per_pixel(kuint32_t format)
+{
+    return (format == NR_FWK_BLIT_RGB565) ? 2 : ((format == NR_FWK_BLIT_RGB888) ? 3 : 4);
+}
+
+/*!
+ * @brief   address of pixel (x, y)
+ * @param   sprt_surf, x, y
+ * @retval  address
+ * @note    no range check
+ */
+static inline void *fwk_blit_pixel_addr(struct fwk_blit_surface *sprt_surf, kuint32_t x, kuint32_t y)
+{
+    return (kuint8_t *)sprt_surf->buffer + (kint32_t)y * sprt_surf->pitch +
+                        (kint32_t)(x * fwk_blit_bytes_per_pixel(sprt_surf->format));
+}
+
+/*!
+ * @brief   describe a packed buffer as surface
+ * @param   sprt_surf, buffer, width, height, format
+ * @retval  none
+ * @note    rows are adjacent, top-down
+ */
+static inline void fwk_blit_surface_init(struct fwk_blit_surface *sprt_surf, void *buffer,
+                                        kuint32_t width, kuint32_t height, kuint32_t format)
+{
+    sprt_surf->buffer = buffer;
+    sprt_surf->width = width;
+    sprt_surf->height = height;
+    sprt_surf->pitch = (kint32_t)(width * fwk_blit_bytes_per_pixel(format));
+    sprt_surf->format = format;
+}
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /*!< __FWK_BLIT_H_ */
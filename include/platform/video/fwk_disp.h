@@ -24,10 +24,28 @@
 
 #include "fwk_font.h"
 #include "fwk_rgbmap.h"
+#include "fwk_blit.h"
 
 /*!< The globals */
 
 /*!< The defines */
+/*!< damaged areas recorded between two frame sync; beyond this, they are folded into one */
+#ifdef CONFIG_DISP_DAMAGE_RECTS
+#define FWK_DISP_DAMAGE_MAX                     (CONFIG_DISP_DAMAGE_RECTS)
+#else
+#define FWK_DISP_DAMAGE_MAX                     (8)
+#endif
+
+/*!< area: [x_start, x_end) * [y_start, y_end) */
+typedef struct fwk_disp_rect
+{
+    kuint32_t x_start;
+    kuint32_t y_start;
+    kuint32_t x_end;
+    kuint32_t y_end;
+
+} srt_fwk_disp_rect_t;
+
 typedef struct fwk_disp_info
 {
     void *buffer;
@@ -39,6 +57,11 @@ typedef struct fwk_disp_info
 
     struct mutex_lock sgrt_lock;
 
+    /*!< disjoint areas drawn since last frame sync */
+    struct fwk_disp_rect sgrt_damage[FWK_DISP_DAMAGE_MAX];
+    kuint32_t num_damage;
+    struct spin_lock sgrt_damage_lock;
+
 } srt_fwk_disp_info_t;
 
 typedef struct fwk_disp_ctrl
@@ -99,6 +122,9 @@ extern void fwk_display_fill_rectangle(struct fwk_disp_info *sprt_disp, kuint32_
                             kuint32_t x_end, kuint32_t y_end, kuint32_t data);
 extern void fwk_display_clear(struct fwk_disp_info *sprt_disp, kuint32_t data);
 extern kusize_t fwk_display_word(struct fwk_disp_ctrl *sprt_dctrl, const kchar_t *fmt, ...);
+extern void fwk_display_add_damage(struct fwk_disp_info *sprt_disp, kuint32_t x_start, kuint32_t y_start, 
+                            kuint32_t x_end, kuint32_t y_end);
+extern kusize_t fwk_display_frame_sync(struct fwk_disp_info *sprt_disp, kusize_t size);
 
 extern void fwk_display_ctrl_init(struct fwk_disp_info *sprt_disp, void *fbuffer, 
                           void *fbuffer2, kusize_t size, kuint32_t width, kuint32_t height, kuint32_t bpp);
@@ -205,16 +231,35 @@ void fwk_display_frame_flush(struct fwk_disp_info *sprt_disp, kusize_t size)
 }
 
 /*!
- * @brief  copy backup to deactive screen
+ * @brief  describe framebuffer as blit surface
+ * @param  sprt_disp, sprt_surf
+ * @retval errno
+ * @note   the active buffer is used
+ */
+static inline
+kint32_t fwk_display_surface(struct fwk_disp_info *sprt_disp, struct fwk_blit_surface *sprt_surf)
+{
+    kint32_t format;
+
+    format = fwk_blit_format_by_bpp(mrt_fwk_disp_bpp_get(sprt_disp->bpp));
+    if (format < 0)
+        return format;
+
+    fwk_blit_surface_init(sprt_surf, sprt_disp->buffer, sprt_disp->width, sprt_disp->height, format);
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief  mark whole screen damaged
  * @param  sprt_disp
  * @retval none
  * @note   none
  */
 static inline
-void fwk_display_frame_sync(struct fwk_disp_info *sprt_disp, kusize_t size)
+void fwk_display_damage_all(struct fwk_disp_info *sprt_disp)
 {
-    if (sprt_disp->buffer_bak)
-        memcpy(sprt_disp->buffer_bak, sprt_disp->buffer, size);
+    fwk_display_add_damage(sprt_disp, 0, 0, sprt_disp->width, sprt_disp->height);
 }
 
 #ifdef __cplusplus
@@ -100,11 +100,25 @@ struct fwk_fb_var_screen_info
     kuint32_t vsync_len;								/*!< The pulse width (unit: PixClock) of the V-sync signal vsync, i.e. VPW */
 };
 
+/*!< page flip statistics, unit of latency: ms */
+struct fwk_fb_flip_stats
+{
+    kuint32_t flips;									/*!< frames put on screen */
+    kuint32_t drops;									/*!< frames replaced by a newer one before shown */
+    kuint32_t latency_last;								/*!< from pan request to the frame latched */
+    kuint32_t latency_max;
+    kuint32_t latency_sum;								/*!< latency_sum / flips ===> average */
+};
+
 enum __ERT_FB_IOCTL_CMD
 {
     NR_FB_IOGET_VARINFO	= FWK_IOR('F', 0, struct fwk_fb_var_screen_info),
     NR_FB_IOSET_VARINFO = FWK_IOW('F', 1, struct fwk_fb_var_screen_info),
     NR_FB_IOGET_FIXINFO = FWK_IOR('F', 2, struct fwk_fb_fix_screen_info),
+    NR_FB_IOPAN_DISPLAY = FWK_IOW('F', 3, struct fwk_fb_var_screen_info),		/*!< only xoffset/yoffset are used */
+    NR_FB_IOWAIT_VSYNC  = FWK_IOW('F', 4, kuint32_t),						/*!< arg: timeout, unit: ms (0: wait forever) */
+    NR_FB_IOGET_FREEBUF = FWK_IOR('F', 5, kuint32_t),						/*!< arg: yoffset of a buffer free to draw */
+    NR_FB_IOGET_FLIPSTAT = FWK_IOR('F', 6, struct fwk_fb_flip_stats),
 };
 
 typedef struct fwk_fb_info
@@ -135,6 +149,14 @@ struct fwk_fb_oprts
     kssize_t (*fb_write) (struct fwk_fb_info *sprt_info, const kbuffer_t *ptr_buf, kusize_t count, kuint8_t *ptr_offset);
     kint32_t (*fb_ioctl) (struct fwk_fb_info *sprt_info, kuint32_t cmd, kuaddr_t arg);
     kint32_t (*fb_mmap) (struct fwk_fb_info *sprt_info, struct fwk_vm_area *vma);
+
+    /*!< show the area of virtual screen at (xoffset, yoffset), latched at the next frame */
+    kint32_t (*fb_pan_display) (struct fwk_fb_info *sprt_info, struct fwk_fb_var_screen_info *sprt_var);
+    /*!< wait for the next vertical blanking, timeout: unit: ms */
+    kint32_t (*fb_wait_vsync) (struct fwk_fb_info *sprt_info, kuint32_t timeout);
+    /*!< get a buffer that is neither on screen nor waiting for it, never blocks */
+    kint32_t (*fb_get_free_buffer) (struct fwk_fb_info *sprt_info, kuint32_t *yoffset);
+    kint32_t (*fb_get_flip_stats) (struct fwk_fb_info *sprt_info, struct fwk_fb_flip_stats *sprt_stats);
 };
 
 /*!< The functions */
@@ -149,6 +171,9 @@ extern kint32_t fwk_register_framebuffer(struct fwk_fb_info *sprt_fb_info);
 extern void fwk_unregister_framebuffer(struct fwk_fb_info *sprt_fb_info);
 extern struct fwk_fb_info *fwk_get_fb_info(kuint32_t idx);
 extern struct fwk_fb_info *fwk_file_fb_info(struct fwk_file *sprt_file);
+extern kint32_t fwk_fb_pan_display(struct fwk_fb_info *sprt_info, struct fwk_fb_var_screen_info *sprt_var);
+extern kint32_t fwk_fb_wait_vsync(struct fwk_fb_info *sprt_info, kuint32_t timeout);
+extern kint32_t fwk_fb_get_free_buffer(struct fwk_fb_info *sprt_info, kuint32_t *yoffset);
 
 /*!< API functions */
 /*!
@@ -0,0 +1,87 @@
+/*
+ * Display Glyph Cache
+ *
+ * File Name:   fwk_glyph.h
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+#ifndef __FWK_GLYPH_H_
+#define __FWK_GLYPH_H_
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+
+#include "fwk_blit.h"
+
+/*!< The defines */
+/*!< number of rendered glyphs kept */
+#ifdef CONFIG_DISP_GLYPH_CACHE
+#define FWK_GLYPH_CACHE_NUM                     (CONFIG_DISP_GLYPH_CACHE)
+#else
+#define FWK_GLYPH_CACHE_NUM                     (128)
+#endif
+
+#define FWK_GLYPH_HASH_SIZE                     (32)
+
+/*!< what a rendered glyph depends on */
+typedef struct fwk_glyph_key
+{
+    const void *font;                           /*!< font library */
+    kuint32_t code;                             /*!< ascii or area/bit code */
+    kuint32_t size;                             /*!< height, unit: pixel */
+    kuint32_t width;                            /*!< unit: pixel */
+    kuint32_t color;                            /*!< pixel value of format */
+    kuint32_t format;                           /*!< refer to "__ERT_FWK_BLIT_FORMAT" */
+
+} srt_fwk_glyph_key_t;
+
+/*!< one run of set dots in a row */
+typedef struct fwk_glyph_span
+{
+    kuint16_t y;
+    kuint16_t x;
+    kuint16_t lenth;
+
+} srt_fwk_glyph_span_t;
+
+typedef struct fwk_glyph
+{
+    struct fwk_glyph_key sgrt_key;
+
+    void *pixels;                               /*!< one row of color, already in format */
+    struct fwk_glyph_span *sprt_spans;          /*!< mask of dot matrix */
+    kuint32_t num_spans;
+
+    struct list_head sgrt_lru;
+    struct list_head sgrt_hash;
+
+} srt_fwk_glyph_t;
+
+typedef struct fwk_glyph_stats
+{
+    kuint32_t hits;
+    kuint32_t misses;
+    kuint32_t used;
+
+} srt_fwk_glyph_stats_t;
+
+/*!< The functions */
+extern kint32_t fwk_glyph_draw(struct fwk_blit_surface *sprt_surf, kuint32_t x, kuint32_t y,
+                            struct fwk_glyph_key *sprt_key, const kuint8_t *dmatx);
+extern void fwk_glyph_cache_drop(void);
+extern void fwk_glyph_cache_stats(struct fwk_glyph_stats *sprt_stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif /*!< __FWK_GLYPH_H_ */
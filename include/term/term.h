@@ -63,6 +63,10 @@ extern void term_cmd_add_ts(void);
 extern void term_cmd_add_ttc(void);
 extern void term_cmd_add_user(void);
 extern void term_cmd_add_kill(void);
+extern void term_cmd_add_blkstat(void);
+extern void term_cmd_add_bootprof(void);
+extern void term_cmd_add_deferred(void);
+extern void term_cmd_add_skbstat(void);
 
 #ifdef __cplusplus
     }
@@ -20,6 +20,7 @@
 #include <common/time.h>
 #include <boot/implicit_call.h>
 #include <boot/board_init.h>
+#include <boot/boot_prof.h>
 #include <platform/of/fwk_of.h>
 #include <platform/of/fwk_of_device.h>
 #include <platform/fwk_fcntl.h>
@@ -95,17 +96,24 @@ void setup_machine(struct tag_params *sprt_params)
  */
 void start_kernel(void)
 {
+    kint32_t slot, retval;
+
     /*!< disable interrupt */
     mrt_disable_cpu_irq();
     sprt_tag_params = mrt_tag_params_get();
 
+    /*!< time of boot events is counted from here */
+    boot_prof_init();
+
     /*!< initial memory pool */
     fwk_mempool_initial();
     iostream_init();
     print_info("\nstart kernel ...... \n");
 
     /*!< populate params from bootloader */
+    slot = boot_prof_begin(NR_BOOT_PROF_STAGE, setup_machine, mrt_nullptr, mrt_nullptr, 0);
     setup_machine(sprt_tag_params);
+    boot_prof_end(slot, ER_NORMAL);
 
     /*!< board initcall */
     if (run_machine_initcall())
@@ -122,13 +130,19 @@ void start_kernel(void)
         goto fail;
 
     /*!< populate device node after initializing hardware */
-    if (fwk_of_platform_populate_init())
+    slot = boot_prof_begin(NR_BOOT_PROF_STAGE, fwk_of_platform_populate_init, mrt_nullptr, mrt_nullptr, 0);
+    retval = fwk_of_platform_populate_init();
+    boot_prof_end(slot, retval);
+    if (retval)
         goto fail;
 
     /* platform initcall */
     if (run_platform_initcall())
         goto fail;
 
+    /*!< providers registered without a driver do not retry deferred probes by themselves */
+    fwk_deferred_probe_trigger();
+
     /*!< enable interrupt */
     mrt_enable_cpu_irq();
 
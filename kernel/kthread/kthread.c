@@ -17,6 +17,7 @@
 #include <kernel/sleep.h>
 #include <kernel/instance.h>
 #include <kernel/spinlock.h>
+#include <boot/implicit_call.h>
 
 /*!< The defines */
 #define KERL_THREAD_STACK_SIZE                          THREAD_STACK_HALF(1)   /*!< 1/2 page (2 kbytes) */
@@ -112,6 +113,7 @@ static void *kthread_entry(void *args)
     /*!< 2. random tid thread */
     term_init();                            /*!< create term task */
     kworker_init();                         /*!< create kworker task */
+    dync_initcall_async_start();            /*!< create boot workers for async initcalls */
 
     print_info("%s is enter, which tid is: %d\n", __FUNCTION__, tid);
     mrt_preempt_enable();
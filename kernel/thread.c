@@ -13,6 +13,7 @@
 /*!< The includes */
 #include <kernel/thread.h>
 #include <kernel/sched.h>
+#include <platform/fwk_fcntl.h>
 
 /*!< API functions */
 /*!
@@ -88,6 +89,9 @@ static kint32_t __thread_create(tid_t *ptr_id, kint32_t base, struct thread_attr
     if (retval < 0)
         goto fail4;
 
+    /*!< share descriptor table with creator (preemption is disabled, it can not run yet) */
+    fwk_files_inherit(sprt_thread, mrt_current);
+
     if (ptr_id)
         *ptr_id = tid;
     
@@ -3524,6 +3524,50 @@ FRESULT f_open (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Extend a Direct Transfer over the Following Contiguous Clusters        */
+/*-----------------------------------------------------------------------*/
+
+static
+UINT extend_contig (	/* Number of sectors that can be transferred in one disk access */
+	FIL* fp,		/* Pointer to the file object, fp->clust is moved to the last cluster used */
+	UINT csect,		/* Sector offset in the current cluster */
+	UINT cc,		/* Number of sectors requested */
+	int stretch		/* 0: follow the chain, 1: stretch the chain if needed (write) */
+)
+{
+	FATFS *fs = fp->obj.fs;
+	DWORD clst, nclst;
+	UINT ncc;
+
+
+	clst = fp->clust;
+	ncc = fs->csize - csect;			/* Sectors left in the current cluster */
+	while (ncc < cc) {
+#if _USE_FASTSEEK
+		if (fp->cltbl) {
+			nclst = clmt_clust(fp, fp->fptr + (FSIZE_t)ncc * SS(fs));	/* Get cluster# from the CLMT */
+		} else
+#endif
+		{
+#if !_FS_READONLY
+			nclst = stretch ? create_chain(&fp->obj, clst) : get_fat(&fp->obj, clst);
+#else
+			nclst = get_fat(&fp->obj, clst);
+#endif
+		}
+		if (nclst != clst + 1) break;	/* End of fragment or error, left to the next round of the caller */
+		clst = nclst;
+		ncc += (cc - ncc < fs->csize) ? cc - ncc : fs->csize;
+	}
+	fp->clust = clst;
+
+	return ncc;
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Read File                                                             */
 /*-----------------------------------------------------------------------*/
@@ -3576,8 +3620,8 @@ FRESULT f_read (
 			sect += csect;
 			cc = btr / SS(fs);					/* When remaining bytes >= sector size, */
 			if (cc) {							/* Read maximum contiguous sectors directly */
-				if (csect + cc > fs->csize) {	/* Clip at cluster boundary */
-					cc = fs->csize - csect;
+				if (csect + cc > fs->csize) {	/* Go on over the contiguous clusters, clip at the end of fragment */
+					cc = extend_contig(fp, csect, cc, 0);
 				}
 				if (disk_read(fs->drv, rbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
 #if !_FS_READONLY && _FS_MINIMIZE <= 2			/* Replace one of the read sectors with cached data if it contains a dirty sector */
@@ -3691,8 +3735,8 @@ FRESULT f_write (
 			sect += csect;
 			cc = btw / SS(fs);				/* When remaining bytes >= sector size, */
 			if (cc) {						/* Write maximum contiguous sectors directly */
-				if (csect + cc > fs->csize) {	/* Clip at cluster boundary */
-					cc = fs->csize - csect;
+				if (csect + cc > fs->csize) {	/* Go on over the contiguous clusters, clip at the end of fragment */
+					cc = extend_contig(fp, csect, cc, 1);
 				}
 				if (disk_write(fs->drv, wbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
 #if _FS_MINIMIZE <= 2
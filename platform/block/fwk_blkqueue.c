@@ -0,0 +1,700 @@
+/*
+ * Hardware Abstraction Layer Block Request Queue
+ *
+ * File Name:   fwk_blkqueue.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <platform/fwk_mempool.h>
+#include <platform/block/fwk_blkqueue.h>
+#include <kernel/sched.h>
+#include <kernel/thread.h>
+#include <kernel/sleep.h>
+
+/*!< The defines */
+#define mrt_blk_hash_head(queue, sector)        (&(queue)->sgrt_hash[(sector) & (FWK_BLK_HASH_SIZE - 1)])
+
+/*!< The globals */
+static DECLARE_LIST_HEAD(sgrt_fwk_blk_queue_list);
+static struct mutex_lock sgrt_fwk_blk_queue_lock = MUTEX_LOCK_INIT();
+static tid_t g_fwk_bdflush_tid = -1;
+
+/*!< The functions */
+static kint32_t __fwk_blk_flush(struct fwk_request_queue *sprt_queue);
+
+/*!< API functions */
+/*!
+ * @brief   find sector in cache
+ * @param   sprt_queue, sector
+ * @retval  buffer (null if not cached)
+ * @note    none
+ */
+static struct fwk_blk_buffer *fwk_blk_lookup(struct fwk_request_queue *sprt_queue, kuint32_t sector)
+{
+    struct fwk_blk_buffer *sprt_bh;
+    struct list_head *sprt_head;
+
+    sprt_head = mrt_blk_hash_head(sprt_queue, sector);
+    foreach_list_next_entry(sprt_bh, sprt_head, sgrt_hash)
+    {
+        if (sprt_bh->sector == sector)
+            return sprt_bh;
+    }
+
+    return mrt_nullptr;
+}
+
+/*!
+ * @brief   mark buffer as the most recently used
+ * @param   sprt_queue, sprt_bh
+ * @retval  none
+ * @note    none
+ */
+static void fwk_blk_touch(struct fwk_request_queue *sprt_queue, struct fwk_blk_buffer *sprt_bh)
+{
+    list_head_del(&sprt_bh->sgrt_lru);
+    list_head_add_head(&sprt_queue->sgrt_lru, &sprt_bh->sgrt_lru);
+}
+
+/*!
+ * @brief   drop buffer from cache
+ * @param   sprt_queue, sprt_bh
+ * @retval  none
+ * @note    buffer is moved to the lru tail, it will be reused first
+ */
+static void fwk_blk_invalidate(struct fwk_request_queue *sprt_queue, struct fwk_blk_buffer *sprt_bh)
+{
+    if (sprt_bh->flags & NR_BLK_BufferDirty)
+        sprt_queue->nr_dirty--;
+
+    sprt_bh->flags = 0;
+    list_head_del(&sprt_bh->sgrt_hash);
+
+    list_head_del(&sprt_bh->sgrt_lru);
+    list_head_add_tail(&sprt_queue->sgrt_lru, &sprt_bh->sgrt_lru);
+}
+
+/*!
+ * @brief   find the least recently used clean buffer
+ * @param   sprt_queue
+ * @retval  buffer (null if all are dirty)
+ * @note    none
+ */
+static struct fwk_blk_buffer *fwk_blk_get_clean(struct fwk_request_queue *sprt_queue)
+{
+    struct fwk_blk_buffer *sprt_bh;
+
+    foreach_list_prev_entry(sprt_bh, &sprt_queue->sgrt_lru, sgrt_lru)
+    {
+        if (!(sprt_bh->flags & NR_BLK_BufferDirty))
+            return sprt_bh;
+    }
+
+    return mrt_nullptr;
+}
+
+/*!
+ * @brief   recycle buffer for sector
+ * @param   sprt_queue, sprt_bh, sector
+ * @retval  none
+ * @note    buffer must be clean; it becomes the most recently used one
+ */
+static void fwk_blk_assign(struct fwk_request_queue *sprt_queue, struct fwk_blk_buffer *sprt_bh, kuint32_t sector)
+{
+    fwk_blk_invalidate(sprt_queue, sprt_bh);
+
+    sprt_bh->sector = sector;
+    list_head_add_head(mrt_blk_hash_head(sprt_queue, sector), &sprt_bh->sgrt_hash);
+    fwk_blk_touch(sprt_queue, sprt_bh);
+}
+
+/*!
+ * @brief   get a buffer for sector
+ * @param   sprt_queue, sector
+ * @retval  buffer (data is not valid yet)
+ * @note    the least recently used clean buffer is recycled; only if all buffers are dirty,
+ *          they are written back together, so that they can be merged.
+ *          a buffer whose write-back fails is dropped by fwk_blk_end_request(), so that one
+ *          bad sector can not hold the whole cache
+ */
+static struct fwk_blk_buffer *fwk_blk_getblk(struct fwk_request_queue *sprt_queue, kuint32_t sector)
+{
+    struct fwk_blk_buffer *sprt_bh;
+
+    sprt_bh = fwk_blk_get_clean(sprt_queue);
+    if (!sprt_bh)
+    {
+        __fwk_blk_flush(sprt_queue);
+
+        sprt_bh = fwk_blk_get_clean(sprt_queue);
+        if (!sprt_bh)
+            return ERR_PTR(-ER_FAILD);
+    }
+
+    fwk_blk_assign(sprt_queue, sprt_bh, sector);
+
+    return sprt_bh;
+}
+
+/*!
+ * @brief   complete a request
+ * @param   sprt_queue, sprt_req, result: errno of device
+ * @retval  none
+ * @note    a cached sector is marked valid (read) or clean (write) on success, and dropped on
+ *          failure: a dirty sector that can not be written back is lost, it is not retried forever
+ */
+static void fwk_blk_end_request(struct fwk_request_queue *sprt_queue, struct fwk_blk_request *sprt_req, kint32_t result)
+{
+    struct fwk_blk_buffer *sprt_bh = sprt_req->sprt_bh;
+
+    if (!sprt_bh)
+        return;
+
+    if (result)
+    {
+        if (sprt_bh->flags & NR_BLK_BufferDirty)
+        {
+            sprt_queue->sgrt_stats.wberrors++;
+            print_err("%s: write back sector %d failed, it is dropped!\n", sprt_queue->name, sprt_bh->sector);
+        }
+
+        fwk_blk_invalidate(sprt_queue, sprt_bh);
+    }
+    else if (sprt_queue->dir == NR_BLK_RequestRead)
+        sprt_bh->flags |= NR_BLK_BufferValid;
+    else if (sprt_bh->flags & NR_BLK_BufferDirty)
+    {
+        sprt_bh->flags &= ~NR_BLK_BufferDirty;
+        sprt_queue->nr_dirty--;
+        sprt_queue->sgrt_stats.writebacks++;
+    }
+}
+
+/*!
+ * @brief   issue one request to device
+ * @param   sprt_queue, buffer, sector, count
+ * @retval  errno
+ * @note    direction is the one of queue
+ */
+static kint32_t fwk_blk_issue(struct fwk_request_queue *sprt_queue, kuint8_t *buffer, kuint32_t sector, kuint32_t count)
+{
+    if (sprt_queue->dir == NR_BLK_RequestWrite)
+    {
+        sprt_queue->sgrt_stats.writes++;
+        return sprt_queue->sprt_oprts->write_sectors(sprt_queue, buffer, sector, count);
+    }
+
+    sprt_queue->sgrt_stats.reads++;
+    return sprt_queue->sprt_oprts->read_sectors(sprt_queue, buffer, sector, count);
+}
+
+/*!
+ * @brief   issue all pending requests
+ * @param   sprt_queue
+ * @retval  errno
+ * @note    requests are sorted by sector, adjacent ones are merged into one multi-block
+ *          request (up to FWK_BLK_MAX_SECTORS); scattered buffers go through the bounce buffer.
+ *          if a merged request fails, its parts are issued one by one, so that only the bad
+ *          sectors are failed
+ */
+static kint32_t fwk_blk_run_queue(struct fwk_request_queue *sprt_queue)
+{
+    struct fwk_blk_request *sprt_req, *sprt_next;
+    kuint32_t idx, end, count, offset;
+    kuint8_t *buffer;
+    kbool_t is_contiguous;
+    kint32_t result, retval = ER_NORMAL;
+
+    for (idx = 0; idx < sprt_queue->nr_reqs; idx = end)
+    {
+        sprt_req = &sprt_queue->sgrt_reqs[idx];
+        count = sprt_req->count;
+        is_contiguous = true;
+
+        for (end = idx + 1; end < sprt_queue->nr_reqs; end++)
+        {
+            sprt_next = &sprt_queue->sgrt_reqs[end];
+            if ((sprt_next->sector != (sprt_req->sector + count)) ||
+                ((count + sprt_next->count) > FWK_BLK_MAX_SECTORS))
+                break;
+
+            if (sprt_next->buffer != (sprt_req->buffer + count * sprt_queue->sector_size))
+                is_contiguous = false;
+
+            count += sprt_next->count;
+        }
+
+        buffer = is_contiguous ? sprt_req->buffer : sprt_queue->bounce;
+
+        for (offset = 0; (!is_contiguous) && (sprt_queue->dir == NR_BLK_RequestWrite) && (idx + offset < end); offset++)
+        {
+            sprt_next = &sprt_queue->sgrt_reqs[idx + offset];
+            memcpy(buffer + (sprt_next->sector - sprt_req->sector) * sprt_queue->sector_size,
+                        sprt_next->buffer, sprt_next->count * sprt_queue->sector_size);
+        }
+
+        result = fwk_blk_issue(sprt_queue, buffer, sprt_req->sector, count);
+
+        if (sprt_queue->dir == NR_BLK_RequestRead)
+        {
+            for (offset = 0; (!result) && (!is_contiguous) && (idx + offset < end); offset++)
+            {
+                sprt_next = &sprt_queue->sgrt_reqs[idx + offset];
+                memcpy(sprt_next->buffer, buffer + (sprt_next->sector - sprt_req->sector) * sprt_queue->sector_size,
+                            sprt_next->count * sprt_queue->sector_size);
+            }
+        }
+
+        sprt_queue->sgrt_stats.merges += end - idx - 1;
+
+        /*!< issue the parts of a failed merged request one by one, only the bad sectors fail */
+        if (result && ((end - idx) > 1))
+        {
+            for (offset = idx; offset < end; offset++)
+            {
+                sprt_next = &sprt_queue->sgrt_reqs[offset];
+                result = fwk_blk_issue(sprt_queue, sprt_next->buffer, sprt_next->sector, sprt_next->count);
+                if (result)
+                    retval = result;
+
+                fwk_blk_end_request(sprt_queue, sprt_next, result);
+            }
+
+            continue;
+        }
+
+        if (result)
+            retval = result;
+
+        for (offset = idx; offset < end; offset++)
+            fwk_blk_end_request(sprt_queue, &sprt_queue->sgrt_reqs[offset], result);
+    }
+
+    sprt_queue->nr_reqs = 0;
+
+    return retval;
+}
+
+/*!
+ * @brief   add a request to queue
+ * @param   sprt_queue, dir, buffer, sector, count, sprt_bh
+ * @retval  errno
+ * @note    insertion keeps the queue sorted by sector; the queue is run first if it is
+ *          full or holds requests of the other direction
+ */
+static kint32_t fwk_blk_add_request(struct fwk_request_queue *sprt_queue, kuint32_t dir,
+                            void *buffer, kuint32_t sector, kuint32_t count, struct fwk_blk_buffer *sprt_bh)
+{
+    struct fwk_blk_request *sprt_req;
+    kint32_t idx, retval = ER_NORMAL;
+
+    if (sprt_queue->nr_reqs &&
+        ((sprt_queue->dir != dir) || (sprt_queue->nr_reqs >= FWK_BLK_MAX_REQUESTS)))
+        retval = fwk_blk_run_queue(sprt_queue);
+
+    sprt_queue->dir = dir;
+
+    for (idx = sprt_queue->nr_reqs; idx > 0; idx--)
+    {
+        if (sprt_queue->sgrt_reqs[idx - 1].sector < sector)
+            break;
+
+        sprt_queue->sgrt_reqs[idx] = sprt_queue->sgrt_reqs[idx - 1];
+    }
+
+    sprt_req = &sprt_queue->sgrt_reqs[idx];
+    sprt_req->sector = sector;
+    sprt_req->count = count;
+    sprt_req->buffer = buffer;
+    sprt_req->sprt_bh = sprt_bh;
+    sprt_queue->nr_reqs++;
+
+    return retval;
+}
+
+/*!
+ * @brief   write back all dirty buffers
+ * @param   sprt_queue
+ * @retval  errno
+ * @note    the caller must hold queue lock
+ */
+static kint32_t __fwk_blk_flush(struct fwk_request_queue *sprt_queue)
+{
+    struct fwk_blk_buffer *sprt_bh;
+    kuint32_t idx;
+    kint32_t retval = ER_NORMAL;
+
+    for (idx = 0; (idx < sprt_queue->nr_bufs) && sprt_queue->nr_dirty; idx++)
+    {
+        sprt_bh = &sprt_queue->sprt_bufs[idx];
+        if (!(sprt_bh->flags & NR_BLK_BufferDirty))
+            continue;
+
+        if (fwk_blk_add_request(sprt_queue, NR_BLK_RequestWrite, sprt_bh->data, sprt_bh->sector, 1, sprt_bh))
+            retval = -ER_FAILD;
+    }
+
+    if (fwk_blk_run_queue(sprt_queue))
+        retval = -ER_FAILD;
+
+    return retval;
+}
+
+/*!
+ * @brief   queue reads of the sectors following a missed one
+ * @param   sprt_queue, sector: the first sector to read ahead
+ * @retval  none
+ * @note    FAT and directory sectors are mostly walked in order. it stops at the first cached
+ *          sector, and takes clean buffers only, no more than are left: the ones queued here
+ *          are at lru head, so fwk_blk_get_clean() never hands them out twice
+ */
+static void fwk_blk_readahead(struct fwk_request_queue *sprt_queue, kuint32_t sector)
+{
+    struct fwk_blk_buffer *sprt_bh;
+    kuint32_t idx, limit;
+
+    /*!< one clean buffer is taken by the missed sector already */
+    limit = sprt_queue->nr_bufs - sprt_queue->nr_dirty - 1;
+    if (limit > FWK_BLK_READAHEAD)
+        limit = FWK_BLK_READAHEAD;
+
+    for (idx = 0; idx < limit; idx++)
+    {
+        if (fwk_blk_lookup(sprt_queue, sector + idx))
+            break;
+
+        sprt_bh = fwk_blk_get_clean(sprt_queue);
+        if (!sprt_bh)
+            break;
+
+        fwk_blk_assign(sprt_queue, sprt_bh, sector + idx);
+        fwk_blk_add_request(sprt_queue, NR_BLK_RequestRead, sprt_bh->data, sector + idx, 1, sprt_bh);
+    }
+}
+
+/*!
+ * @brief   read sectors
+ * @param   sprt_queue, buffer, sector, count
+ * @retval  errno
+ * @note    single sector accesses (FAT, directory entries, ...) are served by the cache, a miss
+ *          reads ahead, in the same merged request; multi-block data goes to device directly, and then dirty cached copies are
+ *          laid over it, since they are newer than the medium
+ */
+kint32_t fwk_blk_read(struct fwk_request_queue *sprt_queue, void *buffer, kuint32_t sector, kuint32_t count)
+{
+    struct fwk_blk_buffer *sprt_bh;
+    kuint32_t idx;
+    kint32_t retval;
+
+    if (!sprt_queue || !buffer || !count)
+        return -ER_NODEV;
+
+    mutex_lock(&sprt_queue->sgrt_lock);
+
+    if (count == 1)
+    {
+        sprt_bh = fwk_blk_lookup(sprt_queue, sector);
+        if (sprt_bh)
+        {
+            sprt_queue->sgrt_stats.hits++;
+            goto out;
+        }
+
+        sprt_queue->sgrt_stats.misses++;
+
+        sprt_bh = fwk_blk_getblk(sprt_queue, sector);
+        if (!isValid(sprt_bh))
+            goto fail;
+
+        /*!< the sector is dropped again by fwk_blk_end_request() if it can not be read */
+        fwk_blk_add_request(sprt_queue, NR_BLK_RequestRead, sprt_bh->data, sector, 1, sprt_bh);
+        fwk_blk_readahead(sprt_queue, sector + 1);
+        fwk_blk_run_queue(sprt_queue);
+        if (!(sprt_bh->flags & NR_BLK_BufferValid))
+            goto fail;
+
+    out:
+        memcpy(buffer, sprt_bh->data, sprt_queue->sector_size);
+        fwk_blk_touch(sprt_queue, sprt_bh);
+        mutex_unlock(&sprt_queue->sgrt_lock);
+
+        return ER_NORMAL;
+    }
+
+    retval = fwk_blk_add_request(sprt_queue, NR_BLK_RequestRead, buffer, sector, count, mrt_nullptr);
+    retval |= fwk_blk_run_queue(sprt_queue);
+    if (retval)
+        goto fail;
+
+    for (idx = 0; sprt_queue->nr_dirty && (idx < count); idx++)
+    {
+        sprt_bh = fwk_blk_lookup(sprt_queue, sector + idx);
+        if (sprt_bh && (sprt_bh->flags & NR_BLK_BufferDirty))
+            memcpy((kuint8_t *)buffer + idx * sprt_queue->sector_size, sprt_bh->data, sprt_queue->sector_size);
+    }
+
+    mutex_unlock(&sprt_queue->sgrt_lock);
+
+    return ER_NORMAL;
+
+fail:
+    mutex_unlock(&sprt_queue->sgrt_lock);
+    return -ER_FAILD;
+}
+
+/*!
+ * @brief   write sectors
+ * @param   sprt_queue, buffer, sector, count
+ * @retval  errno
+ * @note    single sector is kept dirty in cache, until it is evicted, flushed by bdflush or synced;
+ *          multi-block data is written directly, cached copies are refreshed afterwards
+ */
+kint32_t fwk_blk_write(struct fwk_request_queue *sprt_queue, const void *buffer, kuint32_t sector, kuint32_t count)
+{
+    struct fwk_blk_buffer *sprt_bh;
+    kuint32_t idx;
+    kint32_t retval;
+
+    if (!sprt_queue || !buffer || !count)
+        return -ER_NODEV;
+
+    mutex_lock(&sprt_queue->sgrt_lock);
+
+    if (count == 1)
+    {
+        sprt_bh = fwk_blk_lookup(sprt_queue, sector);
+        if (sprt_bh)
+            sprt_queue->sgrt_stats.hits++;
+        else
+        {
+            sprt_queue->sgrt_stats.misses++;
+
+            /*!< the whole sector is overwritten, no need to read it first */
+            sprt_bh = fwk_blk_getblk(sprt_queue, sector);
+            if (!isValid(sprt_bh))
+                goto fail;
+        }
+
+        memcpy(sprt_bh->data, buffer, sprt_queue->sector_size);
+        fwk_blk_touch(sprt_queue, sprt_bh);
+
+        if (!(sprt_bh->flags & NR_BLK_BufferDirty))
+            sprt_queue->nr_dirty++;
+        sprt_bh->flags |= NR_BLK_BufferValid | NR_BLK_BufferDirty;
+
+        /*!< too many dirty buffers, do not wait for bdflush */
+        retval = ER_NORMAL;
+        if (sprt_queue->nr_dirty >= (sprt_queue->nr_bufs >> 1))
+            retval = __fwk_blk_flush(sprt_queue);
+
+        mutex_unlock(&sprt_queue->sgrt_lock);
+        return retval;
+    }
+
+    retval = fwk_blk_add_request(sprt_queue, NR_BLK_RequestWrite, (void *)buffer, sector, count, mrt_nullptr);
+    retval |= fwk_blk_run_queue(sprt_queue);
+    if (retval)
+        goto fail;
+
+    for (idx = 0; idx < count; idx++)
+    {
+        sprt_bh = fwk_blk_lookup(sprt_queue, sector + idx);
+        if (!sprt_bh)
+            continue;
+
+        memcpy(sprt_bh->data, (const kuint8_t *)buffer + idx * sprt_queue->sector_size, sprt_queue->sector_size);
+
+        if (sprt_bh->flags & NR_BLK_BufferDirty)
+        {
+            sprt_bh->flags &= ~NR_BLK_BufferDirty;
+            sprt_queue->nr_dirty--;
+        }
+    }
+
+    mutex_unlock(&sprt_queue->sgrt_lock);
+
+    return ER_NORMAL;
+
+fail:
+    mutex_unlock(&sprt_queue->sgrt_lock);
+    return -ER_FAILD;
+}
+
+/*!
+ * @brief   write back all dirty sectors
+ * @param   sprt_queue
+ * @retval  errno
+ * @note    none
+ */
+kint32_t fwk_blk_flush(struct fwk_request_queue *sprt_queue)
+{
+    kint32_t retval;
+
+    if (!sprt_queue)
+        return -ER_NODEV;
+
+    mutex_lock(&sprt_queue->sgrt_lock);
+    retval = __fwk_blk_flush(sprt_queue);
+    mutex_unlock(&sprt_queue->sgrt_lock);
+
+    return retval;
+}
+
+/*!
+ * @brief   visit every registered queue
+ * @param   func: called with queue list locked, it may flush but must not (un)register queues
+ * @param   data: passed to func
+ * @retval  none
+ * @note    none
+ */
+void fwk_blk_foreach_queue(void (*func)(struct fwk_request_queue *sprt_queue, void *data), void *data)
+{
+    struct fwk_request_queue *sprt_queue;
+
+    if (!func)
+        return;
+
+    mutex_lock(&sgrt_fwk_blk_queue_lock);
+
+    foreach_list_next_entry(sprt_queue, &sgrt_fwk_blk_queue_list, sgrt_link)
+        func(sprt_queue, data);
+
+    mutex_unlock(&sgrt_fwk_blk_queue_lock);
+}
+
+/*!
+ * @brief   bdflush thread
+ * @param   args
+ * @retval  none
+ * @note    write back dirty sectors of all queues periodically
+ */
+static void *fwk_blk_flush_entry(void *args)
+{
+    struct fwk_request_queue *sprt_queue;
+
+    for (;;)
+    {
+        schedule_delay_ms(FWK_BLK_FLUSH_PERIOD);
+
+        mutex_lock(&sgrt_fwk_blk_queue_lock);
+
+        foreach_list_next_entry(sprt_queue, &sgrt_fwk_blk_queue_list, sgrt_link)
+        {
+            if (sprt_queue->nr_dirty)
+                fwk_blk_flush(sprt_queue);
+        }
+
+        mutex_unlock(&sgrt_fwk_blk_queue_lock);
+    }
+
+    return args;
+}
+
+/*!
+ * @brief   allocate and register a request queue
+ * @param   name, sector_size, nr_bufs (0: use FWK_BLK_CACHE_SECTORS), sprt_oprts, queuedata
+ * @retval  queue
+ * @note    bdflush is started by the first queue
+ */
+struct fwk_request_queue *fwk_blk_alloc_queue(const kchar_t *name, kuint32_t sector_size, kuint32_t nr_bufs,
+                                            const struct fwk_blk_queue_oprts *sprt_oprts, void *queuedata)
+{
+    struct fwk_request_queue *sprt_queue;
+    struct fwk_blk_buffer *sprt_bh;
+    kuint8_t *data;
+    kuint32_t idx;
+
+    if (!sector_size || !sprt_oprts || !sprt_oprts->read_sectors || !sprt_oprts->write_sectors)
+        return ERR_PTR(-ER_NODEV);
+
+    if (!nr_bufs)
+        nr_bufs = FWK_BLK_CACHE_SECTORS;
+
+    sprt_queue = kzalloc(sizeof(*sprt_queue), GFP_KERNEL);
+    if (!isValid(sprt_queue))
+        return ERR_PTR(-ER_NOMEM);
+
+    sprt_queue->sprt_bufs = kzalloc(nr_bufs * sizeof(*sprt_bh), GFP_KERNEL);
+    data = kmalloc(nr_bufs * sector_size, GFP_KERNEL);
+    sprt_queue->bounce = kmalloc(FWK_BLK_MAX_SECTORS * sector_size, GFP_KERNEL);
+    if (!isValid(sprt_queue->sprt_bufs) || !isValid(data) || !isValid(sprt_queue->bounce))
+        goto fail;
+
+    strncpy(sprt_queue->name, name ? name : "blk", sizeof(sprt_queue->name) - 1);
+    sprt_queue->sector_size = sector_size;
+    sprt_queue->sprt_oprts = sprt_oprts;
+    sprt_queue->queuedata = queuedata;
+    sprt_queue->nr_bufs = nr_bufs;
+    mutex_init(&sprt_queue->sgrt_lock);
+
+    init_list_head(&sprt_queue->sgrt_lru);
+    for (idx = 0; idx < FWK_BLK_HASH_SIZE; idx++)
+        init_list_head(&sprt_queue->sgrt_hash[idx]);
+
+    for (idx = 0; idx < nr_bufs; idx++)
+    {
+        sprt_bh = &sprt_queue->sprt_bufs[idx];
+        sprt_bh->data = data + idx * sector_size;
+        init_list_head(&sprt_bh->sgrt_hash);
+        list_head_add_tail(&sprt_queue->sgrt_lru, &sprt_bh->sgrt_lru);
+    }
+
+    mutex_lock(&sgrt_fwk_blk_queue_lock);
+    list_head_add_tail(&sgrt_fwk_blk_queue_list, &sprt_queue->sgrt_link);
+    mutex_unlock(&sgrt_fwk_blk_queue_lock);
+
+    if (g_fwk_bdflush_tid < 0)
+    {
+        g_fwk_bdflush_tid = kernel_thread_create(-1, mrt_nullptr, fwk_blk_flush_entry, mrt_nullptr);
+        if (g_fwk_bdflush_tid >= 0)
+        {
+            thread_set_priority(mrt_tid_attr(g_fwk_bdflush_tid), THREAD_PROTY_BDFLUSH);
+            thread_set_name(g_fwk_bdflush_tid, "bdflush");
+        }
+    }
+
+    return sprt_queue;
+
+fail:
+    if (isValid(sprt_queue->bounce))
+        kfree(sprt_queue->bounce);
+    if (isValid(data))
+        kfree(data);
+    if (isValid(sprt_queue->sprt_bufs))
+        kfree(sprt_queue->sprt_bufs);
+    kfree(sprt_queue);
+
+    return ERR_PTR(-ER_NOMEM);
+}
+
+/*!
+ * @brief   unregister and free a request queue
+ * @param   sprt_queue
+ * @retval  none
+ * @note    dirty sectors are written back first
+ */
+void fwk_blk_free_queue(struct fwk_request_queue *sprt_queue)
+{
+    if (!isValid(sprt_queue))
+        return;
+
+    mutex_lock(&sgrt_fwk_blk_queue_lock);
+    list_head_del(&sprt_queue->sgrt_link);
+    mutex_unlock(&sgrt_fwk_blk_queue_lock);
+
+    if (fwk_blk_flush(sprt_queue))
+        print_warn("%s: write back dirty sectors failed!\n", sprt_queue->name);
+
+    kfree(sprt_queue->bounce);
+    kfree(sprt_queue->sprt_bufs[0].data);
+    kfree(sprt_queue->sprt_bufs);
+    kfree(sprt_queue);
+}
+
+/*!< end of file */
@@ -13,6 +13,8 @@
 /*!< The includes */
 #include <platform/fwk_platform.h>
 #include <platform/fwk_platdev.h>
+#include <platform/fwk_platdrv.h>
+#include <kernel/mutex.h>
 
 /*!< The defines */
 struct fwk_platdev_object
@@ -29,6 +31,9 @@ static struct fwk_device_type sgrt_fwk_platform_dev_type =
 
 static DECLARE_LIST_HEAD(sgrt_fwk_devices);
 
+/*!< device list of bus; not held while probing, since probe may add devices */
+static struct mutex_lock sgrt_fwk_device_lock = MUTEX_LOCK_INIT();
+
 /*!< The functions */
 static kint32_t fwk_device_attach(struct fwk_device *sprt_dev, struct fwk_bus_type *sprt_bus_type);
 static kint32_t fwk_device_detach(struct fwk_device *sprt_dev);
@@ -163,6 +168,28 @@ static kint32_t fwk_device_find(struct fwk_device *sprt_dev)
     return -ER_NOTFOUND;
 }
 
+/*!
+ * @brief   lock device list of bus
+ * @param   none
+ * @retval  none
+ * @note    held while the list is walked outside of this file
+ */
+void fwk_bus_device_lock(void)
+{
+    mutex_lock(&sgrt_fwk_device_lock);
+}
+
+/*!
+ * @brief   unlock device list of bus
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+void fwk_bus_device_unlock(void)
+{
+    mutex_unlock(&sgrt_fwk_device_lock);
+}
+
 /*!
  * @brief   Device Match Interface
  * @param   device, platform-bus
@@ -185,17 +212,28 @@ static kint32_t fwk_device_attach(struct fwk_device *sprt_dev, struct fwk_bus_ty
     if (!sprt_bus_type->match)
         return -ER_NSUPPORT;
 
+    /*!< async initcalls may register drivers meanwhile; only match under the lock, probe after it */
+    fwk_bus_driver_lock();
+
     FWK_INIT_BUS_DRIVER_LIST(sprt_parent, sprt_list, sprt_bus_type);
 
-    /*!< get driver from bus one after another */
+    /*!< get driver from bus one after another, stop at the first one that matches */
     while ((sprt_driver = FWK_NEXT_DRIVER(sprt_parent, sprt_list)))
     {
-        /*!< try to attach this driver */
-        retval = fwk_device_driver_match(sprt_dev, sprt_bus_type, sprt_driver);
-        if (!retval || (retval == -ER_PERMIT))
-            return ER_NORMAL;
+        if (sprt_bus_type->match(sprt_dev, sprt_driver) >= 0)
+            break;
     }
 
+    fwk_bus_driver_unlock();
+
+    if (!sprt_driver)
+        return -ER_PERMIT;
+
+    /*!< try to attach this driver; -ER_EXISTED: the driver side attach has bound it meanwhile */
+    retval = fwk_device_driver_match(sprt_dev, sprt_bus_type, sprt_driver);
+    if (!retval || (retval == -ER_PERMIT) || (retval == -ER_DEFER) || (retval == -ER_EXISTED))
+        return ER_NORMAL;
+
     return -ER_PERMIT;
 }
 
@@ -236,7 +274,9 @@ static kint32_t fwk_device_to_bus(struct fwk_device *sprt_dev, struct fwk_bus_ty
     kint32_t retval;
 
     /*!< add to list tail */
+    fwk_bus_device_lock();
     list_head_add_tail(FWK_GET_BUS_DEVICE(sprt_bus_type), &sprt_dev->sgrt_link);
+    fwk_bus_device_unlock();
 
     /*!< do device-driver matching */
     retval = fwk_device_attach(sprt_dev, sprt_bus_type);
@@ -255,7 +295,9 @@ static kint32_t fwk_bus_del_device(struct fwk_device *sprt_dev, struct fwk_bus_t
     fwk_device_detach(sprt_dev);
 
     /*!< delete device */
+    fwk_bus_device_lock();
     list_head_del_safe(FWK_GET_BUS_DEVICE(sprt_bus_type), &sprt_dev->sgrt_link);
+    fwk_bus_device_unlock();
 
     return ER_NORMAL;
 }
@@ -328,6 +370,7 @@ kint32_t fwk_device_del(struct fwk_device *sprt_dev)
             return retval;
     }
 
+    fwk_deferred_probe_del(sprt_dev);
     mrt_dev_del_name(sprt_dev);
     list_head_del(&sprt_dev->sgrt_leaf);
     return ER_NORMAL;
@@ -12,7 +12,13 @@
 
 /*!< The includes */
 #include <platform/fwk_platform.h>
+#include <platform/fwk_platdev.h>
 #include <platform/fwk_platdrv.h>
+#include <kernel/mutex.h>
+
+/*!< The globals */
+/*!< async initcalls may register drivers at the same time */
+static struct mutex_lock sgrt_fwk_driver_lock = MUTEX_LOCK_INIT();
 
 /*!< The functions */
 static kint32_t fwk_driver_attach(struct fwk_driver *sprt_driver, struct fwk_bus_type *sprt_bus_type,
@@ -71,19 +77,24 @@ static kint32_t fwk_driver_attach(struct fwk_driver *sprt_driver, struct fwk_bus
 		return -ER_ERROR;
 
 	matches	= 0;
+	fwk_bus_device_lock();
 	FWK_INIT_BUS_DEVICE_LIST(sprt_parent, sprt_list, sprt_bus_type);
 
 	/*!< Take out the devices on the bus in turn */
 	while ((sprt_dev = FWK_NEXT_DEVICE(sprt_parent, sprt_list)))
 	{
 		/*!< The device is matched with drivers */
-		if (sprt_dev->sprt_driver)
+		if (sprt_dev->sprt_driver || (sprt_bus_type->match(sprt_dev, sprt_driver) < 0))
 			continue;
 
 		/*!< Match one by one */
 		/*!< One driver supports matching multiple devices, and does not exit until the linked list is fully traversed */
 		/*!< However, try not to mount multiple devices with the same driver at the same time to avoid misoperation */
+		/*!< Probe may add devices, so it runs unlocked; the walk goes on from this device, it stays on the bus */
+		fwk_bus_device_unlock();
 		retval = (*pFunc_Match)(sprt_dev, sprt_bus_type, sprt_driver);
+		fwk_bus_device_lock();
+
 		if (!retval || (retval == -ER_PERMIT))
 		{
 			/*!< Record the number of matching devices */
@@ -91,15 +102,19 @@ static kint32_t fwk_driver_attach(struct fwk_driver *sprt_driver, struct fwk_bus
 		}
 	}
 
+	fwk_bus_device_unlock();
+
 	sprt_driver->matches += matches;
 
 	/*!<
 	 * ER_NOTFOUND: no device can be matched
 	 * ER_PERMIT: matched already, but probe failed;
+	 * ER_DEFER: matched, but probe is deferred, the device will be retried (not counted);
+	 * ER_EXISTED: the device side attach has bound it meanwhile (not counted);
 	 * ER_NORMAL: matched already, and probe successfully;
 	 * other (retval < 0): error
 	 */
-	return ((retval == (-ER_NOTFOUND)) || matches) ? matches : retval;
+	return ((retval == (-ER_NOTFOUND)) || (retval == (-ER_DEFER)) || (retval == (-ER_EXISTED)) || matches) ? matches : retval;
 }
 
 /*!
@@ -115,6 +130,7 @@ static kint32_t fwk_driver_detach(struct fwk_driver *sprt_driver, struct fwk_bus
 	DECLARE_LIST_HEAD_PTR(sprt_list);
 	DECLARE_LIST_HEAD_PTR(sprt_parent);
 
+	fwk_bus_device_lock();
 	FWK_INIT_BUS_DEVICE_LIST(sprt_parent, sprt_list, sprt_bus_type);
 
 	/*!< Take out the devices on the bus in turn */
@@ -124,14 +140,18 @@ static kint32_t fwk_driver_detach(struct fwk_driver *sprt_driver, struct fwk_bus
 		if (sprt_dev->sprt_driver != sprt_driver)
 			continue;
 
-		/*!< Do the preparation before separation */
+		/*!< Do the preparation before separation; remove may delete devices, so it runs unlocked */
+		fwk_bus_device_unlock();
 		fwk_device_driver_remove(sprt_dev);
+		fwk_bus_device_lock();
 
 		/*!< separation */
 		sprt_dev->sprt_driver = mrt_nullptr;
 		sprt_driver->matches--;
 	}
 
+	fwk_bus_device_unlock();
+
 	return ER_NORMAL;
 }
 
@@ -154,6 +174,28 @@ static kint32_t fwk_driver_find(struct fwk_driver *sprt_driver, struct fwk_bus_t
 	return -ER_ERROR;
 }
 
+/*!
+ * @brief   lock driver list of bus
+ * @param   none
+ * @retval  none
+ * @note    held while the list is walked outside of this file
+ */
+void fwk_bus_driver_lock(void)
+{
+	mutex_lock(&sgrt_fwk_driver_lock);
+}
+
+/*!
+ * @brief   unlock driver list of bus
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+void fwk_bus_driver_unlock(void)
+{
+	mutex_unlock(&sgrt_fwk_driver_lock);
+}
+
 /*!
  * @brief   Add driver to platform-bus
  * @param   driver, platform-bus
@@ -162,8 +204,20 @@ static kint32_t fwk_driver_find(struct fwk_driver *sprt_driver, struct fwk_bus_t
  */
 static kint32_t fwk_driver_to_bus(struct fwk_driver *sprt_driver, struct fwk_bus_type *sprt_bus_type)
 {
+	/*!< Is the driver registered? No more duplicate registrations */
+	mutex_lock(&sgrt_fwk_driver_lock);
+	if (!fwk_driver_find(sprt_driver, sprt_bus_type))
+	{
+		mutex_unlock(&sgrt_fwk_driver_lock);
+		return -ER_ERROR;
+	}
+
+	/*!< For the first registration, the number of device matches is initialized to 0 */
+	sprt_driver->matches = 0;
+
 	/*!< Insert from the tail of the bus */
 	list_head_add_tail(FWK_GET_BUS_DRIVER(sprt_bus_type), &sprt_driver->sgrt_link);
+	mutex_unlock(&sgrt_fwk_driver_lock);
 
 	/*!< Execute the device driver matching logic */
 	return fwk_driver_attach(sprt_driver, sprt_bus_type, fwk_device_driver_match);
@@ -183,7 +237,9 @@ static kint32_t fwk_bus_del_driver(struct fwk_driver *sprt_driver, struct fwk_bu
 	retval = fwk_driver_detach(sprt_driver, sprt_bus_type);
 
 	/*!< Remove the driver from the bus */
+	mutex_lock(&sgrt_fwk_driver_lock);
 	list_head_del_safe(FWK_GET_BUS_DRIVER(sprt_bus_type), &sprt_driver->sgrt_link);
+	mutex_unlock(&sgrt_fwk_driver_lock);
 
 	return retval;
 }
@@ -197,7 +253,6 @@ static kint32_t fwk_bus_del_driver(struct fwk_driver *sprt_driver, struct fwk_bu
 kint32_t fwk_driver_register(struct fwk_driver *sprt_driver)
 {
 	struct fwk_bus_type *sprt_bus_type;
-	kint32_t retval;
 
 	sprt_bus_type = sprt_driver->sprt_bus;
 
@@ -209,14 +264,6 @@ kint32_t fwk_driver_register(struct fwk_driver *sprt_driver)
 	if (!sprt_bus_type->sprt_SysPriv)
 		goto fail;
 
-	/*!< Is the driver registered? No more duplicate registrations */
-	retval = fwk_driver_find(sprt_driver, sprt_bus_type);
-	if (!retval)
-		goto fail;
-
-	/*!< For the first registration, the number of device matches is initialized to 0 */
-	sprt_driver->matches = 0;
-
 	/*!< Add the driver to the bus, and if the match is successful, return Well */
 	return fwk_driver_to_bus(sprt_driver, sprt_bus_type);
 
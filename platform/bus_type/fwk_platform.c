@@ -16,12 +16,79 @@
 #include <platform/fwk_platdrv.h>
 #include <platform/fwk_pinctrl.h>
 #include <platform/fwk_inode.h>
+#include <boot/boot_prof.h>
+#include <kernel/mutex.h>
 
 /*!<
  * One device can only be matched with one driver
  * One driver can be used for multiple devices
  */
 
+/*!< The globals */
+/*!< devices whose probe returned -ER_DEFER, retried whenever a device is bound */
+static DECLARE_LIST_HEAD(sgrt_fwk_deferred_probe);
+static struct mutex_lock sgrt_fwk_deferred_lock = MUTEX_LOCK_INIT();
+static kuint32_t g_fwk_deferred_binds = 0;              /*!< increased once a device is bound */
+static kbool_t g_fwk_deferred_running = false;
+
+/*!< device and driver side attach may race for one device: sprt_driver is claimed under it */
+static struct mutex_lock sgrt_fwk_bind_lock = MUTEX_LOCK_INIT();
+
+/*!< The functions */
+/*!
+ * @brief   put device on deferred list
+ * @param   sprt_dev
+ * @retval  none
+ * @note    the driver is remembered for terminal only, matching is done again when retried
+ */
+static void fwk_deferred_probe_add(struct fwk_device *sprt_dev)
+{
+    mutex_lock(&sgrt_fwk_deferred_lock);
+
+    sprt_dev->sprt_defer_driver = sprt_dev->sprt_driver;
+    if (!sprt_dev->defer_reason)
+        sprt_dev->defer_reason = "probe deferred by driver";
+
+    if (mrt_list_head_empty(&sprt_dev->sgrt_deferred))
+        list_head_add_tail(&sgrt_fwk_deferred_probe, &sprt_dev->sgrt_deferred);
+
+    mutex_unlock(&sgrt_fwk_deferred_lock);
+}
+
+/*!
+ * @brief   try drivers on the bus for a deferred device
+ * @param   sprt_dev
+ * @retval  none
+ * @note    same as the device side attach: stop at the first driver that matches
+ */
+static void fwk_deferred_probe_attach(struct fwk_device *sprt_dev)
+{
+    struct fwk_bus_type *sprt_bus_type = sprt_dev->sprt_bus;
+    struct fwk_driver *sprt_driver;
+
+    DECLARE_LIST_HEAD_PTR(sprt_list);
+    DECLARE_LIST_HEAD_PTR(sprt_parent);
+
+    if (!sprt_bus_type || !sprt_bus_type->match || sprt_dev->sprt_driver)
+        return;
+
+    /*!< async initcalls may register drivers meanwhile; only match under the lock, probe after it */
+    fwk_bus_driver_lock();
+
+    FWK_INIT_BUS_DRIVER_LIST(sprt_parent, sprt_list, sprt_bus_type);
+
+    while ((sprt_driver = FWK_NEXT_DRIVER(sprt_parent, sprt_list)))
+    {
+        if (sprt_bus_type->match(sprt_dev, sprt_driver) >= 0)
+            break;
+    }
+
+    fwk_bus_driver_unlock();
+
+    if (sprt_driver)
+        fwk_device_driver_match(sprt_dev, sprt_bus_type, sprt_driver);
+}
+
 /*!< API function */
 /*!
  * @brief   Match device and driver
@@ -85,6 +152,7 @@ static kint32_t fwk_platform_probe(struct fwk_device *sprt_dev)
     struct fwk_driver  *sprt_driver;
     struct fwk_platdev *sprt_platdev;
     struct fwk_platdrv *sprt_platdrv;
+    kint32_t retval;
 
     sprt_driver	= sprt_dev->sprt_driver;
     if (!sprt_driver)
@@ -93,7 +161,14 @@ static kint32_t fwk_platform_probe(struct fwk_device *sprt_dev)
     sprt_platdev = mrt_container_of(sprt_dev, struct fwk_platdev, sgrt_dev);
     sprt_platdrv = mrt_container_of(sprt_driver, struct fwk_platdrv, sgrt_driver);
 
-    if ((!sprt_platdrv->probe) || (0 > sprt_platdrv->probe(sprt_platdev)))
+    if (!sprt_platdrv->probe)
+        return -ER_PERMIT;
+
+    retval = sprt_platdrv->probe(sprt_platdev);
+    if (retval == -ER_DEFER)
+        return retval;
+
+    if (retval < 0)
     {
         print_warn("device driver probe anomaly, driver is: %s\n", sprt_platdrv->sgrt_driver.name);
         return -ER_PERMIT;
@@ -155,7 +230,7 @@ struct fwk_bus_type sgrt_fwk_platform_bus_type =
 kint32_t fwk_device_driver_probe(struct fwk_device *sprt_dev)
 {
     struct fwk_bus_type *sprt_bus_type;
-    kint32_t retval;
+    kint32_t slot, retval;
 
     sprt_bus_type = sprt_dev->sprt_bus;
 
@@ -165,7 +240,25 @@ kint32_t fwk_device_driver_probe(struct fwk_device *sprt_dev)
 
     if (sprt_bus_type->probe)
     {
+        /*!< device as name, driver as owner: the bus probe is the same function for all */
+        slot = boot_prof_begin(NR_BOOT_PROF_PROBE, (const void *)sprt_bus_type->probe, mrt_dev_get_name(sprt_dev),
+                                sprt_dev->sprt_driver ? sprt_dev->sprt_driver->name : mrt_nullptr, 0);
         retval = sprt_bus_type->probe(sprt_dev);
+        boot_prof_end(slot, retval);
+
+        if (retval == -ER_DEFER)
+        {
+            /*!< free the device for a later match, it is retried once something else is bound */
+            fwk_pinctrl_unbind_pins(sprt_dev);
+            fwk_deferred_probe_add(sprt_dev);
+
+            mutex_lock(&sgrt_fwk_bind_lock);
+            sprt_dev->sprt_driver = mrt_nullptr;
+            mutex_unlock(&sgrt_fwk_bind_lock);
+
+            return retval;
+        }
+
         if (retval)
         {
             fwk_pinctrl_unbind_pins(sprt_dev);
@@ -174,6 +267,10 @@ kint32_t fwk_device_driver_probe(struct fwk_device *sprt_dev)
             return retval;
         }
 
+        /*!< a new provider may be what the deferred devices are waiting for */
+        fwk_deferred_probe_del(sprt_dev);
+        fwk_deferred_probe_trigger();
+
         return ER_NORMAL;
     }
 
@@ -213,7 +310,16 @@ kint32_t fwk_device_driver_match(struct fwk_device *sprt_dev, struct fwk_bus_typ
      * Save the device to indicate that the driver has been matched;
      * You only need to operate the device to obtain the driver's information 
      */
+    mutex_lock(&sgrt_fwk_bind_lock);
+    if (sprt_dev->sprt_driver)
+    {
+        /*!< claimed by the other side already, it must not be probed twice */
+        mutex_unlock(&sgrt_fwk_bind_lock);
+        return -ER_EXISTED;
+    }
+
     sprt_dev->sprt_driver = sprt_driver;
+    mutex_unlock(&sgrt_fwk_bind_lock);
 
     return fwk_device_driver_probe(sprt_dev);
 }
@@ -230,6 +336,9 @@ kint32_t fwk_device_initial(struct fwk_device *sprt_dev)
 
     init_list_head(&sprt_dev->sgrt_leaf);
     init_list_head(&sprt_dev->sgrt_link);
+    init_list_head(&sprt_dev->sgrt_deferred);
+    sprt_dev->sprt_defer_driver = mrt_nullptr;
+    sprt_dev->defer_reason = mrt_nullptr;
     fwk_kobject_init(&sprt_dev->sgrt_kobj);
 
     sprt_kobj = fwk_find_kobject_by_path(mrt_nullptr, FWK_PATH_SYS_DEVICE);
@@ -331,4 +440,120 @@ kint32_t fwk_device_destroy(struct fwk_device *sprt_dev)
     return ER_NORMAL;
 }
 
+/*!
+ * @brief   defer probe of device
+ * @param   sprt_dev
+ * @param   reason: what is missing, shown by terminal; must not be freed
+ * @retval  -ER_DEFER, return it from probe
+ * @note    call it in probe if a clock, regulator, gpio or pinctrl provider is not registered yet;
+ *          the probe is called again once any device is bound, resources got so far must be released
+ */
+kint32_t fwk_device_defer_probe(struct fwk_device *sprt_dev, const kchar_t *reason)
+{
+    if (sprt_dev)
+        sprt_dev->defer_reason = reason;
+
+    return -ER_DEFER;
+}
+
+/*!
+ * @brief   take device off deferred list
+ * @param   sprt_dev
+ * @retval  none
+ * @note    called if the device is bound or deleted
+ */
+void fwk_deferred_probe_del(struct fwk_device *sprt_dev)
+{
+    mutex_lock(&sgrt_fwk_deferred_lock);
+
+    if (!mrt_list_head_empty(&sprt_dev->sgrt_deferred))
+    {
+        list_head_del(&sprt_dev->sgrt_deferred);
+        init_list_head(&sprt_dev->sgrt_deferred);
+    }
+
+    sprt_dev->sprt_defer_driver = mrt_nullptr;
+    sprt_dev->defer_reason = mrt_nullptr;
+
+    mutex_unlock(&sgrt_fwk_deferred_lock);
+}
+
+/*!
+ * @brief   retry all deferred devices
+ * @param   none
+ * @retval  none
+ * @note    binds made while retrying (including nested ones) start another pass, instead of recursing;
+ *          also called once all platform initcalls are done, for providers that are not drivers
+ */
+void fwk_deferred_probe_trigger(void)
+{
+    struct fwk_device *sprt_dev;
+    kuint32_t binds;
+
+    DECLARE_LIST_HEAD(sgrt_pending);
+
+    mutex_lock(&sgrt_fwk_deferred_lock);
+
+    g_fwk_deferred_binds++;
+    if (g_fwk_deferred_running)
+    {
+        mutex_unlock(&sgrt_fwk_deferred_lock);
+        return;
+    }
+
+    g_fwk_deferred_running = true;
+
+    do
+    {
+        binds = g_fwk_deferred_binds;
+
+        /*!< devices deferred again are put back to sgrt_fwk_deferred_probe */
+        while (!mrt_list_head_empty(&sgrt_fwk_deferred_probe))
+        {
+            sprt_dev = mrt_list_first_entry(&sgrt_fwk_deferred_probe, struct fwk_device, sgrt_deferred);
+            list_head_del(&sprt_dev->sgrt_deferred);
+            list_head_add_tail(&sgrt_pending, &sprt_dev->sgrt_deferred);
+        }
+
+        while (!mrt_list_head_empty(&sgrt_pending))
+        {
+            sprt_dev = mrt_list_first_entry(&sgrt_pending, struct fwk_device, sgrt_deferred);
+            list_head_del(&sprt_dev->sgrt_deferred);
+            init_list_head(&sprt_dev->sgrt_deferred);
+            mutex_unlock(&sgrt_fwk_deferred_lock);
+
+            fwk_deferred_probe_attach(sprt_dev);
+
+            mutex_lock(&sgrt_fwk_deferred_lock);
+        }
+
+    } while ((binds != g_fwk_deferred_binds) && !mrt_list_head_empty(&sgrt_fwk_deferred_probe));
+
+    g_fwk_deferred_running = false;
+
+    mutex_unlock(&sgrt_fwk_deferred_lock);
+}
+
+/*!
+ * @brief   visit every deferred device
+ * @param   func: called with lock held, must not probe or register
+ * @param   data: passed to func
+ * @retval  none
+ * @note    devices being retried are not visited
+ */
+void fwk_deferred_probe_foreach(void (*func)(struct fwk_device *sprt_dev, void *data), void *data)
+{
+    struct fwk_device *sprt_dev;
+
+    if (!func)
+        return;
+
+    mutex_lock(&sgrt_fwk_deferred_lock);
+
+    foreach_list_next_entry(sprt_dev, &sgrt_fwk_deferred_probe, sgrt_deferred)
+        func(sprt_dev, data);
+
+    mutex_unlock(&sgrt_fwk_deferred_lock);
+}
+
 /*!< end of file */
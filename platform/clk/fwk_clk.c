@@ -207,6 +207,33 @@ struct fwk_clk *fwk_clk_get(struct fwk_device *sprt_dev, const kchar_t *name)
     return fwk_create_clk(fwk_clk_to_hw(sprt_clk), mrt_dev_get_name(sprt_dev), name);
 }
 
+/*!
+ * @brief   check if clk can not be got only because its provider is not registered yet
+ * @param   sprt_dev, name
+ * @retval  true: defer probe; false: ready, or not described in device tree
+ * @note    used after fwk_clk_get failed, to tell deferral from a wrong device tree
+ */
+kbool_t fwk_clk_is_deferred(struct fwk_device *sprt_dev, const kchar_t *name)
+{
+    struct fwk_device_node *sprt_node;
+    struct fwk_of_phandle_args sgrt_args;
+    kint32_t index = 0;
+
+    sprt_node = sprt_dev->sprt_node;
+
+    if (name)
+    {
+        index = fwk_of_property_match_string(sprt_node, "clock-names", name);
+        if (index < 0)
+            return false;
+    }
+
+    if (fwk_of_parse_phandle_with_args(sprt_node, "clocks", "#clock-cells", 0, index, &sgrt_args))
+        return false;
+
+    return !isValid(fwk_clk_provider_look_up(&sgrt_args));
+}
+
 /*!
  * @brief   release clk
  * @param   sprt_clk
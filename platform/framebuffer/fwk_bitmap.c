@@ -15,6 +15,7 @@
 #include <platform/video/fwk_disp.h>
 #include <platform/video/fwk_bitmap.h>
 #include <platform/video/fwk_rgbmap.h>
+#include <platform/video/fwk_blit.h>
 #include <kernel/kernel.h>
 #include <kernel/mutex.h>
 
@@ -122,6 +123,8 @@ void fwk_display_dot_matrix_image(struct fwk_disp_info *sprt_disp, kuint32_t x_s
             fwk_display_write_pixel(sprt_disp->buffer, offset + px_cnt, sprt_disp->bpp, rgb_data);
         }
     }
+
+    fwk_display_add_damage(sprt_disp, x_start, y_start, x_start + width, y_start + height);
 }
 
 /*!
@@ -173,10 +176,11 @@ kint32_t fwk_display_bitmap(struct fwk_bmp_ctrl *sprt_bctl, const kuint8_t *imag
 {
     struct fwk_bmp_info_header *sprt_bi;
     struct fwk_disp_info *sprt_disp;
-    kuint32_t offset;
-    kuint32_t rgb_data, rgb_inc = 0;
-    kuint8_t image_bpp;
-    kuint32_t width, height, x_pos, y_pos, y_offset;
+    struct fwk_blit_surface sgrt_surf;
+    fwk_blit_copy_t copy;
+    kint32_t format;
+    kuint32_t image_bpp, count;
+    kuint32_t width, height, x_pos, y_pos, y_offset, y_first, y_last;
     kuint8_t *ptr_bitmap;
 
     if ((!image) || 
@@ -189,6 +193,12 @@ kint32_t fwk_display_bitmap(struct fwk_bmp_ctrl *sprt_bctl, const kuint8_t *imag
     sprt_bi = &sprt_bctl->sgrt_bi;
     sprt_disp = sprt_bctl->sprt_disp;
 
+    format = fwk_blit_format_by_bpp(sprt_bi->pixelbit);
+    if ((format < 0) || fwk_display_surface(sprt_disp, &sgrt_surf))
+        return -ER_UNVALID;
+
+    copy = fwk_blit_get_copy(format, sgrt_surf.format);
+
     /*!< bytes of per pixel color (RGB24: bits = 24, bytes = 3) */
     image_bpp = sprt_bi->pixelbit >> 3;
 
@@ -212,9 +222,10 @@ kint32_t fwk_display_bitmap(struct fwk_bmp_ctrl *sprt_bctl, const kuint8_t *imag
 
     x_pos = sprt_bctl->x_next;
     y_pos = sprt_bctl->y_next;
+    y_first = y_pos;
 
-    /*!< draw rgb pixel */
-    for (rgb_inc = 0; rgb_inc < size; x_pos++, rgb_inc += image_bpp)
+    /*!< draw rgb pixels, one span (the rest of current line) each time */
+    while (size >= image_bpp)
     {
         if (x_pos >= (sprt_bctl->x_start + width))
         {
@@ -232,26 +243,22 @@ kint32_t fwk_display_bitmap(struct fwk_bmp_ctrl *sprt_bctl, const kuint8_t *imag
          */
         y_offset = (sprt_bi->height < 0) ? y_pos : ((sprt_bctl->y_start >> 1) + height - y_pos - 1);
 
-        /*!< offset = x + y * width */
-        offset = mrt_fwk_disp_advance_pos(x_pos, y_offset, sprt_disp->width);
+        count = CMP_MIN2(sprt_bctl->x_start + width - x_pos, size / image_bpp);
+        copy(fwk_blit_pixel_addr(&sgrt_surf, x_pos, y_offset), ptr_bitmap, count);
 
-        rgb_data = 0;
-#if 0
-        for (kuint32_t p_cnt = 0; p_cnt < image_bpp; p_cnt++)
-        {
-            rgb_data <<= 8;
-            rgb_data  |= *(ptr_bitmap + rgb_inc + p_cnt);
-        }
-
-        /*!< reverse littile endian, for RGB24, such as: BGR <===> RGB */
-        rgb_data = fwk_pixel_rgbform_convert(sprt_bi->pixelbit, rgb_data);
-#else
-        kmemcpy(&rgb_data, ptr_bitmap + rgb_inc, image_bpp);
-#endif
-        rgb_data = mrt_fwk_disp_convert_rgb(sprt_bi->pixelbit, sprt_disp->bpp, rgb_data);
-        mrt_fwk_disp_write_pixel(sprt_disp->buffer, offset, sprt_disp->bpp, rgb_data); 
+        ptr_bitmap += count * image_bpp;
+        size -= count * image_bpp;
+        x_pos += count;
     }
 
+    /*!< rows y_first ~ y_pos have been drawn (maybe partially) */
+    y_last = CMP_MIN2(y_pos, sprt_bctl->y_start + height - 1);
+    if (sprt_bi->height < 0)
+        fwk_display_add_damage(sprt_disp, sprt_bctl->x_start, y_first, sprt_bctl->x_start + width, y_last + 1);
+    else
+        fwk_display_add_damage(sprt_disp, sprt_bctl->x_start, (sprt_bctl->y_start >> 1) + height - y_last - 1, 
+                                sprt_bctl->x_start + width, (sprt_bctl->y_start >> 1) + height - y_first);
+
     sprt_bctl->x_next = x_pos;
     sprt_bctl->y_next = y_pos;
 
@@ -264,20 +271,17 @@ kint32_t fwk_display_bitmap(struct fwk_bmp_ctrl *sprt_bctl, const kuint8_t *imag
  * @param   y_start: base position in the y-direction
  * @param   image: ram address of bmp
  * @retval  none
- * @note    none
+ * @note    rows of bmp are aligned to 4 bytes
  */
 kssize_t fwk_display_whole_bitmap(struct fwk_bmp_ctrl *sprt_bctl, const kuint8_t *image)
 {
     struct fwk_disp_info *sprt_disp;
     struct fwk_bmp_info_header *sprt_bi;
+    struct fwk_blit_surface sgrt_dst, sgrt_src;
     kuint32_t x_start, y_start;
-    kint32_t image_offset;
+    kint32_t image_offset, format;
     kuint8_t *ptr_bitmap;
-
-    kuint32_t offset;
-    kuint32_t rgb_data, rgb_inc = 0;
-    kuint8_t image_bpp;
-    kuint32_t width, height, px_cnt, py_cnt, y_offset;
+    kuint32_t width, height, pitch;
 
     if ((!image) || 
         (!sprt_bctl) || 
@@ -303,41 +307,30 @@ kssize_t fwk_display_whole_bitmap(struct fwk_bmp_ctrl *sprt_bctl, const kuint8_t
         ((y_start + height) > sprt_disp->height))
         return -ER_MORE;
 
-    /*!< bytes of per pixel color (RGB24: bits = 24, bytes = 3) */
-    image_bpp = sprt_bi->pixelbit >> 3;
-
-    /*!< draw rgb pixel */
-    for (py_cnt = 0; py_cnt < height; py_cnt++)
+    format = fwk_blit_format_by_bpp(sprt_bi->pixelbit);
+    if ((format < 0) || fwk_display_surface(sprt_disp, &sgrt_dst))
+        return -ER_UNVALID;
+
+    /*!<
+     * if height > 0: the image scanning method is from left to right and from bottom to top; 
+     * Otherwise, it will be from left to right, from top to bottom 
+     */
+    pitch = mrt_align(width * fwk_blit_bytes_per_pixel(format), 4);
+    sgrt_src.buffer = ptr_bitmap;
+    sgrt_src.width = width;
+    sgrt_src.height = height;
+    sgrt_src.pitch = (kint32_t)pitch;
+    sgrt_src.format = format;
+
+    if (sprt_bi->height > 0)
     {
-        /*!<
-         * if height > 0: the image scanning method is from left to right and from bottom to top; 
-         * Otherwise, it will be from left to right, from top to bottom 
-         */
-        y_offset = (sprt_bi->height < 0) ? py_cnt : ((height - 1) - py_cnt);
-        offset = mrt_fwk_disp_advance_pos(x_start, y_start + y_offset, sprt_disp->width);
-
-        for (px_cnt = 0; px_cnt < width; px_cnt++)
-        {
-            rgb_data = 0;
-#if 0
-            for (kuint32_t p_cnt = 0; p_cnt < image_bpp; p_cnt++)
-            {
-                rgb_data <<= 8;
-                rgb_data  |= *(ptr_bitmap + rgb_inc + p_cnt);
-            }
-
-            /*!< reverse littile endian, for RGB24, such as: BGR <===> RGB */
-            rgb_data = fwk_pixel_rgbform_convert(sprt_bi->pixelbit, rgb_data);
-#else
-            kmemcpy(&rgb_data, ptr_bitmap + rgb_inc, image_bpp);
-#endif
-            rgb_data = mrt_fwk_disp_convert_rgb(sprt_bi->pixelbit, sprt_disp->bpp, rgb_data);
-            mrt_fwk_disp_write_pixel(sprt_disp->buffer, offset + px_cnt, sprt_disp->bpp, rgb_data);
-
-            rgb_inc += image_bpp;
-        }
+        sgrt_src.buffer = ptr_bitmap + (height - 1) * pitch;
+        sgrt_src.pitch = -(kint32_t)pitch;
     }
 
+    fwk_blit_copy(&sgrt_dst, x_start, y_start, &sgrt_src, 0, 0, width, height);
+    fwk_display_add_damage(sprt_disp, x_start, y_start, x_start + width, y_start + height);
+
     return (width * height * (sprt_disp->bpp >> 3));
 }
 
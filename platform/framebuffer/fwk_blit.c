@@ -0,0 +1,603 @@
+/*
+ * Display 2D Blit Engine
+ *
+ * File Name:   fwk_blit.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+#include <platform/video/fwk_blit.h>
+#include <platform/video/fwk_rgbmap.h>
+
+/*!< The defines */
+/*!< unaligned access to source image, such as bmp data which starts at offset 54 */
+struct fwk_blit_u16 { kuint16_t val; } __packed;
+struct fwk_blit_u32 { kuint32_t val; } __packed;
+
+#define FWK_BLIT_BYTES_RGB565                   (2)
+#define FWK_BLIT_BYTES_RGB888                   (3)
+#define FWK_BLIT_BYTES_ARGB8888                 (4)
+
+/*!< x / 255 for x <= 255 * 255, on two 8-bit channels at bit 0 and bit 16 */
+#define mrt_fwk_blit_div255x2(x)    \
+            ((((x) + 0x00800080 + (((x) >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff)
+
+/*!< The functions */
+/*!
+ * @brief   pixel accessors, all kernels work on argb8888 in register
+ * @param   ptr: pixel address
+ * @retval  argb8888 color
+ * @note    formats without alpha are read as opaque
+ */
+static inline __force_inline kuint32_t fwk_blit_read_RGB565(const kuint8_t *ptr)
+{
+    kuint32_t data = ((const struct fwk_blit_u16 *)ptr)->val;
+    kuint32_t r_data, g_data, b_data;
+
+    /*!< replicate high bits into the low ones, so that 0x1f expands to 0xff */
+    r_data = (data >> 11) & 0x1f;
+    g_data = (data >> 5) & 0x3f;
+    b_data = data & 0x1f;
+
+    r_data = (r_data << 3) | (r_data >> 2);
+    g_data = (g_data << 2) | (g_data >> 4);
+    b_data = (b_data << 3) | (b_data >> 2);
+
+    return 0xff000000 | (r_data << 16) | (g_data << 8) | b_data;
+}
+
+static inline __force_inline kuint32_t fwk_blit_read_RGB888(const kuint8_t *ptr)
+{
+    return 0xff000000 | ((kuint32_t)ptr[2] << 16) | ((kuint32_t)ptr[1] << 8) | ptr[0];
+}
+
+static inline __force_inline kuint32_t fwk_blit_read_ARGB8888(const kuint8_t *ptr)
+{
+    return ((const struct fwk_blit_u32 *)ptr)->val;
+}
+
+static inline __force_inline void fwk_blit_write_RGB565(kuint8_t *ptr, kuint32_t argb)
+{
+    ((struct fwk_blit_u16 *)ptr)->val = (kuint16_t)(((argb >> 8) & 0xf800) | ((argb >> 5) & 0x07e0) | ((argb >> 3) & 0x001f));
+}
+
+static inline __force_inline void fwk_blit_write_RGB888(kuint8_t *ptr, kuint32_t argb)
+{
+    ptr[0] = (kuint8_t)argb;
+    ptr[1] = (kuint8_t)(argb >> 8);
+    ptr[2] = (kuint8_t)(argb >> 16);
+}
+
+static inline __force_inline void fwk_blit_write_ARGB8888(kuint8_t *ptr, kuint32_t argb)
+{
+    ((struct fwk_blit_u32 *)ptr)->val = argb;
+}
+
+/*!
+ * @brief   source over destination
+ * @param   src, dst: argb8888
+ * @param   alpha: 0 ~ 255, already multiplied by alpha of source
+ * @retval  argb8888
+ * @note    red/blue and alpha/green are computed in pairs
+ */
+static inline __force_inline kuint32_t fwk_blit_blend_pixel(kuint32_t src, kuint32_t dst, kuint32_t alpha)
+{
+    kuint32_t rb, ag, inv = 0xff - alpha;
+
+    rb = (src & 0x00ff00ff) * alpha + (dst & 0x00ff00ff) * inv;
+    ag = (((src >> 8) & 0x000000ff) | 0x00ff0000) * alpha + ((dst >> 8) & 0x00ff00ff) * inv;
+
+    return mrt_fwk_blit_div255x2(rb) | (mrt_fwk_blit_div255x2(ag) << 8);
+}
+
+/*!
+ * @brief   copy bytes, with the widest access both pointers allow
+ * @param   dst, src, size
+ * @retval  none
+ * @note    memcpy of this system is byte-wise
+ */
+static void fwk_blit_copy_bytes(void *dst, const void *src, kusize_t size)
+{
+    kuint8_t *pd = (kuint8_t *)dst;
+    const kuint8_t *ps = (const kuint8_t *)src;
+    kuint32_t *wd;
+    const kuint32_t *ws;
+
+    if (!(((kuaddr_t)pd ^ (kuaddr_t)ps) & 0x3))
+    {
+        for (; size && ((kuaddr_t)pd & 0x3); size--)
+            *pd++ = *ps++;
+
+        wd = (kuint32_t *)pd;
+        ws = (const kuint32_t *)ps;
+
+        for (; size >= 16; size -= 16, wd += 4, ws += 4)
+        {
+            wd[0] = ws[0];
+            wd[1] = ws[1];
+            wd[2] = ws[2];
+            wd[3] = ws[3];
+        }
+
+        for (; size >= 4; size -= 4)
+            *wd++ = *ws++;
+
+        pd = (kuint8_t *)wd;
+        ps = (const kuint8_t *)ws;
+    }
+    else if (!(((kuaddr_t)pd ^ (kuaddr_t)ps) & 0x1))
+    {
+        if (size && ((kuaddr_t)pd & 0x1))
+        {
+            *pd++ = *ps++;
+            size--;
+        }
+
+        for (; size >= 2; size -= 2, pd += 2, ps += 2)
+            *(kuint16_t *)pd = *(const kuint16_t *)ps;
+    }
+
+    while (size--)
+        *pd++ = *ps++;
+}
+
+/*!
+ * @brief   fill kernels
+ * @param   dst, color: pixel value of destination format, count
+ * @retval  none
+ * @note    spans are filled by aligned words
+ */
+static void fwk_blit_fill_RGB565(void *dst, kuint32_t color, kuint32_t count)
+{
+    kuint16_t *pd = (kuint16_t *)dst;
+    kuint32_t *wd, pattern;
+
+    color &= 0xffff;
+    if (count && ((kuaddr_t)pd & 0x2))
+    {
+        *pd++ = (kuint16_t)color;
+        count--;
+    }
+
+    pattern = color | (color << 16);
+    wd = (kuint32_t *)pd;
+
+    for (; count >= 8; count -= 8, wd += 4)
+    {
+        wd[0] = pattern;
+        wd[1] = pattern;
+        wd[2] = pattern;
+        wd[3] = pattern;
+    }
+
+    for (; count >= 2; count -= 2)
+        *wd++ = pattern;
+
+    if (count)
+        *(kuint16_t *)wd = (kuint16_t)color;
+}
+
+static void fwk_blit_fill_RGB888(void *dst, kuint32_t color, kuint32_t count)
+{
+    kuint8_t *pd = (kuint8_t *)dst;
+    kuint32_t *wd, w0, w1, w2;
+
+    for (; count && ((kuaddr_t)pd & 0x3); count--, pd += FWK_BLIT_BYTES_RGB888)
+        fwk_blit_write_RGB888(pd, color);
+
+    /*!< 4 pixels are 3 words: BGRB GRBG RBGR */
+    color &= 0x00ffffff;
+    w0 = color | (color << 24);
+    w1 = (color >> 8) | (color << 16);
+    w2 = (color >> 16) | (color << 8);
+    wd = (kuint32_t *)pd;
+
+    for (; count >= 4; count -= 4, wd += 3)
+    {
+        wd[0] = w0;
+        wd[1] = w1;
+        wd[2] = w2;
+    }
+
+    for (pd = (kuint8_t *)wd; count; count--, pd += FWK_BLIT_BYTES_RGB888)
+        fwk_blit_write_RGB888(pd, color);
+}
+
+static void fwk_blit_fill_ARGB8888(void *dst, kuint32_t color, kuint32_t count)
+{
+    kuint32_t *wd = (kuint32_t *)dst;
+
+    for (; count >= 8; count -= 8, wd += 8)
+    {
+        wd[0] = color;
+        wd[1] = color;
+        wd[2] = color;
+        wd[3] = color;
+        wd[4] = color;
+        wd[5] = color;
+        wd[6] = color;
+        wd[7] = color;
+    }
+
+    while (count--)
+        *wd++ = color;
+}
+
+/*!
+ * @brief   copy kernels
+ * @param   dst, src, count
+ * @retval  none
+ * @note    same format is a plain copy; otherwise one kernel is built for each pair,
+ *          so that reading and writing are inlined and no format is checked per pixel
+ */
+static void fwk_blit_copy_RGB565_to_RGB565(void *dst, const void *src, kuint32_t count)
+{
+    fwk_blit_copy_bytes(dst, src, count * FWK_BLIT_BYTES_RGB565);
+}
+
+static void fwk_blit_copy_RGB888_to_RGB888(void *dst, const void *src, kuint32_t count)
+{
+    fwk_blit_copy_bytes(dst, src, count * FWK_BLIT_BYTES_RGB888);
+}
+
+static void fwk_blit_copy_ARGB8888_to_ARGB8888(void *dst, const void *src, kuint32_t count)
+{
+    fwk_blit_copy_bytes(dst, src, count * FWK_BLIT_BYTES_ARGB8888);
+}
+
+/*!< the most common case: 24bit bmp to 32bit framebuffer, 4 pixels are fetched as 3 words */
+static void fwk_blit_copy_RGB888_to_ARGB8888(void *dst, const void *src, kuint32_t count)
+{
+    const kuint8_t *ps = (const kuint8_t *)src;
+    kuint32_t *wd = (kuint32_t *)dst;
+    const kuint32_t *ws;
+    kuint32_t w0, w1, w2;
+
+    for (; count && ((kuaddr_t)ps & 0x3); count--, ps += FWK_BLIT_BYTES_RGB888)
+        *wd++ = fwk_blit_read_RGB888(ps);
+
+    for (ws = (const kuint32_t *)ps; count >= 4; count -= 4, ws += 3, wd += 4)
+    {
+        w0 = ws[0];
+        w1 = ws[1];
+        w2 = ws[2];
+
+        wd[0] = 0xff000000 | (w0 & 0x00ffffff);
+        wd[1] = 0xff000000 | (w0 >> 24) | ((w1 & 0x0000ffff) << 8);
+        wd[2] = 0xff000000 | (w1 >> 16) | ((w2 & 0x000000ff) << 16);
+        wd[3] = 0xff000000 | (w2 >> 8);
+    }
+
+    for (ps = (const kuint8_t *)ws; count; count--, ps += FWK_BLIT_BYTES_RGB888)
+        *wd++ = fwk_blit_read_RGB888(ps);
+}
+
+#define FWK_BLIT_DEFINE_COPY(sfmt, dfmt)   \
+    static void fwk_blit_copy_##sfmt##_to_##dfmt(void *dst, const void *src, kuint32_t count)   \
+    {   \
+        const kuint8_t *ps = (const kuint8_t *)src; \
+        kuint8_t *pd = (kuint8_t *)dst;  \
+        \
+        for (; count; count--, ps += FWK_BLIT_BYTES_##sfmt, pd += FWK_BLIT_BYTES_##dfmt)   \
+            fwk_blit_write_##dfmt(pd, fwk_blit_read_##sfmt(ps));   \
+    }
+
+FWK_BLIT_DEFINE_COPY(RGB565, RGB888)
+FWK_BLIT_DEFINE_COPY(RGB565, ARGB8888)
+FWK_BLIT_DEFINE_COPY(RGB888, RGB565)
+FWK_BLIT_DEFINE_COPY(ARGB8888, RGB565)
+FWK_BLIT_DEFINE_COPY(ARGB8888, RGB888)
+
+/*!
+ * @brief   blend kernels (source over)
+ * @param   dst, src, count
+ * @param   alpha: global alpha, multiplied by the alpha of each source pixel
+ * @retval  none
+ * @note    transparent pixels are skipped, opaque ones are stored directly
+ */
+#define FWK_BLIT_DEFINE_BLEND(sfmt, dfmt)  \
+    static void fwk_blit_blend_##sfmt##_to_##dfmt(void *dst, const void *src, kuint32_t count, kuint32_t alpha)    \
+    {   \
+        const kuint8_t *ps = (const kuint8_t *)src; \
+        kuint8_t *pd = (kuint8_t *)dst;  \
+        kuint32_t color, pa;    \
+        \
+        for (; count; count--, ps += FWK_BLIT_BYTES_##sfmt, pd += FWK_BLIT_BYTES_##dfmt)   \
+        {   \
+            color = fwk_blit_read_##sfmt(ps);   \
+            pa = (color >> 24) * alpha; \
+            pa = (pa + 1 + (pa >> 8)) >> 8; \
+            \
+            if (!pa)    \
+                continue;   \
+            \
+            if (pa != 0xff) \
+                color = fwk_blit_blend_pixel(color, fwk_blit_read_##dfmt(pd), pa);  \
+            \
+            fwk_blit_write_##dfmt(pd, color);   \
+        }   \
+    }
+
+FWK_BLIT_DEFINE_BLEND(RGB565, RGB565)
+FWK_BLIT_DEFINE_BLEND(RGB565, RGB888)
+FWK_BLIT_DEFINE_BLEND(RGB565, ARGB8888)
+FWK_BLIT_DEFINE_BLEND(RGB888, RGB565)
+FWK_BLIT_DEFINE_BLEND(RGB888, RGB888)
+FWK_BLIT_DEFINE_BLEND(RGB888, ARGB8888)
+FWK_BLIT_DEFINE_BLEND(ARGB8888, RGB565)
+FWK_BLIT_DEFINE_BLEND(ARGB8888, RGB888)
+FWK_BLIT_DEFINE_BLEND(ARGB8888, ARGB8888)
+
+/*!< The globals */
+static const fwk_blit_fill_t g_fwk_blit_fill_table[NR_FWK_BLIT_FORMAT_MAX] =
+{
+    [NR_FWK_BLIT_RGB565]    = fwk_blit_fill_RGB565,
+    [NR_FWK_BLIT_RGB888]    = fwk_blit_fill_RGB888,
+    [NR_FWK_BLIT_ARGB8888]  = fwk_blit_fill_ARGB8888,
+};
+
+static const fwk_blit_copy_t g_fwk_blit_copy_table[NR_FWK_BLIT_FORMAT_MAX][NR_FWK_BLIT_FORMAT_MAX] =
+{
+    [NR_FWK_BLIT_RGB565] =
+    {
+        [NR_FWK_BLIT_RGB565]    = fwk_blit_copy_RGB565_to_RGB565,
+        [NR_FWK_BLIT_RGB888]    = fwk_blit_copy_RGB565_to_RGB888,
+        [NR_FWK_BLIT_ARGB8888]  = fwk_blit_copy_RGB565_to_ARGB8888,
+    },
+
+    [NR_FWK_BLIT_RGB888] =
+    {
+        [NR_FWK_BLIT_RGB565]    = fwk_blit_copy_RGB888_to_RGB565,
+        [NR_FWK_BLIT_RGB888]    = fwk_blit_copy_RGB888_to_RGB888,
+        [NR_FWK_BLIT_ARGB8888]  = fwk_blit_copy_RGB888_to_ARGB8888,
+    },
+
+    [NR_FWK_BLIT_ARGB8888] =
+    {
+        [NR_FWK_BLIT_RGB565]    = fwk_blit_copy_ARGB8888_to_RGB565,
+        [NR_FWK_BLIT_RGB888]    = fwk_blit_copy_ARGB8888_to_RGB888,
+        [NR_FWK_BLIT_ARGB8888]  = fwk_blit_copy_ARGB8888_to_ARGB8888,
+    },
+};
+
+static const fwk_blit_blend_t g_fwk_blit_blend_table[NR_FWK_BLIT_FORMAT_MAX][NR_FWK_BLIT_FORMAT_MAX] =
+{
+    [NR_FWK_BLIT_RGB565] =
+    {
+        [NR_FWK_BLIT_RGB565]    = fwk_blit_blend_RGB565_to_RGB565,
+        [NR_FWK_BLIT_RGB888]    = fwk_blit_blend_RGB565_to_RGB888,
+        [NR_FWK_BLIT_ARGB8888]  = fwk_blit_blend_RGB565_to_ARGB8888,
+    },
+
+    [NR_FWK_BLIT_RGB888] =
+    {
+        [NR_FWK_BLIT_RGB565]    = fwk_blit_blend_RGB888_to_RGB565,
+        [NR_FWK_BLIT_RGB888]    = fwk_blit_blend_RGB888_to_RGB888,
+        [NR_FWK_BLIT_ARGB8888]  = fwk_blit_blend_RGB888_to_ARGB8888,
+    },
+
+    [NR_FWK_BLIT_ARGB8888] =
+    {
+        [NR_FWK_BLIT_RGB565]    = fwk_blit_blend_ARGB8888_to_RGB565,
+        [NR_FWK_BLIT_RGB888]    = fwk_blit_blend_ARGB8888_to_RGB888,
+        [NR_FWK_BLIT_ARGB8888]  = fwk_blit_blend_ARGB8888_to_ARGB8888,
+    },
+};
+
+/*!
+ * @brief   clip one area against a surface
+ * @param   sprt_surf, x, y
+ * @param   width, height: in/out
+ * @retval  0 if nothing is left
+ * @note    none
+ */
+static kbool_t fwk_blit_clip(struct fwk_blit_surface *sprt_surf, kuint32_t x, kuint32_t y,
+                                                kuint32_t *width, kuint32_t *height)
+{
+    if ((x >= sprt_surf->width) || (y >= sprt_surf->height))
+        return false;
+
+    *width = CMP_MIN2(*width, sprt_surf->width - x);
+    *height = CMP_MIN2(*height, sprt_surf->height - y);
+
+    return (*width && *height);
+}
+
+/*!< API function */
+/*!
+ * @brief   get format by bits of pixel
+ * @param   bpp: 16/24/32
+ * @retval  format, or errno
+ * @note    24 is packed RGB888; framebuffer stores it in 32 bits, see mrt_fwk_disp_bpp_get
+ */
+kint32_t fwk_blit_format_by_bpp(kuint32_t bpp)
+{
+    switch (bpp)
+    {
+        case FWK_RGB_PIXEL16:
+            return NR_FWK_BLIT_RGB565;
+        case FWK_RGB_PIXEL24:
+            return NR_FWK_BLIT_RGB888;
+        case FWK_RGB_PIXEL32:
+            return NR_FWK_BLIT_ARGB8888;
+        default:
+            return -ER_UNVALID;
+    }
+}
+
+/*!
+ * @brief   convert argb8888 color to pixel value of format
+ * @param   format, argb
+ * @retval  pixel value, used by fwk_blit_fill
+ * @note    none
+ */
+kuint32_t fwk_blit_pack_color(kuint32_t format, kuint32_t argb)
+{
+    kuint32_t color = 0;
+
+    switch (format)
+    {
+        case NR_FWK_BLIT_RGB565:
+            fwk_blit_write_RGB565((kuint8_t *)&color, argb);
+            return color;
+        case NR_FWK_BLIT_RGB888:
+            return argb & 0x00ffffff;
+        default:
+            return argb;
+    }
+}
+
+/*!
+ * @brief   get span kernels
+ * @param   format(s)
+ * @retval  kernel, or nullptr if format is unknown
+ * @note    for callers which draw spans of their own
+ */
+fwk_blit_fill_t fwk_blit_get_fill(kuint32_t format)
+{
+    return (format < NR_FWK_BLIT_FORMAT_MAX) ? g_fwk_blit_fill_table[format] : mrt_nullptr;
+}
+
+fwk_blit_copy_t fwk_blit_get_copy(kuint32_t src_format, kuint32_t dst_format)
+{
+    if ((src_format >= NR_FWK_BLIT_FORMAT_MAX) || (dst_format >= NR_FWK_BLIT_FORMAT_MAX))
+        return mrt_nullptr;
+
+    return g_fwk_blit_copy_table[src_format][dst_format];
+}
+
+fwk_blit_blend_t fwk_blit_get_blend(kuint32_t src_format, kuint32_t dst_format)
+{
+    if ((src_format >= NR_FWK_BLIT_FORMAT_MAX) || (dst_format >= NR_FWK_BLIT_FORMAT_MAX))
+        return mrt_nullptr;
+
+    return g_fwk_blit_blend_table[src_format][dst_format];
+}
+
+/*!
+ * @brief   fill a rectangle
+ * @param   sprt_dst: destination surface
+ * @param   x, y, width, height: area, clipped by surface
+ * @param   color: pixel value of destination format (see fwk_blit_pack_color)
+ * @retval  errno
+ * @note    none
+ */
+kint32_t fwk_blit_fill(struct fwk_blit_surface *sprt_dst, kuint32_t x, kuint32_t y,
+                            kuint32_t width, kuint32_t height, kuint32_t color)
+{
+    fwk_blit_fill_t fill;
+    kuint8_t *pd;
+
+    if (!sprt_dst || !sprt_dst->buffer)
+        return -ER_NULLPTR;
+
+    fill = fwk_blit_get_fill(sprt_dst->format);
+    if (!fill)
+        return -ER_UNVALID;
+
+    if (!fwk_blit_clip(sprt_dst, x, y, &width, &height))
+        return ER_NORMAL;
+
+    pd = (kuint8_t *)fwk_blit_pixel_addr(sprt_dst, x, y);
+
+    /*!< rows are adjacent: the whole area is one span */
+    if (width == sprt_dst->width &&
+        sprt_dst->pitch == (kint32_t)(width * fwk_blit_bytes_per_pixel(sprt_dst->format)))
+    {
+        fill(pd, color, width * height);
+        return ER_NORMAL;
+    }
+
+    for (; height; height--, pd += sprt_dst->pitch)
+        fill(pd, color, width);
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   copy a rectangle, converting pixel format
+ * @param   sprt_dst, dx, dy: destination
+ * @param   sprt_src, sx, sy: source
+ * @param   width, height: area, clipped by both surfaces
+ * @retval  errno
+ * @note    surfaces must not overlap
+ */
+kint32_t fwk_blit_copy(struct fwk_blit_surface *sprt_dst, kuint32_t dx, kuint32_t dy,
+                            struct fwk_blit_surface *sprt_src, kuint32_t sx, kuint32_t sy, kuint32_t width, kuint32_t height)
+{
+    fwk_blit_copy_t copy;
+    kuint8_t *pd;
+    const kuint8_t *ps;
+
+    if (!sprt_dst || !sprt_src || !sprt_dst->buffer || !sprt_src->buffer)
+        return -ER_NULLPTR;
+
+    copy = fwk_blit_get_copy(sprt_src->format, sprt_dst->format);
+    if (!copy)
+        return -ER_UNVALID;
+
+    if (!fwk_blit_clip(sprt_src, sx, sy, &width, &height) ||
+        !fwk_blit_clip(sprt_dst, dx, dy, &width, &height))
+        return ER_NORMAL;
+
+    pd = (kuint8_t *)fwk_blit_pixel_addr(sprt_dst, dx, dy);
+    ps = (const kuint8_t *)fwk_blit_pixel_addr(sprt_src, sx, sy);
+
+    for (; height; height--, pd += sprt_dst->pitch, ps += sprt_src->pitch)
+        copy(pd, ps, width);
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   blend a rectangle onto destination (source over)
+ * @param   sprt_dst, dx, dy: destination
+ * @param   sprt_src, sx, sy: source
+ * @param   width, height: area, clipped by both surfaces
+ * @param   alpha: global alpha, 0 ~ 255
+ * @retval  errno
+ * @note    the alpha of argb8888 source is applied per pixel;
+ *          opaque source without alpha falls back to copy
+ */
+kint32_t fwk_blit_blend(struct fwk_blit_surface *sprt_dst, kuint32_t dx, kuint32_t dy,
+                            struct fwk_blit_surface *sprt_src, kuint32_t sx, kuint32_t sy,
+                            kuint32_t width, kuint32_t height, kuint32_t alpha)
+{
+    fwk_blit_blend_t blend;
+    kuint8_t *pd;
+    const kuint8_t *ps;
+
+    if (!sprt_dst || !sprt_src || !sprt_dst->buffer || !sprt_src->buffer)
+        return -ER_NULLPTR;
+
+    alpha = CMP_MIN2(alpha, FWK_BLIT_ALPHA_OPAQUE);
+    if (!alpha)
+        return ER_NORMAL;
+
+    if ((alpha == FWK_BLIT_ALPHA_OPAQUE) && (sprt_src->format != NR_FWK_BLIT_ARGB8888))
+        return fwk_blit_copy(sprt_dst, dx, dy, sprt_src, sx, sy, width, height);
+
+    blend = fwk_blit_get_blend(sprt_src->format, sprt_dst->format);
+    if (!blend)
+        return -ER_UNVALID;
+
+    if (!fwk_blit_clip(sprt_src, sx, sy, &width, &height) ||
+        !fwk_blit_clip(sprt_dst, dx, dy, &width, &height))
+        return ER_NORMAL;
+
+    pd = (kuint8_t *)fwk_blit_pixel_addr(sprt_dst, dx, dy);
+    ps = (const kuint8_t *)fwk_blit_pixel_addr(sprt_src, sx, sy);
+
+    for (; height; height--, pd += sprt_dst->pitch, ps += sprt_src->pitch)
+        blend(pd, ps, width, alpha);
+
+    return ER_NORMAL;
+}
+
+/*!< end of file */
@@ -15,15 +15,159 @@
 #include <platform/video/fwk_disp.h>
 #include <platform/video/fwk_rgbmap.h>
 #include <platform/video/fwk_font.h>
+#include <platform/video/fwk_glyph.h>
 #include <kernel/kernel.h>
 #include <kernel/mutex.h>
+#include <kernel/spinlock.h>
 
 /*!< The defines */
+#define mrt_fwk_disp_rect_touch(a, b)   \
+            (((a)->x_start <= (b)->x_end) && ((b)->x_start <= (a)->x_end) && \
+             ((a)->y_start <= (b)->y_end) && ((b)->y_start <= (a)->y_end))
+#define mrt_fwk_disp_rect_area(a)       (((a)->x_end - (a)->x_start) * ((a)->y_end - (a)->y_start))
 
 /*!< The globals */
 struct video_params *sprt_fwk_video_params;
 
+/*!< The functions */
+/*!
+ * @brief   expand rectangle to cover another one
+ * @param   sprt_rect, sprt_other
+ * @retval  none
+ * @note    none
+ */
+static void fwk_display_rect_union(struct fwk_disp_rect *sprt_rect, struct fwk_disp_rect *sprt_other)
+{
+    sprt_rect->x_start = CMP_MIN2(sprt_rect->x_start, sprt_other->x_start);
+    sprt_rect->y_start = CMP_MIN2(sprt_rect->y_start, sprt_other->y_start);
+    sprt_rect->x_end = CMP_MAX2(sprt_rect->x_end, sprt_other->x_end);
+    sprt_rect->y_end = CMP_MAX2(sprt_rect->y_end, sprt_other->y_end);
+}
+
 /*!< API function */
+/*!
+ * @brief   record a drawn area
+ * @param   sprt_disp: screen information
+ * @param   x_start, x_end: x-direction position (x_end is excluded)
+ * @param   y_start, y_end: y-direction position (y_end is excluded)
+ * @retval  none
+ * @note    areas are kept disjoint: a new one absorbs every area it overlaps or touches;
+ *          if the list is full, it absorbs the area which adds the least extra pixels
+ */
+void fwk_display_add_damage(struct fwk_disp_info *sprt_disp, kuint32_t x_start, kuint32_t y_start, 
+                            kuint32_t x_end, kuint32_t y_end)
+{
+    struct fwk_disp_rect sgrt_rect, sgrt_union, *sprt_rect;
+    kuint32_t idx, best, cost, best_cost;
+
+    sgrt_rect.x_start = CMP_MIN2(x_start, sprt_disp->width);
+    sgrt_rect.y_start = CMP_MIN2(y_start, sprt_disp->height);
+    sgrt_rect.x_end = CMP_MIN2(x_end, sprt_disp->width);
+    sgrt_rect.y_end = CMP_MIN2(y_end, sprt_disp->height);
+
+    if ((sgrt_rect.x_start >= sgrt_rect.x_end) || (sgrt_rect.y_start >= sgrt_rect.y_end))
+        return;
+
+    spin_lock(&sprt_disp->sgrt_damage_lock);
+
+    for (idx = 0; idx < sprt_disp->num_damage; )
+    {
+        sprt_rect = &sprt_disp->sgrt_damage[idx];
+        if (mrt_fwk_disp_rect_touch(sprt_rect, &sgrt_rect))
+        {
+            /*!< absorb it, and check again from the beginning, since the area has grown */
+            fwk_display_rect_union(&sgrt_rect, sprt_rect);
+            *sprt_rect = sprt_disp->sgrt_damage[--sprt_disp->num_damage];
+            idx = 0;
+            continue;
+        }
+
+        if ((++idx < sprt_disp->num_damage) || (sprt_disp->num_damage < FWK_DISP_DAMAGE_MAX))
+            continue;
+
+        /*!< list is full, fold the cheapest one, and scan again */
+        best = 0;
+        best_cost = (kuint32_t)-1;
+        for (idx = 0; idx < sprt_disp->num_damage; idx++)
+        {
+            sgrt_union = sgrt_rect;
+            fwk_display_rect_union(&sgrt_union, &sprt_disp->sgrt_damage[idx]);
+            cost = mrt_fwk_disp_rect_area(&sgrt_union) - mrt_fwk_disp_rect_area(&sprt_disp->sgrt_damage[idx]);
+            if (cost < best_cost)
+            {
+                best = idx;
+                best_cost = cost;
+            }
+        }
+
+        fwk_display_rect_union(&sgrt_rect, &sprt_disp->sgrt_damage[best]);
+        sprt_disp->sgrt_damage[best] = sprt_disp->sgrt_damage[--sprt_disp->num_damage];
+        idx = 0;
+    }
+
+    sprt_disp->sgrt_damage[sprt_disp->num_damage++] = sgrt_rect;
+
+    spin_unlock(&sprt_disp->sgrt_damage_lock);
+}
+
+/*!
+ * @brief  copy damaged areas to deactive screen
+ * @param  sprt_disp
+ * @param  size: bytes of each framebuffer that may be touched
+ * @retval bytes copied
+ * @note   only areas recorded since the last sync are copied, and the record is cleared;
+ *         areas spanning whole lines are copied with one memcpy
+ */
+kusize_t fwk_display_frame_sync(struct fwk_disp_info *sprt_disp, kusize_t size)
+{
+    struct fwk_disp_rect sgrt_damage[FWK_DISP_DAMAGE_MAX];
+    struct fwk_disp_rect *sprt_rect;
+    kuint32_t num_damage, idx, y_cnt;
+    kuint32_t bytes_per_pixel, pitch, lenth, offset;
+    kusize_t copied = 0;
+
+    spin_lock(&sprt_disp->sgrt_damage_lock);
+    num_damage = sprt_disp->num_damage;
+    memcpy(sgrt_damage, sprt_disp->sgrt_damage, num_damage * sizeof(*sprt_rect));
+    sprt_disp->num_damage = 0;
+    spin_unlock(&sprt_disp->sgrt_damage_lock);
+
+    if ((!sprt_disp->buffer_bak) || (sprt_disp->buffer_bak == sprt_disp->buffer))
+        return 0;
+
+    bytes_per_pixel = mrt_fwk_disp_bpp_get(sprt_disp->bpp) >> 3;
+    pitch = sprt_disp->width * bytes_per_pixel;
+
+    for (idx = 0; idx < num_damage; idx++)
+    {
+        sprt_rect = &sgrt_damage[idx];
+        offset = mrt_fwk_disp_advance_pos(sprt_rect->x_start, sprt_rect->y_start, sprt_disp->width) * bytes_per_pixel;
+        lenth = (sprt_rect->x_end - sprt_rect->x_start) * bytes_per_pixel;
+
+        if (lenth == pitch)
+        {
+            lenth *= (sprt_rect->y_end - sprt_rect->y_start);
+            if ((offset + lenth) > size)
+                lenth = (offset < size) ? (size - offset) : 0;
+
+            memcpy(sprt_disp->buffer_bak + offset, sprt_disp->buffer + offset, lenth);
+            copied += lenth;
+            continue;
+        }
+
+        for (y_cnt = sprt_rect->y_start; y_cnt < sprt_rect->y_end; y_cnt++, offset += pitch)
+        {
+            if ((offset + lenth) > size)
+                break;
+
+            memcpy(sprt_disp->buffer_bak + offset, sprt_disp->buffer + offset, lenth);
+            copied += lenth;
+        }
+    }
+
+    return copied;
+}
+
 /*!
  * @brief   convert rgb between rgb565 and rgb888
  * @param   srctype: current format
@@ -130,6 +274,9 @@ void fwk_display_write_straight_line(struct fwk_disp_info *sprt_disp, kuint32_t
     /*!< initialize err */
 	distance_err = (-distance_max);
 
+    fwk_display_add_damage(sprt_disp, CMP_MIN2(x_start, x_end), CMP_MIN2(y_start, y_end), 
+                                    CMP_MAX2(x_start, x_end) + 1, CMP_MAX2(y_start, y_end) + 1);
+
     mutex_lock(&sprt_disp->sgrt_lock);
 
     /*!< draw line */
@@ -190,9 +337,8 @@ void fwk_display_write_rectangle(struct fwk_disp_info *sprt_disp, kuint32_t x_st
 void fwk_display_fill_rectangle(struct fwk_disp_info *sprt_disp, kuint32_t x_start, kuint32_t y_start, 
                                                     kuint32_t x_end, kuint32_t y_end, kuint32_t data)
 {
-    kuint32_t offset;
-    kuint32_t x_cnt, y_cnt, width, height, xy_temp;
-    kuint8_t pixelbits;
+    struct fwk_blit_surface sgrt_surf;
+    kuint32_t xy_temp;
     kuint32_t rgb_data;
 
     if ((x_start > sprt_disp->width) || (y_start > sprt_disp->height) || 
@@ -213,29 +359,16 @@ void fwk_display_fill_rectangle(struct fwk_disp_info *sprt_disp, kuint32_t x_sta
         y_start = xy_temp;
     }
 
-    width  = mrt_usub(x_end, x_start);
-    height = mrt_usub(y_end, y_start);
+    if (fwk_display_surface(sprt_disp, &sgrt_surf))
+        return;
 
-    pixelbits = mrt_fwk_disp_bpp_get(sprt_disp->bpp);
-    rgb_data  = mrt_fwk_disp_convert_rgb(FWK_RGB_PIXELBIT, pixelbits, data);
+    rgb_data = mrt_fwk_disp_convert_rgb(FWK_RGB_PIXELBIT, mrt_fwk_disp_bpp_get(sprt_disp->bpp), data);
 
     mutex_lock(&sprt_disp->sgrt_lock);
-
-    for (y_cnt = 0; y_cnt < height; y_cnt++)
-    {
-        offset = mrt_fwk_disp_advance_pos(x_start, y_start + y_cnt, sprt_disp->width);
-
-        if ((pixelbits == FWK_RGB_PIXEL24) ||
-            (pixelbits == FWK_RGB_PIXEL32))
-            memset_ex(sprt_disp->buffer + (offset << 2), rgb_data, (width << 2));
-        else
-        {
-            for (x_cnt = 0; x_cnt < width; x_cnt++)
-                mrt_fwk_disp_write_pixel(sprt_disp->buffer, x_cnt + offset, pixelbits, rgb_data);
-        }
-    }
-
+    fwk_blit_fill(&sgrt_surf, x_start, y_start, mrt_usub(x_end, x_start), mrt_usub(y_end, y_start), rgb_data);
     mutex_unlock(&sprt_disp->sgrt_lock);
+
+    fwk_display_add_damage(sprt_disp, x_start, y_start, x_end, y_end);
 }
 
 /*!
@@ -247,13 +380,19 @@ void fwk_display_fill_rectangle(struct fwk_disp_info *sprt_disp, kuint32_t x_sta
  */
 void fwk_display_clear(struct fwk_disp_info *sprt_disp, kuint32_t data)
 {
+    struct fwk_blit_surface sgrt_surf;
     kuint8_t pixelbits;
     kuint32_t rgb_data;
 
     pixelbits = mrt_fwk_disp_bpp_get(sprt_disp->bpp);
     rgb_data  = mrt_fwk_disp_convert_rgb(FWK_RGB_PIXELBIT, pixelbits, data);
 
-    memset_ex(sprt_disp->buffer, rgb_data, sprt_disp->buf_size);
+    if (!fwk_display_surface(sprt_disp, &sgrt_surf))
+        fwk_blit_fill(&sgrt_surf, 0, 0, sgrt_surf.width, sgrt_surf.height, rgb_data);
+    else
+        memset_ex(sprt_disp->buffer, rgb_data, sprt_disp->buf_size);
+
+    fwk_display_damage_all(sprt_disp);
 }
 
 /*!
@@ -350,8 +489,11 @@ static kusize_t __fwk_display_dot_matrix_word(struct fwk_disp_ctrl *sprt_dctrl,
     kuint8_t *ptr_ch, *ptr_dmatx;
     kuint32_t x_pos, y_pos;
     kuint32_t flib_index;
-    kuint32_t x_cnt, y_cnt, x_data, x_inc, byte_cnt, arr_inc;
+    kuint32_t x_inc;
     kuint32_t x_end, y_end;
+    struct fwk_blit_surface sgrt_surf;
+    struct fwk_glyph_key sgrt_key;
+    struct fwk_disp_rect sgrt_damage = { .x_start = (kuint32_t)-1, .y_start = (kuint32_t)-1 };
 
     if ((!fmt) || (!sprt_dctrl))
         return 0;
@@ -359,6 +501,14 @@ static kusize_t __fwk_display_dot_matrix_word(struct fwk_disp_ctrl *sprt_dctrl,
     sprt_disp = sprt_dctrl->sprt_di;
     sprt_settings = &sprt_dctrl->sgrt_set;
 
+    if (fwk_display_surface(sprt_disp, &sgrt_surf))
+        return 0;
+
+    /*!< glyphs are rendered once per color, and then copied as spans */
+    sgrt_key.size = sprt_settings->size;
+    sgrt_key.format = sgrt_surf.format;
+    sgrt_key.color = mrt_fwk_disp_convert_rgb(FWK_RGB_PIXELBIT, mrt_fwk_disp_bpp_get(sprt_disp->bpp), sprt_settings->color);
+
     x_pos  = sprt_dctrl->x_next;
     y_pos  = sprt_dctrl->y_next;
     x_end  = sprt_dctrl->x_end;
@@ -427,30 +577,26 @@ static kusize_t __fwk_display_dot_matrix_word(struct fwk_disp_ctrl *sprt_dctrl,
         if (!ptr_dmatx)
             continue;
 
-        arr_inc = x_inc >> 3;
-        mutex_lock(&sprt_disp->sgrt_lock);
+        sgrt_key.font = (flib_index > ASCII_MAX) ? sprt_settings->ptr_hz : sprt_settings->ptr_ascii;
+        sgrt_key.code = flib_index;
+        sgrt_key.width = x_inc;
 
-        /*!< draw pixel points */
-        for (y_cnt = 0; y_cnt < sprt_settings->size; y_cnt++)
-        {
-            for (byte_cnt = 0; byte_cnt < arr_inc; byte_cnt++)
-            {
-                x_data = *(ptr_dmatx + byte_cnt + y_cnt * (arr_inc));
-
-                for (x_cnt = 0; x_cnt < 8; x_cnt++)
-                {
-                    if (x_data & 0x80)
-                        fwk_display_write_point(sprt_disp, x_pos + (byte_cnt << 3) + x_cnt, y_pos + y_cnt, sprt_settings->color);
+        mutex_lock(&sprt_disp->sgrt_lock);
+        sgrt_surf.buffer = sprt_disp->buffer;
+        fwk_glyph_draw(&sgrt_surf, x_pos, y_pos, &sgrt_key, ptr_dmatx);
+        mutex_unlock(&sprt_disp->sgrt_lock);
 
-                    x_data <<= 1;
-                }
-            }
-        }
+        /*!< one area for the whole string, instead of one per character */
+        sgrt_damage.x_start = CMP_MIN2(sgrt_damage.x_start, x_pos);
+        sgrt_damage.y_start = CMP_MIN2(sgrt_damage.y_start, y_pos);
+        sgrt_damage.x_end = CMP_MAX2(sgrt_damage.x_end, x_pos + x_inc);
+        sgrt_damage.y_end = CMP_MAX2(sgrt_damage.y_end, y_pos + sprt_settings->size);
 
-        mutex_unlock(&sprt_disp->sgrt_lock);
         x_pos += (x_inc + sprt_settings->word_spacing);
     }
 
+    fwk_display_add_damage(sprt_disp, sgrt_damage.x_start, sgrt_damage.y_start, sgrt_damage.x_end, sgrt_damage.y_end);
+
     sprt_dctrl->x_next = x_pos;
     sprt_dctrl->y_next = y_pos;
 
@@ -506,8 +652,10 @@ void fwk_display_ctrl_init(struct fwk_disp_info *sprt_disp, void *fbuffer,
     sprt_disp->width = width;
     sprt_disp->height = height;
     sprt_disp->bpp = bpp;
+    sprt_disp->num_damage = 0;
 
     mutex_init(&sprt_disp->sgrt_lock);
+    spin_lock_init(&sprt_disp->sgrt_damage_lock);
 }
 
 /*!< end of file */
@@ -172,6 +172,88 @@ struct fwk_fb_info *fwk_file_fb_info(struct fwk_file *sprt_file)
     return sgrt_fwk_registered_fb[fbidx];
 }
 
+/*!
+ * @brief   pan the visual screen inside the virtual screen
+ * @param   sprt_info, sprt_var: only xoffset and yoffset are used
+ * @retval  errno
+ * @note    the new position is latched by hardware at the next frame, 
+ *          call fwk_fb_wait_vsync() before drawing into the old area
+ */
+kint32_t fwk_fb_pan_display(struct fwk_fb_info *sprt_info, struct fwk_fb_var_screen_info *sprt_var)
+{
+    struct fwk_fb_var_screen_info *sprt_cur;
+    kuint32_t xres_virtual, yres_virtual;
+    kint32_t retval;
+
+    if (!isValid(sprt_info) || !sprt_var)
+        return -ER_NULLPTR;
+
+    if (!sprt_info->sprt_fbops->fb_pan_display)
+        return -ER_UNVALID;
+
+    sprt_cur = &sprt_info->sgrt_var;
+    xres_virtual = CMP_MAX2(sprt_cur->xres_virtual, sprt_cur->xres);
+    yres_virtual = CMP_MAX2(sprt_cur->yres_virtual, sprt_cur->yres);
+
+    if (((sprt_var->xoffset + sprt_cur->xres) > xres_virtual) ||
+        ((sprt_var->yoffset + sprt_cur->yres) > yres_virtual))
+        return -ER_MORE;
+
+    if ((sprt_var->xoffset == sprt_cur->xoffset) && (sprt_var->yoffset == sprt_cur->yoffset))
+        return ER_NORMAL;
+
+    retval = sprt_info->sprt_fbops->fb_pan_display(sprt_info, sprt_var);
+    if (retval)
+        return retval;
+
+    sprt_cur->xoffset = sprt_var->xoffset;
+    sprt_cur->yoffset = sprt_var->yoffset;
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   wait for vertical blanking
+ * @param   sprt_info, timeout: unit: ms, 0 means wait forever
+ * @retval  errno
+ * @note    none
+ */
+kint32_t fwk_fb_wait_vsync(struct fwk_fb_info *sprt_info, kuint32_t timeout)
+{
+    if (!isValid(sprt_info))
+        return -ER_NULLPTR;
+
+    if (!sprt_info->sprt_fbops->fb_wait_vsync)
+        return -ER_UNVALID;
+
+    return sprt_info->sprt_fbops->fb_wait_vsync(sprt_info, timeout);
+}
+
+/*!
+ * @brief   get a buffer to draw the next frame in
+ * @param   sprt_info, yoffset: output
+ * @retval  errno
+ * @note    without multi-buffer support of driver, the one not on screen is returned
+ */
+kint32_t fwk_fb_get_free_buffer(struct fwk_fb_info *sprt_info, kuint32_t *yoffset)
+{
+    struct fwk_fb_var_screen_info *sprt_var;
+
+    if (!isValid(sprt_info) || !yoffset)
+        return -ER_NULLPTR;
+
+    if (sprt_info->sprt_fbops->fb_get_free_buffer)
+        return sprt_info->sprt_fbops->fb_get_free_buffer(sprt_info, yoffset);
+
+    sprt_var = &sprt_info->sgrt_var;
+    if (sprt_var->yres_virtual < (sprt_var->yres << 1))
+        return -ER_UNVALID;
+
+    *yoffset = sprt_var->yoffset ? 0 : sprt_var->yres;
+
+    return ER_NORMAL;
+}
+
 /*!< ------------------------------------------------------------------------- */
 /*!< Frambuffer driver Interface */
 /*!< The globals */
@@ -262,6 +344,8 @@ static kint32_t fwk_fb_ioctl(struct fwk_file *sprt_file, kuint32_t cmd, kuaddr_t
     struct fwk_fb_fix_screen_info sgrt_fix;
     struct fwk_fb_var_screen_info sgrt_var;
     kuint8_t *ptr_user;
+    struct fwk_fb_flip_stats sgrt_stats;
+    kuint32_t timeout;
     kint32_t retval = 0;
 
     sprt_info = (struct fwk_fb_info *)sprt_file->private_data;
@@ -303,6 +387,47 @@ static kint32_t fwk_fb_ioctl(struct fwk_file *sprt_file, kuint32_t cmd, kuaddr_t
             
             break;
 
+        case NR_FB_IOPAN_DISPLAY:
+            retval = fwk_copy_from_user(&sgrt_var, ptr_user, sizeof(sgrt_var));
+            if (!retval)
+                return -ER_FAILD;
+
+            retval = fwk_fb_pan_display(sprt_info, &sgrt_var);
+            break;
+
+        case NR_FB_IOWAIT_VSYNC:
+            retval = fwk_copy_from_user(&timeout, ptr_user, sizeof(timeout));
+            if (!retval)
+                return -ER_FAILD;
+
+            retval = fwk_fb_wait_vsync(sprt_info, timeout);
+            break;
+
+        case NR_FB_IOGET_FREEBUF:
+            retval = fwk_fb_get_free_buffer(sprt_info, &timeout);
+            if (retval)
+                return retval;
+
+            retval = fwk_copy_to_user(ptr_user, &timeout, sizeof(timeout));
+            if (!retval)
+                return -ER_FAILD;
+
+            break;
+
+        case NR_FB_IOGET_FLIPSTAT:
+            if (!sprt_info->sprt_fbops->fb_get_flip_stats)
+                return -ER_UNVALID;
+
+            retval = sprt_info->sprt_fbops->fb_get_flip_stats(sprt_info, &sgrt_stats);
+            if (retval)
+                return retval;
+
+            retval = fwk_copy_to_user(ptr_user, &sgrt_stats, sizeof(sgrt_stats));
+            if (!retval)
+                return -ER_FAILD;
+
+            break;
+
         default:
             retval = -ER_UNVALID;
             break;
@@ -345,9 +470,60 @@ static kint32_t fwk_fb_mmap(struct fwk_file *sprt_file, struct fwk_vm_area *vm_a
     vm_area->size = sprt_info->sgrt_fix.smem_len;
     vm_area->virt_addr = sprt_info->sgrt_fix.smem_start + offset;
 
+    /*!< only written by cpu and scanned out by lcd controller */
+    vm_area->mem_type = NR_FWK_VM_WC;
+
     return ER_NORMAL;
 }
 
+/*!
+ * @brief   fwk_fb_pread
+ * @param   sprt_file, ptr_buf, size
+ * @param   offset: byte offset in framebuffer memory
+ * @retval  size read (truncated at the end of framebuffer), or errno
+ * @note    none
+ */
+static kssize_t fwk_fb_pread(struct fwk_file *sprt_file, kbuffer_t *ptr_buf, kssize_t size, kuint32_t offset)
+{
+    struct fwk_fb_info *sprt_info;
+
+    sprt_info = (struct fwk_fb_info *)sprt_file->private_data;
+    if (!isValid(sprt_info))
+        return -ER_NODEV;
+
+    if ((size < 0) || (offset >= sprt_info->sgrt_fix.smem_len))
+        return -ER_MORE;
+
+    size = mrt_ret_min2(size, (kssize_t)(sprt_info->sgrt_fix.smem_len - offset));
+    fwk_copy_to_user(ptr_buf, (void *)(sprt_info->sgrt_fix.smem_start + offset), size);
+
+    return size;
+}
+
+/*!
+ * @brief   fwk_fb_pwrite
+ * @param   sprt_file, ptr_buf, size
+ * @param   offset: byte offset in framebuffer memory
+ * @retval  size written (truncated at the end of framebuffer), or errno
+ * @note    none
+ */
+static kssize_t fwk_fb_pwrite(struct fwk_file *sprt_file, const kbuffer_t *ptr_buf, kssize_t size, kuint32_t offset)
+{
+    struct fwk_fb_info *sprt_info;
+
+    sprt_info = (struct fwk_fb_info *)sprt_file->private_data;
+    if (!isValid(sprt_info))
+        return -ER_NODEV;
+
+    if ((size < 0) || (offset >= sprt_info->sgrt_fix.smem_len))
+        return -ER_MORE;
+
+    size = mrt_ret_min2(size, (kssize_t)(sprt_info->sgrt_fix.smem_len - offset));
+    fwk_copy_from_user((void *)(sprt_info->sgrt_fix.smem_start + offset), ptr_buf, size);
+
+    return size;
+}
+
 static struct fwk_file_oprts sgrt_fwk_fb_foprts =
 {
     .open	= fwk_fb_open,
@@ -356,6 +532,8 @@ static struct fwk_file_oprts sgrt_fwk_fb_foprts =
     .read	= fwk_fb_read,
     .unlocked_ioctl	= fwk_fb_ioctl,
     .mmap	= fwk_fb_mmap,
+    .pread	= fwk_fb_pread,
+    .pwrite	= fwk_fb_pwrite,
 };
 
 /*!
@@ -0,0 +1,335 @@
+/*
+ * Display Glyph Cache
+ *
+ * File Name:   fwk_glyph.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <platform/fwk_mempool.h>
+#include <platform/video/fwk_glyph.h>
+#include <kernel/mutex.h>
+
+/*!< The defines */
+#define mrt_fwk_glyph_dot(line, col)            ((line)[(col) >> 3] & (0x80 >> ((col) & 0x7)))
+#define mrt_fwk_glyph_key_equal(a, b)   \
+            (((a)->font == (b)->font) && ((a)->code == (b)->code) && ((a)->size == (b)->size) && \
+             ((a)->width == (b)->width) && ((a)->color == (b)->color) && ((a)->format == (b)->format))
+#define mrt_fwk_glyph_hash(key)     \
+            (((key)->code ^ ((key)->size << 4) ^ (key)->color ^ ((kuaddr_t)(key)->font >> 4)) & (FWK_GLYPH_HASH_SIZE - 1))
+
+/*!< The globals */
+static struct fwk_glyph sgrt_fwk_glyph_cache[FWK_GLYPH_CACHE_NUM];
+static struct list_head sgrt_fwk_glyph_hash[FWK_GLYPH_HASH_SIZE];
+static DECLARE_LIST_HEAD(sgrt_fwk_glyph_lru);
+static struct mutex_lock sgrt_fwk_glyph_lock = MUTEX_LOCK_INIT();
+static struct fwk_glyph_stats sgrt_fwk_glyph_stats;
+static kbool_t g_fwk_glyph_inited = false;
+
+/*!< The functions */
+/*!
+ * @brief   set up lists at the first use
+ * @param   none
+ * @retval  none
+ * @note    all glyphs start on the lru list, unused ones have no pixels
+ */
+static void fwk_glyph_cache_init(void)
+{
+    kuint32_t idx;
+
+    if (g_fwk_glyph_inited)
+        return;
+
+    for (idx = 0; idx < FWK_GLYPH_HASH_SIZE; idx++)
+        init_list_head(&sgrt_fwk_glyph_hash[idx]);
+
+    for (idx = 0; idx < FWK_GLYPH_CACHE_NUM; idx++)
+    {
+        init_list_head(&sgrt_fwk_glyph_cache[idx].sgrt_hash);
+        list_head_add_tail(&sgrt_fwk_glyph_lru, &sgrt_fwk_glyph_cache[idx].sgrt_lru);
+    }
+
+    g_fwk_glyph_inited = true;
+}
+
+/*!
+ * @brief   find next run of set dots
+ * @param   dmatx: dot matrix, rows are aligned to bytes, msb first
+ * @param   width, height: unit: pixel
+ * @param   row, col: position to search from, updated
+ * @param   sprt_span: output
+ * @retval  false if no more
+ * @note    none
+ */
+static kbool_t fwk_glyph_next_span(const kuint8_t *dmatx, kuint32_t width, kuint32_t height,
+                            kuint32_t *row, kuint32_t *col, struct fwk_glyph_span *sprt_span)
+{
+    const kuint8_t *line;
+    kuint32_t start;
+    kuint32_t stride = mrt_align(width, 8) >> 3;
+
+    for (; *row < height; (*row)++, *col = 0)
+    {
+        line = dmatx + (*row) * stride;
+
+        while ((*col < width) && !mrt_fwk_glyph_dot(line, *col))
+            (*col)++;
+
+        if (*col >= width)
+            continue;
+
+        start = *col;
+        while ((*col < width) && mrt_fwk_glyph_dot(line, *col))
+            (*col)++;
+
+        sprt_span->y = (kuint16_t)(*row);
+        sprt_span->x = (kuint16_t)start;
+        sprt_span->lenth = (kuint16_t)(*col - start);
+
+        return true;
+    }
+
+    return false;
+}
+
+/*!
+ * @brief   find glyph in cache
+ * @param   sprt_key
+ * @retval  glyph (null if not cached)
+ * @note    none
+ */
+static struct fwk_glyph *fwk_glyph_lookup(struct fwk_glyph_key *sprt_key)
+{
+    struct fwk_glyph *sprt_glyph;
+    struct list_head *sprt_head = &sgrt_fwk_glyph_hash[mrt_fwk_glyph_hash(sprt_key)];
+
+    foreach_list_next_entry(sprt_glyph, sprt_head, sgrt_hash)
+    {
+        if (mrt_fwk_glyph_key_equal(&sprt_glyph->sgrt_key, sprt_key))
+            return sprt_glyph;
+    }
+
+    return mrt_nullptr;
+}
+
+/*!
+ * @brief   render dot matrix into the least recently used glyph
+ * @param   sprt_key, dmatx
+ * @retval  glyph, or errno
+ * @note    pixels and spans share one allocation
+ */
+static struct fwk_glyph *fwk_glyph_render(struct fwk_glyph_key *sprt_key, const kuint8_t *dmatx)
+{
+    struct fwk_glyph *sprt_glyph;
+    struct fwk_glyph_span sgrt_span;
+    fwk_blit_fill_t fill;
+    kuint32_t row, col, num_spans, row_bytes;
+    kuint8_t *data;
+
+    fill = fwk_blit_get_fill(sprt_key->format);
+    if (!fill)
+        return ERR_PTR(-ER_UNVALID);
+
+    row = col = num_spans = 0;
+    while (fwk_glyph_next_span(dmatx, sprt_key->width, sprt_key->size, &row, &col, &sgrt_span))
+        num_spans++;
+
+    row_bytes = mrt_align(sprt_key->width * fwk_blit_bytes_per_pixel(sprt_key->format), sizeof(kuint32_t));
+    data = kmalloc(row_bytes + num_spans * sizeof(sgrt_span), GFP_KERNEL);
+    if (!isValid(data))
+        return ERR_PTR(-ER_NOMEM);
+
+    /*!< recycle the oldest one */
+    sprt_glyph = mrt_list_last_entry(&sgrt_fwk_glyph_lru, struct fwk_glyph, sgrt_lru);
+    if (sprt_glyph->pixels)
+    {
+        kfree(sprt_glyph->pixels);
+        list_head_del(&sprt_glyph->sgrt_hash);
+        sgrt_fwk_glyph_stats.used--;
+    }
+
+    sprt_glyph->sgrt_key = *sprt_key;
+    sprt_glyph->pixels = data;
+    sprt_glyph->sprt_spans = (struct fwk_glyph_span *)(data + row_bytes);
+    sprt_glyph->num_spans = num_spans;
+
+    fill(sprt_glyph->pixels, sprt_key->color, sprt_key->width);
+
+    row = col = num_spans = 0;
+    while (fwk_glyph_next_span(dmatx, sprt_key->width, sprt_key->size, &row, &col, &sgrt_span))
+        sprt_glyph->sprt_spans[num_spans++] = sgrt_span;
+
+    list_head_add_head(&sgrt_fwk_glyph_hash[mrt_fwk_glyph_hash(sprt_key)], &sprt_glyph->sgrt_hash);
+    sgrt_fwk_glyph_stats.used++;
+
+    return sprt_glyph;
+}
+
+/*!
+ * @brief   clip span to the visible part of glyph
+ * @param   sprt_span, clip_w, clip_h: visible width and height, from top left of glyph
+ * @retval  pixels left, 0 if the span is hidden
+ * @note    none
+ */
+static inline kuint32_t fwk_glyph_clip_span(const struct fwk_glyph_span *sprt_span, kuint32_t clip_w, kuint32_t clip_h)
+{
+    if ((sprt_span->y >= clip_h) || (sprt_span->x >= clip_w))
+        return 0;
+
+    return CMP_MIN2((kuint32_t)sprt_span->lenth, clip_w - sprt_span->x);
+}
+
+/*!
+ * @brief   draw dot matrix without caching it
+ * @param   sprt_surf, x, y, sprt_key, dmatx
+ * @param   clip_w, clip_h: visible part of glyph
+ * @retval  none
+ * @note    used if there is no memory for a new glyph
+ */
+static void fwk_glyph_draw_uncached(struct fwk_blit_surface *sprt_surf, kuint32_t x, kuint32_t y,
+                            struct fwk_glyph_key *sprt_key, const kuint8_t *dmatx, kuint32_t clip_w, kuint32_t clip_h)
+{
+    struct fwk_glyph_span sgrt_span;
+    fwk_blit_fill_t fill;
+    kuint32_t row = 0, col = 0, lenth;
+
+    fill = fwk_blit_get_fill(sprt_surf->format);
+    if (!fill)
+        return;
+
+    while (fwk_glyph_next_span(dmatx, sprt_key->width, clip_h, &row, &col, &sgrt_span))
+    {
+        lenth = fwk_glyph_clip_span(&sgrt_span, clip_w, clip_h);
+        if (lenth)
+            fill(fwk_blit_pixel_addr(sprt_surf, x + sgrt_span.x, y + sgrt_span.y), sprt_key->color, lenth);
+    }
+}
+
+/*!< API function */
+/*!
+ * @brief   draw one character
+ * @param   sprt_surf: destination
+ * @param   x, y: top left of character
+ * @param   sprt_key: glyph description, format must be that of sprt_surf
+ * @param   dmatx: dot matrix of character, used if it is not cached
+ * @retval  errno
+ * @note    the glyph is clipped to surface; set dots are drawn, the others are left as they are
+ */
+kint32_t fwk_glyph_draw(struct fwk_blit_surface *sprt_surf, kuint32_t x, kuint32_t y,
+                            struct fwk_glyph_key *sprt_key, const kuint8_t *dmatx)
+{
+    struct fwk_glyph *sprt_glyph;
+    struct fwk_glyph_span *sprt_span;
+    fwk_blit_copy_t copy;
+    kuint32_t idx, clip_w, clip_h, lenth;
+
+    if (!sprt_surf || !sprt_key || !dmatx)
+        return -ER_NULLPTR;
+
+    if (sprt_key->format != sprt_surf->format)
+        return -ER_UNVALID;
+
+    /*!< wholly outside, nothing to draw */
+    if ((x >= sprt_surf->width) || (y >= sprt_surf->height))
+        return ER_NORMAL;
+
+    /*!< characters on the right and bottom edges are drawn in part */
+    clip_w = CMP_MIN2(sprt_key->width, sprt_surf->width - x);
+    clip_h = CMP_MIN2(sprt_key->size, sprt_surf->height - y);
+
+    copy = fwk_blit_get_copy(sprt_key->format, sprt_key->format);
+    if (!copy)
+        return -ER_UNVALID;
+
+    mutex_lock(&sgrt_fwk_glyph_lock);
+
+    fwk_glyph_cache_init();
+
+    sprt_glyph = fwk_glyph_lookup(sprt_key);
+    if (sprt_glyph)
+        sgrt_fwk_glyph_stats.hits++;
+    else
+    {
+        sgrt_fwk_glyph_stats.misses++;
+
+        sprt_glyph = fwk_glyph_render(sprt_key, dmatx);
+        if (!isValid(sprt_glyph))
+        {
+            fwk_glyph_draw_uncached(sprt_surf, x, y, sprt_key, dmatx, clip_w, clip_h);
+            goto END;
+        }
+    }
+
+    list_head_del(&sprt_glyph->sgrt_lru);
+    list_head_add_head(&sgrt_fwk_glyph_lru, &sprt_glyph->sgrt_lru);
+
+    for (idx = 0; idx < sprt_glyph->num_spans; idx++)
+    {
+        sprt_span = &sprt_glyph->sprt_spans[idx];
+
+        /*!< spans are sorted by row, the rest are below the surface */
+        if (sprt_span->y >= clip_h)
+            break;
+
+        lenth = fwk_glyph_clip_span(sprt_span, clip_w, clip_h);
+        if (lenth)
+            copy(fwk_blit_pixel_addr(sprt_surf, x + sprt_span->x, y + sprt_span->y), sprt_glyph->pixels, lenth);
+    }
+
+END:
+    mutex_unlock(&sgrt_fwk_glyph_lock);
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   release all cached glyphs
+ * @param   none
+ * @retval  none
+ * @note    call it if a font library is replaced at the same address
+ */
+void fwk_glyph_cache_drop(void)
+{
+    struct fwk_glyph *sprt_glyph;
+    kuint32_t idx;
+
+    mutex_lock(&sgrt_fwk_glyph_lock);
+
+    for (idx = 0; g_fwk_glyph_inited && (idx < FWK_GLYPH_CACHE_NUM); idx++)
+    {
+        sprt_glyph = &sgrt_fwk_glyph_cache[idx];
+        if (!sprt_glyph->pixels)
+            continue;
+
+        kfree(sprt_glyph->pixels);
+        sprt_glyph->pixels = mrt_nullptr;
+        list_head_del(&sprt_glyph->sgrt_hash);
+
+        /*!< reuse empty ones first */
+        list_head_del(&sprt_glyph->sgrt_lru);
+        list_head_add_tail(&sgrt_fwk_glyph_lru, &sprt_glyph->sgrt_lru);
+    }
+
+    sgrt_fwk_glyph_stats.used = 0;
+
+    mutex_unlock(&sgrt_fwk_glyph_lock);
+}
+
+/*!
+ * @brief   get statistics of glyph cache
+ * @param   sprt_stats: output
+ * @retval  none
+ * @note    none
+ */
+void fwk_glyph_cache_stats(struct fwk_glyph_stats *sprt_stats)
+{
+    if (sprt_stats)
+        *sprt_stats = sgrt_fwk_glyph_stats;
+}
+
+/*!< end of file */
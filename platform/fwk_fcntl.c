@@ -20,14 +20,49 @@
 #include <platform/net/fwk_netif.h>
 #include <platform/net/fwk_socket.h>
 #include <kernel/spinlock.h>
+#include <kernel/sched.h>
+
+/*!< The defines */
+#define mrt_fd_word(fd)                         ((fd) / FILE_DESC_BITMAP_BITS)
+#define mrt_fd_mask(fd)                         mrt_bit((fd) % FILE_DESC_BITMAP_BITS)
+
+/*!< wait entries on stack of virt_poll, more are allocated if nfds is large */
+#define FWK_POLL_STACK_ENTRIES                  (16)
+#define FWK_POLL_WAITS_PER_FD                   (2)
+
+/*!< returned for files that do not implement "poll": they never block */
+#define FWK_POLL_DEFAULT_MASK                   (POLLIN | POLLRDNORM | POLLOUT | POLLWRNORM)
+
+/*!< select() sets, converted to poll events */
+#define FWK_POLLIN_SET                          (POLLIN | POLLRDNORM | POLLHUP | POLLERR)
+#define FWK_POLLOUT_SET                         (POLLOUT | POLLWRNORM | POLLERR)
+#define FWK_POLLEX_SET                          (POLLPRI)
+
+/*!< read pointer once, it may be changed by writer at the same time */
+#define mrt_fd_read_once(ptr)                   (*(typeof(ptr) volatile *)&(ptr))
+
+/*!< region mapped by virt_mmap */
+struct fwk_vm_map
+{
+    kuaddr_t start;
+    kusize_t size;
+    kint32_t prot;
+    kint32_t flags;
+    kuint32_t mem_type;                         /*!< refer to "__ERT_FWK_VM_TYPE" */
+
+    struct fwk_file *sprt_file;
+    struct list_head sgrt_link;
+};
 
 /*!< The globals */
+/*!< used by every thread that has not called fwk_files_unshare (and by the threads they create) */
 static struct fwk_file_table sgrt_fwk_file_table =
 {
     .max_fdarr	= 0,
     .max_fds	= FILE_DESC_NUM_MAX,
     .max_fdset	= -1,
     .ref_fdarr	= 0,
+    .users      = 1,
 
     .fds		= mrt_nullptr,
     .fd_array	= { mrt_nullptr },
@@ -51,116 +86,275 @@ static struct fwk_file sgrt_fwk_file_stdio[DEVICE_MAJOR_BASE] =
     },
 };
 
-/*!< API function */
+/*!< protects "users" and sprt_files of threads */
+static struct spin_lock sgrt_fwk_files_lock = SPIN_LOCK_INIT();
+
+/*!< The functions */
 /*!
- * @brief   fwk_file_system_init
+ * @brief   descriptor table of current thread
  * @param   none
- * @retval  none
+ * @retval  table
  * @note    none
  */
-kint32_t __plat_init fwk_file_system_init(void)
+static struct fwk_file_table *fwk_get_files(void)
 {
+    struct thread *sprt_thread = mrt_current;
     struct fwk_file_table *sprt_table;
-    kusize_t  num_farray;
-    kuint32_t fileCnt;
 
-    sprt_table = &sgrt_fwk_file_table;
-    num_farray = ARRAY_SIZE(sprt_table->fd_array);
+    sprt_table = sprt_thread ? mrt_fd_read_once(sprt_thread->sprt_files) : mrt_nullptr;
 
-    if (!sprt_table->max_fds)
-        sprt_table->max_fds	= num_farray;
+    return sprt_table ? sprt_table : &sgrt_fwk_file_table;
+}
 
-    sprt_table->max_fdarr = CMP_MIN2(sprt_table->max_fds, num_farray);
-    num_farray = ARRAY_SIZE(sgrt_fwk_file_stdio);
+/*!
+ * @brief   mark descriptor as allocated
+ * @param   sprt_table, fd
+ * @retval  none
+ * @note    mutex must be held
+ */
+static void fwk_fd_bitmap_set(struct fwk_file_table *sprt_table, kint32_t fd)
+{
+    kuint32_t word = mrt_fd_word(fd);
 
-    if (sprt_table->max_fdarr < num_farray)
-        return -ER_MORE;
+    sprt_table->open_fds[word] |= mrt_fd_mask(fd);
+    if (!(~sprt_table->open_fds[word]))
+        sprt_table->full_fds |= mrt_bit(word);
+}
 
-    /*!< Occupy the top three */
-    for (fileCnt = 0; fileCnt < num_farray; fileCnt++)
-        sprt_table->fd_array[fileCnt] = &sgrt_fwk_file_stdio[fileCnt];
+/*!
+ * @brief   mark descriptor as free
+ * @param   sprt_table, fd
+ * @retval  none
+ * @note    mutex must be held
+ */
+static void fwk_fd_bitmap_clr(struct fwk_file_table *sprt_table, kint32_t fd)
+{
+    kuint32_t word = mrt_fd_word(fd);
 
-    sprt_table->max_fds		= sprt_table->max_fdarr;
-    sprt_table->ref_fdarr	= fileCnt;
-    sprt_table->max_fdset 	= CMP_GT2(num_farray, 0, num_farray - 1, sprt_table->max_fdset);
+    sprt_table->open_fds[word] &= ~mrt_fd_mask(fd);
+    sprt_table->full_fds &= ~mrt_bit(word);
+}
 
-    mutex_init(&sprt_table->sgrt_mutex);
+/*!
+ * @brief   find the lowest free descriptor
+ * @param   sprt_table
+ * @retval  fd, -1 if all are allocated
+ * @note    mutex must be held; one "count trailing zeros" per level
+ */
+static kint32_t fwk_fd_bitmap_find(struct fwk_file_table *sprt_table)
+{
+    kuint32_t word;
 
-    return ER_NORMAL;
+    if (!(~sprt_table->full_fds))
+        return -1;
+
+    word = __builtin_ctz(~sprt_table->full_fds);
+
+    return (word * FILE_DESC_BITMAP_BITS) + __builtin_ctz(~sprt_table->open_fds[word]);
 }
 
 /*!
- * @brief   fwk_get_expand_fdtable
- * @param   none
+ * @brief   find the highest allocated descriptor
+ * @param   sprt_table
+ * @retval  fd, -1 if none
+ * @note    mutex must be held
+ */
+static kint32_t fwk_fd_bitmap_last(struct fwk_file_table *sprt_table)
+{
+    kint32_t word, fd;
+
+    for (word = FILE_DESC_BITMAP_NUM - 1; word >= 0; word--)
+    {
+        if (!sprt_table->open_fds[word])
+            continue;
+
+        fd = (word * FILE_DESC_BITMAP_BITS) + (FILE_DESC_BITMAP_BITS - 1) - __builtin_clz(sprt_table->open_fds[word]);
+
+        /*!< socket descriptors are never allocated here */
+        if (fd < NETWORK_SOCKETS_BASE)
+            return fd;
+    }
+
+    return -1;
+}
+
+/*!
+ * @brief   initialize descriptor table
+ * @param   sprt_table
  * @retval  none
- * @note    none
+ * @note    stdio descriptors are occupied
  */
-static kint32_t fwk_get_expand_fdtable(struct fwk_file_table *sprt_table, kuint32_t flags)
+static void fwk_files_init(struct fwk_file_table *sprt_table)
 {
-    kint32_t index;
+    kint32_t fd;
 
-    /*!< Created for the first time */
-    if (!isValid(sprt_table->fds))
-        sprt_table->fds	= (struct fwk_file **)kcalloc(sizeof(struct fwk_file), FILE_DESC_EXP_NUM, GFP_KERNEL);
+    init_list_head(&sprt_table->sgrt_vmas);
+    memset(sprt_table->open_fds, 0, sizeof(sprt_table->open_fds));
+    memset(sprt_table->fd_array, 0, sizeof(sprt_table->fd_array));
 
-    /*!< It still doesn't exist after it was created */
-    if (!isValid(sprt_table->fds))
-        goto fail;
+    /*!< words that do not exist are always full */
+    sprt_table->full_fds = ~(mrt_bit(FILE_DESC_BITMAP_NUM) - 1);
+
+    /*!< socket descriptors share the same number space, they are never handed out here */
+    for (fd = NETWORK_SOCKETS_BASE; fd < (FILE_DESC_BITMAP_NUM * FILE_DESC_BITMAP_BITS); fd++)
+        fwk_fd_bitmap_set(sprt_table, fd);
 
-    /*!< Fetch an unused index from fds */
-    for (index = 0; index < FILE_DESC_EXP_NUM; index++)
+    /*!< Occupy the top three */
+    for (fd = 0; fd < ARRAY_SIZE(sgrt_fwk_file_stdio); fd++)
     {
-        if (!sprt_table->fds[index])
-            goto fdget;
+        sprt_table->fd_array[fd] = &sgrt_fwk_file_stdio[fd];
+        fwk_fd_bitmap_set(sprt_table, fd);
     }
 
-    /*!< Not found */
-    goto fail;
+    sprt_table->fds         = mrt_nullptr;
+    sprt_table->max_fdarr   = ARRAY_SIZE(sprt_table->fd_array);
+    sprt_table->max_fds     = sprt_table->max_fdarr;
+    sprt_table->max_fdset   = fd - 1;
+    sprt_table->ref_fdarr   = fd;
 
-fdget:
-    index += sprt_table->max_fdarr;
-    sprt_table->max_fdset = mrt_ret_max2(sprt_table->max_fdset, index);
-    sprt_table->max_fds	= sprt_table->max_fdarr	+ FILE_DESC_EXP_NUM;
+    mutex_init(&sprt_table->sgrt_mutex);
+}
 
-    return index;
+/*!
+ * @brief   close all descriptors and free table
+ * @param   sprt_table
+ * @retval  none
+ * @note    no thread uses it any more
+ */
+static void fwk_files_release(struct fwk_file_table *sprt_table)
+{
+    struct fwk_vm_map *sprt_map, *sprt_temp;
+    struct fwk_file *sprt_file;
+    kint32_t fd;
 
-fail:
-    return -ER_ERROR;
+    foreach_list_next_entry_safe(sprt_map, sprt_temp, &sprt_table->sgrt_vmas, sgrt_link)
+    {
+        list_head_del(&sprt_map->sgrt_link);
+        kfree(sprt_map);
+    }
+
+    for (fd = DEVICE_MAJOR_BASE; fd <= sprt_table->max_fdset; fd++)
+    {
+        if (fd < sprt_table->max_fdarr)
+            sprt_file = sprt_table->fd_array[fd];
+        else
+            sprt_file = sprt_table->fds ? sprt_table->fds[fd - sprt_table->max_fdarr] : mrt_nullptr;
+
+        if (sprt_file)
+            fwk_do_filp_close(sprt_file);
+    }
+
+    if (sprt_table->fds)
+        kfree(sprt_table->fds);
+
+    kfree(sprt_table);
 }
 
+/*!< API function */
 /*!
- * @brief   fwk_put_expand_fdtable
+ * @brief   fwk_file_system_init
  * @param   none
  * @retval  none
  * @note    none
  */
-static void fwk_put_expand_fdtable(struct fwk_file_table *sprt_table, kint32_t fd)
+kint32_t __plat_init fwk_file_system_init(void)
 {
-    kint32_t index;
+    if (FILE_DESC_NUM_MAX < ARRAY_SIZE(sgrt_fwk_file_stdio))
+        return -ER_MORE;
 
-    /*!< The array does not exist */
-    if (!isValid(sprt_table->fds) || (fd < sprt_table->max_fdarr))
-        return;
+    fwk_files_init(&sgrt_fwk_file_table);
 
-    index = fd - sprt_table->max_fdarr;
-    sprt_table->fds[index] = mrt_nullptr;
+    return ER_NORMAL;
+}
 
-    sprt_table->max_fdset = CMP_GTS(sprt_table->max_fdset, fd, fd - 1);
+/*!
+ * @brief   new thread joins thread group of its creator
+ * @param   sprt_thread: new thread
+ * @param   sprt_parent: creator, can be null
+ * @retval  none
+ * @note    called by scheduler when thread is created
+ */
+void fwk_files_inherit(struct thread *sprt_thread, struct thread *sprt_parent)
+{
+    struct fwk_file_table *sprt_table;
 
-    /*!< The extended array has all been emptied. Free up space and save memory */
-    if (!index)
-    {
-        kfree(sprt_table->fds);
+    spin_lock_irqsave(&sgrt_fwk_files_lock);
 
-        sprt_table->fds 	= mrt_nullptr;
-        sprt_table->max_fds = sprt_table->max_fdarr;
-    }
+    sprt_table = sprt_parent ? sprt_parent->sprt_files : mrt_nullptr;
+    if (sprt_table)
+        sprt_table->users++;
+
+    sprt_thread->sprt_files = sprt_table;
+
+    spin_unlock_irqrestore(&sgrt_fwk_files_lock);
 }
 
 /*!
- * @brief   fwk_get_unused_fd_flags
+ * @brief   give current thread a descriptor table of its own
+ * @param   none
+ * @retval  errno
+ * @note    the new table only has stdio; threads created by current thread from now on share it.
+ *          Descriptors opened before are left in the old table
+ */
+kint32_t fwk_files_unshare(void)
+{
+    struct thread *sprt_thread = mrt_current;
+    struct fwk_file_table *sprt_table, *sprt_old;
+    kbool_t is_last;
+
+    if (!sprt_thread)
+        return -ER_NREADY;
+
+    sprt_table = (struct fwk_file_table *)kzalloc(sizeof(*sprt_table), GFP_KERNEL);
+    if (!isValid(sprt_table))
+        return -ER_NOMEM;
+
+    fwk_files_init(sprt_table);
+    sprt_table->users = 1;
+
+    spin_lock_irqsave(&sgrt_fwk_files_lock);
+
+    sprt_old = sprt_thread->sprt_files;
+    sprt_thread->sprt_files = sprt_table;
+    is_last = sprt_old && !(--sprt_old->users);
+
+    spin_unlock_irqrestore(&sgrt_fwk_files_lock);
+
+    if (is_last)
+        fwk_files_release(sprt_old);
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   fwk_get_expand_fdtable
  * @param   none
  * @retval  none
+ * @note    mutex must be held; it is kept until the table is released, so lockless readers never see it freed
+ */
+static kint32_t fwk_get_expand_fdtable(struct fwk_file_table *sprt_table)
+{
+    struct fwk_file **sprt_fds;
+
+    if (sprt_table->fds)
+        return ER_NORMAL;
+
+    sprt_fds = (struct fwk_file **)kcalloc(sizeof(struct fwk_file *), FILE_DESC_EXP_NUM, GFP_KERNEL);
+    if (!isValid(sprt_fds))
+        return -ER_NOMEM;
+
+    /*!< publish after it is cleared */
+    mrt_barrier();
+    sprt_table->fds = sprt_fds;
+    sprt_table->max_fds	= sprt_table->max_fdarr	+ FILE_DESC_EXP_NUM;
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   fwk_get_unused_fd_flags
+ * @param   none
+ * @retval  the lowest free descriptor, or errno
  * @note    none
  */
 static kint32_t fwk_get_unused_fd_flags(kuint32_t flags)
@@ -168,47 +362,29 @@ static kint32_t fwk_get_unused_fd_flags(kuint32_t flags)
     struct fwk_file_table *sprt_table;
     kint32_t index;
 
-    sprt_table = &sgrt_fwk_file_table;
-
-    /*!< Check if fd_array are fully assigned */
-    index = fwk_get_fd_available(sprt_table);
-    if (index < 0)
-        goto expand;
+    sprt_table = fwk_get_files();
 
     mutex_lock(&sprt_table->sgrt_mutex);
 
-    /*!< Priority is given to backward allocation */
-    index = CMP_LTS(sprt_table->max_fdset + 1, sprt_table->max_fdarr, -1);
-    if (index >= 0)
-    {
-        sprt_table->max_fdset++;
-        goto fdget;
-    }
-
-    /*!< Fetch an unused index from the file_array */
-    for (index = 0; index < sprt_table->max_fdset; index++)
-    {
-        if (!sprt_table->fd_array[index])
-            goto fdget;
-    }
+    index = fwk_fd_bitmap_find(sprt_table);
+    if (index < 0)
+        goto fail;
 
-    mutex_unlock(&sprt_table->sgrt_mutex);
+    /*!< fd_array has run out */
+    if ((index >= sprt_table->max_fdarr) && fwk_get_expand_fdtable(sprt_table))
+        goto fail;
 
-    /*!< Fail: fwk_get_fd_available check failed || RET_MIN_SUPER fail to get || for loop calls the overrun */
-    return -ER_MORE;
+    fwk_fd_bitmap_set(sprt_table, index);
+    sprt_table->max_fdset = mrt_ret_max2(sprt_table->max_fdset, index);
+    sprt_table->ref_fdarr++;
 
-fdget:
-    fwk_fdtable_get(sprt_table);
     mutex_unlock(&sprt_table->sgrt_mutex);
 
     return index;
 
-expand:
-    /*!< fd has run out */
-    index = fwk_get_expand_fdtable(sprt_table, flags);
+fail:
     mutex_unlock(&sprt_table->sgrt_mutex);
-
-    return index;
+    return -ER_MORE;
 }
 
 /*!
@@ -220,32 +396,45 @@ expand:
 static void fwk_put_used_fd_flags(kint32_t fd)
 {
     struct fwk_file_table *sprt_table;
-    kint32_t index;
 
-    if (FILE_DESC_OVER_BASE(fd))
+    if (FILE_DESC_OVER_BASE(fd) || (fd >= NETWORK_SOCKETS_BASE))
         return;
 
-    sprt_table = &sgrt_fwk_file_table;
-    index = fd;
-
-    if (index >= sprt_table->max_fdarr)
-        goto expand;
+    sprt_table = fwk_get_files();
 
     mutex_lock(&sprt_table->sgrt_mutex);
 
-    sprt_table->fd_array[index]	= mrt_nullptr;
-    sprt_table->max_fdset = CMP_GTS(sprt_table->max_fdset, fd, fd - 1);
-    fwk_fdtable_put(sprt_table);
+    if (sprt_table->open_fds[mrt_fd_word(fd)] & mrt_fd_mask(fd))
+    {
+        fwk_fd_bitmap_clr(sprt_table, fd);
+        sprt_table->ref_fdarr--;
+
+        if (fd == sprt_table->max_fdset)
+            sprt_table->max_fdset = fwk_fd_bitmap_last(sprt_table);
+    }
 
     mutex_unlock(&sprt_table->sgrt_mutex);
+}
 
-    return;
+/*!
+ * @brief   slot of descriptor
+ * @param   sprt_table, fd
+ * @retval  slot, null if it does not exist
+ * @note    none
+ */
+static struct fwk_file **fwk_fd_slot(struct fwk_file_table *sprt_table, kint32_t fd)
+{
+    struct fwk_file **sprt_fds;
 
-expand:
-    mutex_lock(&sprt_table->sgrt_mutex);
-    /*!< fd has run out */
-    fwk_put_expand_fdtable(sprt_table, fd);
-    mutex_unlock(&sprt_table->sgrt_mutex);
+    if (FILE_DESC_OVER_BASE(fd) || (fd >= NETWORK_SOCKETS_BASE))
+        return mrt_nullptr;
+
+    if (fd < sprt_table->max_fdarr)
+        return &sprt_table->fd_array[fd];
+
+    sprt_fds = mrt_fd_read_once(sprt_table->fds);
+
+    return sprt_fds ? &sprt_fds[fd - sprt_table->max_fdarr] : mrt_nullptr;
 }
 
 /*!
@@ -257,58 +446,99 @@ expand:
 static kint32_t fwk_fd_install(kint32_t fd, struct fwk_file *sprt_file)
 {
     struct fwk_file_table *sprt_table;
-    struct fwk_file **sprt_fdt;
-    kint32_t index;
+    struct fwk_file **sprt_slot;
+    kint32_t retval = -ER_UNVALID;
 
-    if (FILE_DESC_OVER_BASE(fd) || !isValid(sprt_file))
+    if (!isValid(sprt_file))
         return -ER_UNVALID;
 
-    sprt_table	= &sgrt_fwk_file_table;
-    sprt_fdt	= sprt_table->fd_array;
-    index		= fd;
+    sprt_table = fwk_get_files();
+
+    mutex_lock(&sprt_table->sgrt_mutex);
 
-    if (fd >= sprt_table->max_fdarr)
+    sprt_slot = fwk_fd_slot(sprt_table, fd);
+    if (sprt_slot && !(*sprt_slot))
     {
-        sprt_fdt = sprt_table->fds;
-        index = fd - sprt_table->max_fdarr;
+        /*!< readers must see the file completely initialized */
+        mrt_barrier();
+        *sprt_slot = sprt_file;
+        retval = ER_NORMAL;
     }
 
-    if (sprt_fdt[index])
-        return -ER_UNVALID;
+    mutex_unlock(&sprt_table->sgrt_mutex);
+
+    return retval;
+}
+
+/*!
+ * @brief   remove file from descriptor
+ * @param   fd
+ * @retval  file removed, null if none
+ * @note    the descriptor is still allocated, call fwk_put_used_fd_flags after the file is closed
+ */
+static struct fwk_file *fwk_fd_uninstall(kint32_t fd)
+{
+    struct fwk_file_table *sprt_table;
+    struct fwk_file **sprt_slot;
+    struct fwk_file *sprt_file = mrt_nullptr;
+
+    sprt_table = fwk_get_files();
 
     mutex_lock(&sprt_table->sgrt_mutex);
-    sprt_fdt[index] = sprt_file;
+
+    sprt_slot = fwk_fd_slot(sprt_table, fd);
+    if (sprt_slot)
+    {
+        sprt_file = *sprt_slot;
+        *sprt_slot = mrt_nullptr;
+    }
+
     mutex_unlock(&sprt_table->sgrt_mutex);
 
-    return ER_NORMAL;
+    return sprt_file;
 }
 
 /*!
  * @brief   fwk_fd_to_file
  * @param   none
  * @retval  none
- * @note    none
+ * @note    no lock: fd_array and fds of a table are never moved or freed, and a slot is a single word.
+ *          The file itself must not be closed by another thread while it is in use
  */
 static struct fwk_file *fwk_fd_to_file(kint32_t fd)
+{
+    struct fwk_file **sprt_slot;
+
+    sprt_slot = fwk_fd_slot(fwk_get_files(), fd);
+
+    return sprt_slot ? mrt_fd_read_once(*sprt_slot) : mrt_nullptr;
+}
+
+/*!
+ * @brief   remove all mappings of file
+ * @param   sprt_file
+ * @retval  none
+ * @note    called when file is closed
+ */
+static void fwk_vm_unmap_file(struct fwk_file *sprt_file)
 {
     struct fwk_file_table *sprt_table;
-    struct fwk_file  **sprt_fdt;
-    kint32_t index;
+    struct fwk_vm_map *sprt_map, *sprt_temp;
 
-    if (FILE_DESC_OVER_BASE(fd))
-        return mrt_nullptr;
+    sprt_table = fwk_get_files();
 
-    sprt_table	= &sgrt_fwk_file_table;
-    sprt_fdt	= sprt_table->fd_array;
-    index		= fd;
+    mutex_lock(&sprt_table->sgrt_mutex);
 
-    if (fd >= sprt_table->max_fdarr)
+    foreach_list_next_entry_safe(sprt_map, sprt_temp, &sprt_table->sgrt_vmas, sgrt_link)
     {
-        sprt_fdt = sprt_table->fds;
-        index = fd - sprt_table->max_fdarr;
+        if (sprt_map->sprt_file != sprt_file)
+            continue;
+
+        list_head_del(&sprt_map->sgrt_link);
+        kfree(sprt_map);
     }
 
-    return sprt_fdt[index];
+    mutex_unlock(&sprt_table->sgrt_mutex);
 }
 
 /*!
@@ -355,14 +585,40 @@ static void fwk_do_close(kint32_t fd)
 {
     struct fwk_file *sprt_file;
 
-    sprt_file = fwk_fd_to_file(fd);
+    /*!< readers stop finding it before it is freed, and fd is not reused until then */
+    sprt_file = fwk_fd_uninstall(fd);
     if (!isValid(sprt_file))
         return;
 
+    /*!< its mappings go with it */
+    fwk_vm_unmap_file(sprt_file);
     fwk_do_filp_close(sprt_file);
     fwk_put_used_fd_flags(fd);
 }
 
+/*!
+ * @brief   write to file
+ * @param   sprt_file, buf, size
+ * @retval  size written, or errno
+ * @note    none
+ */
+static kssize_t __fwk_do_write(struct fwk_file *sprt_file, const void *buf, kusize_t size)
+{
+    kint32_t retval;
+
+    if ((sprt_file->mode & O_WRONLY) != O_WRONLY)
+        return -ER_FORBID;
+
+    if (sprt_file->sprt_foprts->write)
+    {
+        retval = sprt_file->sprt_foprts->write(sprt_file, (const kbuffer_t *)buf, size);
+        if (!retval)
+            return size;
+    }
+
+    return -ER_ERROR;
+}
+
 /*!
  * @brief   fwk_do_write
  * @param   none
@@ -372,7 +628,6 @@ static void fwk_do_close(kint32_t fd)
 static kssize_t fwk_do_write(kint32_t fd, const void *buf, kusize_t size)
 {
     struct fwk_file *sprt_file;
-    kint32_t retval;
 
     if (fd < 0)
         return -ER_ERROR;
@@ -381,14 +636,29 @@ static kssize_t fwk_do_write(kint32_t fd, const void *buf, kusize_t size)
     if (!isValid(sprt_file))
         return -ER_ERROR;
 
-    if ((sprt_file->mode & O_WRONLY) != O_WRONLY)
+    return __fwk_do_write(sprt_file, buf, size);
+}
+
+/*!
+ * @brief   read from file
+ * @param   sprt_file, buf, size
+ * @retval  size read, or errno
+ * @note    none
+ */
+static kssize_t __fwk_do_read(struct fwk_file *sprt_file, void *buf, kusize_t size)
+{
+    kint32_t retval;
+
+    if ((sprt_file->mode & O_RDONLY) != O_RDONLY)
         return -ER_FORBID;
 
-    if (sprt_file->sprt_foprts->write)
+    if (sprt_file->sprt_foprts->read)
     {
-        retval = sprt_file->sprt_foprts->write(sprt_file, (const kbuffer_t *)buf, size);
+        retval = sprt_file->sprt_foprts->read(sprt_file, (kbuffer_t *)buf, size);
         if (!retval)
             return size;
+        else if (retval > 0)
+            return retval;
     }
 
     return -ER_ERROR;
@@ -403,7 +673,6 @@ static kssize_t fwk_do_write(kint32_t fd, const void *buf, kusize_t size)
 static kssize_t fwk_do_read(kint32_t fd, void *buf, kusize_t size)
 {
     struct fwk_file *sprt_file;
-    kint32_t retval;
 
     if (fd < 0)
         return -ER_ERROR;
@@ -412,19 +681,141 @@ static kssize_t fwk_do_read(kint32_t fd, void *buf, kusize_t size)
     if (!isValid(sprt_file))
         return -ER_ERROR;
 
+    return __fwk_do_read(sprt_file, buf, size);
+}
+
+/*!
+ * @brief   fwk_do_readv
+ * @param   fd, sprt_iov, iovcnt
+ * @retval  total size read, or errno
+ * @note    without "readv" of file, segments are read one by one, and it stops at the first short one
+ */
+static kssize_t fwk_do_readv(kint32_t fd, const struct fwk_iovec *sprt_iov, kint32_t iovcnt)
+{
+    struct fwk_file *sprt_file;
+    kssize_t retval, total = 0;
+    kint32_t idx;
+
+    if ((fd < 0) || !sprt_iov || (iovcnt <= 0) || (iovcnt > FWK_IOV_MAX))
+        return -ER_UNVALID;
+
+    sprt_file = fwk_fd_to_file(fd);
+    if (!isValid(sprt_file))
+        return -ER_ERROR;
+
     if ((sprt_file->mode & O_RDONLY) != O_RDONLY)
         return -ER_FORBID;
 
-    if (sprt_file->sprt_foprts->read)
+    if (sprt_file->sprt_foprts->readv)
+        return sprt_file->sprt_foprts->readv(sprt_file, sprt_iov, iovcnt);
+
+    for (idx = 0; idx < iovcnt; idx++)
     {
-        retval = sprt_file->sprt_foprts->read(sprt_file, (kbuffer_t *)buf, size);
-        if (!retval)
-            return size;
-        else if (retval > 0)
-            return retval;
+        if (!sprt_iov[idx].iov_len)
+            continue;
+
+        retval = __fwk_do_read(sprt_file, sprt_iov[idx].iov_base, sprt_iov[idx].iov_len);
+        if (retval < 0)
+            return total ? total : retval;
+
+        total += retval;
+        if (retval < sprt_iov[idx].iov_len)
+            break;
     }
 
-    return -ER_ERROR;
+    return total;
+}
+
+/*!
+ * @brief   fwk_do_writev
+ * @param   fd, sprt_iov, iovcnt
+ * @retval  total size written, or errno
+ * @note    without "writev" of file, segments are written one by one
+ */
+static kssize_t fwk_do_writev(kint32_t fd, const struct fwk_iovec *sprt_iov, kint32_t iovcnt)
+{
+    struct fwk_file *sprt_file;
+    kssize_t retval, total = 0;
+    kint32_t idx;
+
+    if ((fd < 0) || !sprt_iov || (iovcnt <= 0) || (iovcnt > FWK_IOV_MAX))
+        return -ER_UNVALID;
+
+    sprt_file = fwk_fd_to_file(fd);
+    if (!isValid(sprt_file))
+        return -ER_ERROR;
+
+    if ((sprt_file->mode & O_WRONLY) != O_WRONLY)
+        return -ER_FORBID;
+
+    if (sprt_file->sprt_foprts->writev)
+        return sprt_file->sprt_foprts->writev(sprt_file, sprt_iov, iovcnt);
+
+    for (idx = 0; idx < iovcnt; idx++)
+    {
+        if (!sprt_iov[idx].iov_len)
+            continue;
+
+        retval = __fwk_do_write(sprt_file, sprt_iov[idx].iov_base, sprt_iov[idx].iov_len);
+        if (retval < 0)
+            return total ? total : retval;
+
+        total += retval;
+    }
+
+    return total;
+}
+
+/*!
+ * @brief   fwk_do_pread
+ * @param   fd, buf, size, offset
+ * @retval  size read, or errno
+ * @note    files have no position to seek, so the driver must implement "pread"
+ */
+static kssize_t fwk_do_pread(kint32_t fd, void *buf, kusize_t size, kuint32_t offset)
+{
+    struct fwk_file *sprt_file;
+
+    if (fd < 0)
+        return -ER_ERROR;
+
+    sprt_file = fwk_fd_to_file(fd);
+    if (!isValid(sprt_file))
+        return -ER_ERROR;
+
+    if ((sprt_file->mode & O_RDONLY) != O_RDONLY)
+        return -ER_FORBID;
+
+    if (!sprt_file->sprt_foprts->pread)
+        return -ER_FORBID;
+
+    return sprt_file->sprt_foprts->pread(sprt_file, (kbuffer_t *)buf, size, offset);
+}
+
+/*!
+ * @brief   fwk_do_pwrite
+ * @param   fd, buf, size, offset
+ * @retval  size written, or errno
+ * @note    files have no position to seek, so the driver must implement "pwrite"
+ */
+static kssize_t fwk_do_pwrite(kint32_t fd, const void *buf, kusize_t size, kuint32_t offset)
+{
+    struct fwk_file *sprt_file;
+
+    if (fd < 0)
+        return -ER_ERROR;
+
+    sprt_file = fwk_fd_to_file(fd);
+    if (!isValid(sprt_file))
+        return -ER_ERROR;
+
+    if ((sprt_file->mode & O_WRONLY) != O_WRONLY)
+        return -ER_FORBID;
+
+    if (!sprt_file->sprt_foprts->pwrite)
+        return -ER_FORBID;
+
+    return sprt_file->sprt_foprts->pwrite(sprt_file, (const kbuffer_t *)buf, size, offset);
 }
 
 /*!
@@ -457,38 +848,359 @@ static kint32_t fwk_do_ioctl(kint32_t fd, kuint32_t request, kuaddr_t args)
 
 /*!
  * @brief   fwk_do_mmap
- * @param   none
- * @retval  none
- * @note    none
+ * @param   addr: must be null, memory is mapped 1:1 and the address can not be chosen
+ * @param   length, prot, flags, fd
+ * @param   offset: passed to "mmap" of driver
+ * @retval  address, null if failed
+ * @note    the region is recorded in the table of current thread group, and its memory type
+ *          (given by driver) is applied
  */
 static void *fwk_do_mmap(void *addr, kusize_t length, kint32_t prot, kint32_t flags, kint32_t fd, kuint32_t offset)
 {
+    struct fwk_file_table *sprt_table;
+    struct fwk_vm_map *sprt_map, *sprt_pos;
     struct fwk_vm_area sgrt_vm;
     struct fwk_file *sprt_file;
     kint32_t retval;
 
-    if (fd < 0)
+    if ((fd < 0) || !length || isValid(addr) || (flags & MAP_FIXED))
         return mrt_nullptr;
 
     sprt_file = fwk_fd_to_file(fd);
-    if (!isValid(sprt_file))
+    if (!isValid(sprt_file) || !sprt_file->sprt_foprts->mmap)
         return mrt_nullptr;
 
+    memset(&sgrt_vm, 0, sizeof(sgrt_vm));
     sgrt_vm.offset = offset;
-    if (sprt_file->sprt_foprts->mmap)
-    {
-        retval = sprt_file->sprt_foprts->mmap(sprt_file, &sgrt_vm);
-        if (retval)
-            return mrt_nullptr;
-    }
+    sgrt_vm.mem_type = NR_FWK_VM_NORMAL;
+
+    retval = sprt_file->sprt_foprts->mmap(sprt_file, &sgrt_vm);
+    if (retval || !sgrt_vm.virt_addr)
+        return mrt_nullptr;
 
     if (length > sgrt_vm.size)
         return mrt_nullptr;
-    
-    if (!isValid(addr))
-        return (void *)sgrt_vm.virt_addr;
 
-    return mrt_nullptr;
+    retval = fwk_vm_set_memtype(sgrt_vm.virt_addr, length, sgrt_vm.mem_type);
+    if (retval)
+        return mrt_nullptr;
+
+    sprt_map = (struct fwk_vm_map *)kzalloc(sizeof(*sprt_map), GFP_KERNEL);
+    if (!isValid(sprt_map))
+        return mrt_nullptr;
+
+    sprt_map->start = sgrt_vm.virt_addr;
+    sprt_map->size = length;
+    sprt_map->prot = prot;
+    sprt_map->flags = flags;
+    sprt_map->mem_type = sgrt_vm.mem_type;
+    sprt_map->sprt_file = sprt_file;
+
+    sprt_table = fwk_get_files();
+
+    mutex_lock(&sprt_table->sgrt_mutex);
+
+    /*!< keep the list sorted by address */
+    foreach_list_next_entry(sprt_pos, &sprt_table->sgrt_vmas, sgrt_link)
+    {
+        if (sprt_pos->start > sprt_map->start)
+            break;
+    }
+    list_head_add_tail(&sprt_pos->sgrt_link, &sprt_map->sgrt_link);
+
+    mutex_unlock(&sprt_table->sgrt_mutex);
+
+    return (void *)sprt_map->start;
+}
+
+/*!
+ * @brief   fwk_do_munmap
+ * @param   addr: returned by virt_mmap
+ * @param   length: the same as virt_mmap
+ * @retval  errno
+ * @note    a mapping can only be removed as a whole
+ */
+static kint32_t fwk_do_munmap(void *addr, kusize_t length)
+{
+    struct fwk_file_table *sprt_table;
+    struct fwk_vm_map *sprt_map;
+    kint32_t retval = -ER_NOTFOUND;
+
+    if (!addr || !length)
+        return -ER_UNVALID;
+
+    sprt_table = fwk_get_files();
+
+    mutex_lock(&sprt_table->sgrt_mutex);
+
+    foreach_list_next_entry(sprt_map, &sprt_table->sgrt_vmas, sgrt_link)
+    {
+        if (sprt_map->start > (kuaddr_t)addr)
+            break;
+
+        if (sprt_map->start != (kuaddr_t)addr)
+            continue;
+
+        if (sprt_map->size != length)
+        {
+            retval = -ER_UNVALID;
+            continue;
+        }
+
+        list_head_del(&sprt_map->sgrt_link);
+        kfree(sprt_map);
+        retval = ER_NORMAL;
+
+        break;
+    }
+
+    mutex_unlock(&sprt_table->sgrt_mutex);
+
+    return retval;
+}
+
+/*!
+ * @brief   add wait queue to poll table
+ * @param   sprt_file: file being polled
+ * @param   sprt_wqh: woken up by driver when the file becomes ready
+ * @param   sprt_pt: null if caller does not wait
+ * @retval  none
+ * @note    called by "poll" of file, before it checks the state of device
+ */
+void fwk_poll_wait(struct fwk_file *sprt_file, struct wait_queue_head *sprt_wqh, struct fwk_poll_table *sprt_pt)
+{
+    struct fwk_poll_entry *sprt_entry;
+
+    if (!sprt_pt || !sprt_wqh || !sprt_pt->sprt_task)
+        return;
+
+    if (sprt_pt->num >= sprt_pt->max)
+    {
+        sprt_pt->is_overflow = true;
+        return;
+    }
+
+    sprt_entry = &sprt_pt->sprt_entry[sprt_pt->num++];
+    sprt_entry->sprt_wqh = sprt_wqh;
+    sprt_entry->sgrt_wq.sprt_task = sprt_pt->sprt_task;
+    init_list_head(&sprt_entry->sgrt_wq.sgrt_link);
+
+    add_wait_queue(sprt_wqh, &sprt_entry->sgrt_wq);
+}
+
+/*!
+ * @brief   get ready events of one descriptor
+ * @param   fd, events
+ * @param   sprt_pt: wait queues are added to it, can be null
+ * @retval  revents
+ * @note    none
+ */
+static kuint32_t fwk_do_poll_fd(kint32_t fd, kuint32_t events, struct fwk_poll_table *sprt_pt)
+{
+    struct fwk_file *sprt_file;
+    kuint32_t mask;
+
+    if (fd >= NETWORK_SOCKETS_BASE)
+        mask = network_poll(fd, sprt_pt);
+    else
+    {
+        sprt_file = fwk_fd_to_file(fd);
+        if (!isValid(sprt_file) || !sprt_file->sprt_foprts)
+            return POLLNVAL;
+
+        mask = sprt_file->sprt_foprts->poll ? 
+                    sprt_file->sprt_foprts->poll(sprt_file, sprt_pt) : FWK_POLL_DEFAULT_MASK;
+    }
+
+    /*!< these are always reported */
+    return mask & (events | POLLERR | POLLHUP | POLLNVAL);
+}
+
+/*!
+ * @brief   fwk_do_poll
+ * @param   sprt_fds, nfds
+ * @param   timeout: unit: ms, < 0: forever, 0: return at once
+ * @retval  number of ready descriptors, or errno
+ * @note    the wait queues of all files are registered by the first scan, then the thread yields until
+ *          any of them is woken up (or time out) and scans again. Before the scheduler runs, it only scans once
+ */
+static kint32_t fwk_do_poll(struct fwk_pollfd *sprt_fds, kuint32_t nfds, kint32_t timeout)
+{
+    struct fwk_poll_entry sgrt_entry[FWK_POLL_STACK_ENTRIES];
+    struct fwk_poll_entry *sprt_alloc = mrt_nullptr;
+    struct fwk_poll_table sgrt_pt, *sprt_pt;
+    struct thread *sprt_task = mrt_current;
+    kutime_t expires = 0;
+    kuint32_t idx, mask;
+    kint32_t count;
+
+    if (!sprt_fds && nfds)
+        return -ER_UNVALID;
+
+    sgrt_pt.sprt_task = sprt_task;
+    sgrt_pt.num = 0;
+    sgrt_pt.max = ARRAY_SIZE(sgrt_entry);
+    sgrt_pt.is_overflow = false;
+    sgrt_pt.sprt_entry = sgrt_entry;
+
+    /*!< nothing to wait for */
+    sprt_pt = (timeout && sprt_task) ? &sgrt_pt : mrt_nullptr;
+
+    if (sprt_pt && ((nfds * FWK_POLL_WAITS_PER_FD) > sgrt_pt.max))
+    {
+        sprt_alloc = kcalloc(sizeof(*sprt_alloc), nfds * FWK_POLL_WAITS_PER_FD, GFP_KERNEL);
+        if (isValid(sprt_alloc))
+        {
+            sgrt_pt.sprt_entry = sprt_alloc;
+            sgrt_pt.max = nfds * FWK_POLL_WAITS_PER_FD;
+        }
+    }
+
+    if (timeout > 0)
+        expires = jiffies + msecs_to_jiffies(timeout);
+
+    if (sprt_pt)
+    {
+        /*!< drop the wakeup left by others, then let wake_up() mark this thread */
+        thread_state_pending(sprt_task);
+        thread_state_signal(sprt_task, NR_THREAD_SIG_NORMAL, true);
+        thread_state_signal(sprt_task, NR_THREAD_SIG_INTR, true);
+    }
+
+    for (;;)
+    {
+        count = 0;
+
+        for (idx = 0; idx < nfds; idx++)
+        {
+            if (sprt_fds[idx].fd < 0)
+            {
+                sprt_fds[idx].revents = 0;
+                continue;
+            }
+
+            mask = fwk_do_poll_fd(sprt_fds[idx].fd, (kuint16_t)sprt_fds[idx].events, sprt_pt);
+            sprt_fds[idx].revents = (kint16_t)mask;
+            if (mask)
+                count++;
+        }
+
+        /*!< wait queues are kept until return */
+        sprt_pt = mrt_nullptr;
+
+        if (count || !timeout || !sprt_task)
+            break;
+
+        if ((timeout > 0) && !mrt_time_after(expires, jiffies))
+            break;
+
+        /*!< woken up by any wait queue; if some could not be registered, scan every time slice */
+        do {
+            schedule_thread();
+
+        } while (!sgrt_pt.is_overflow && !thread_state_pending(sprt_task) && 
+                ((timeout < 0) || mrt_time_after(expires, jiffies)));
+    }
+
+    if (sprt_task && timeout)
+    {
+        thread_state_signal(sprt_task, NR_THREAD_SIG_NORMAL, false);
+        thread_state_signal(sprt_task, NR_THREAD_SIG_INTR, false);
+
+        for (idx = 0; idx < sgrt_pt.num; idx++)
+            remove_wait_queue(sgrt_pt.sprt_entry[idx].sprt_wqh, &sgrt_pt.sprt_entry[idx].sgrt_wq);
+    }
+
+    if (sprt_alloc)
+        kfree(sprt_alloc);
+
+    return count;
+}
+
+/*!
+ * @brief   fwk_do_select
+ * @param   nfds: the highest descriptor + 1
+ * @param   sprt_rfds, sprt_wfds, sprt_efds: can be null; replaced by ready descriptors
+ * @param   sprt_tm: null: forever
+ * @retval  number of ready bits, or errno
+ * @note    converted to fwk_do_poll
+ */
+static kint32_t fwk_do_select(kint32_t nfds, struct fwk_fd_set *sprt_rfds, struct fwk_fd_set *sprt_wfds,
+                            struct fwk_fd_set *sprt_efds, struct time_spec *sprt_tm)
+{
+    struct fwk_pollfd *sprt_fds;
+    kuint32_t events, num = 0, idx;
+    kint32_t fd, retval;
+
+    if ((nfds < 0) || (nfds > FWK_FD_SETSIZE))
+        return -ER_UNVALID;
+
+    sprt_fds = kcalloc(sizeof(*sprt_fds), nfds + 1, GFP_KERNEL);
+    if (!isValid(sprt_fds))
+        return -ER_NOMEM;
+
+    for (fd = 0; fd < nfds; fd++)
+    {
+        events  = (sprt_rfds && FWK_FD_ISSET(fd, sprt_rfds)) ? FWK_POLLIN_SET : 0;
+        events |= (sprt_wfds && FWK_FD_ISSET(fd, sprt_wfds)) ? FWK_POLLOUT_SET : 0;
+        events |= (sprt_efds && FWK_FD_ISSET(fd, sprt_efds)) ? FWK_POLLEX_SET : 0;
+
+        if (!events)
+            continue;
+
+        sprt_fds[num].fd = fd;
+        sprt_fds[num].events = (kint16_t)events;
+        num++;
+    }
+
+    retval = fwk_do_poll(sprt_fds, num, sprt_tm ? (kint32_t)time_spec_to_msecs(sprt_tm) : -1);
+    if (retval < 0)
+        goto out;
+
+    for (idx = 0; idx < num; idx++)
+    {
+        if (sprt_fds[idx].revents & POLLNVAL)
+        {
+            retval = -ER_UNVALID;
+            goto out;
+        }
+    }
+
+    if (sprt_rfds)
+        FWK_FD_ZERO(sprt_rfds);
+    if (sprt_wfds)
+        FWK_FD_ZERO(sprt_wfds);
+    if (sprt_efds)
+        FWK_FD_ZERO(sprt_efds);
+
+    retval = 0;
+    for (idx = 0; idx < num; idx++)
+    {
+        fd = sprt_fds[idx].fd;
+        events = (kuint16_t)sprt_fds[idx].revents;
+
+        if (sprt_rfds && (events & FWK_POLLIN_SET) && (sprt_fds[idx].events & POLLIN))
+        {
+            FWK_FD_SET(fd, sprt_rfds);
+            retval++;
+        }
+
+        if (sprt_wfds && (events & FWK_POLLOUT_SET) && (sprt_fds[idx].events & POLLOUT))
+        {
+            FWK_FD_SET(fd, sprt_wfds);
+            retval++;
+        }
+
+        if (sprt_efds && (events & FWK_POLLEX_SET))
+        {
+            FWK_FD_SET(fd, sprt_efds);
+            retval++;
+        }
+    }
+
+out:
+    kfree(sprt_fds);
+    return retval;
 }
 
 /*!< ------------------------------------------------------------ */
@@ -545,6 +1257,62 @@ kssize_t virt_read(kint32_t fd, void *buf, kusize_t size)
     return fwk_do_read(fd, buf, size);
 }
 
+/*!
+ * @brief   virt_readv
+ * @param   fd, sprt_iov, iovcnt (<= FWK_IOV_MAX)
+ * @retval  total size read, or errno
+ * @note    The interface is provided for use by the application layer
+ */
+kssize_t virt_readv(kint32_t fd, const struct fwk_iovec *sprt_iov, kint32_t iovcnt)
+{
+    if (fd >= NETWORK_SOCKETS_BASE)
+        return ER_NORMAL;
+
+    return fwk_do_readv(fd, sprt_iov, iovcnt);
+}
+
+/*!
+ * @brief   virt_writev
+ * @param   fd, sprt_iov, iovcnt (<= FWK_IOV_MAX)
+ * @retval  total size written, or errno
+ * @note    The interface is provided for use by the application layer
+ */
+kssize_t virt_writev(kint32_t fd, const struct fwk_iovec *sprt_iov, kint32_t iovcnt)
+{
+    if (fd >= NETWORK_SOCKETS_BASE)
+        return ER_NORMAL;
+
+    return fwk_do_writev(fd, sprt_iov, iovcnt);
+}
+
+/*!
+ * @brief   virt_pread
+ * @param   fd, buf, size, offset
+ * @retval  size read, or errno
+ * @note    The interface is provided for use by the application layer
+ */
+kssize_t virt_pread(kint32_t fd, void *buf, kusize_t size, kuint32_t offset)
+{
+    if (fd >= NETWORK_SOCKETS_BASE)
+        return -ER_FORBID;
+
+    return fwk_do_pread(fd, buf, size, offset);
+}
+
+/*!
+ * @brief   virt_pwrite
+ * @param   fd, buf, size, offset
+ * @retval  size written, or errno
+ * @note    The interface is provided for use by the application layer
+ */
+kssize_t virt_pwrite(kint32_t fd, const void *buf, kusize_t size, kuint32_t offset)
+{
+    if (fd >= NETWORK_SOCKETS_BASE)
+        return -ER_FORBID;
+
+    return fwk_do_pwrite(fd, buf, size, offset);
+}
+
 /*!
  * @brief   virt_ioctl
  * @param   none
@@ -588,7 +1356,32 @@ void *virt_mmap(void *addr, kusize_t length, kint32_t prot, kint32_t flags, kint
  */
 kint32_t virt_munmap(void *addr, kusize_t length)
 {
-    return 0;
+    return fwk_do_munmap(addr, length);
+}
+
+/*!
+ * @brief   virt_poll
+ * @param   sprt_fds, nfds
+ * @param   timeout: unit: ms, < 0: forever
+ * @retval  number of ready descriptors, 0 if time out, or errno
+ * @note    The interface is provided for use by the application layer
+ */
+kint32_t virt_poll(struct fwk_pollfd *sprt_fds, kuint32_t nfds, kint32_t timeout)
+{
+    return fwk_do_poll(sprt_fds, nfds, timeout);
+}
+
+/*!
+ * @brief   virt_select
+ * @param   nfds, sprt_rfds, sprt_wfds, sprt_efds
+ * @param   sprt_tm: null: forever
+ * @retval  number of ready descriptors in all sets, 0 if time out, or errno
+ * @note    The interface is provided for use by the application layer
+ */
+kint32_t virt_select(kint32_t nfds, struct fwk_fd_set *sprt_rfds, struct fwk_fd_set *sprt_wfds,
+                            struct fwk_fd_set *sprt_efds, struct time_spec *sprt_tm)
+{
+    return fwk_do_select(nfds, sprt_rfds, sprt_wfds, sprt_efds, sprt_tm);
 }
 
 /*!< end of file */
@@ -15,11 +15,314 @@
 #include <platform/fwk_inode.h>
 #include <kernel/spinlock.h>
 
+/*!< The defines */
+/*!< path component cache, entries are taken from a static pool and never freed */
+#ifdef CONFIG_KOBJ_DCACHE_NUM
+#define FWK_KOBJ_DCACHE_NUM                     (CONFIG_KOBJ_DCACHE_NUM)
+#else
+#define FWK_KOBJ_DCACHE_NUM                     (256)
+#endif
+
+#define FWK_KOBJ_DCACHE_HASH                    (64)            /*!< power of 2 */
+#define FWK_KOBJ_DCACHE_NAME_LEN                (32)            /*!< longer names are not cached */
+
+/*!< one component of path: (directory, name, dir or file) -> kobject, or nothing (negative) */
+struct fwk_kobj_dentry
+{
+    struct fwk_kset *sprt_dir;
+    struct fwk_kobject *sprt_kobj;              /*!< null: not existed */
+    kuint32_t hash;
+    kuint16_t lenth;
+    kbool_t is_dir;
+    kbool_t used;
+    kchar_t name[FWK_KOBJ_DCACHE_NAME_LEN];
+
+    struct fwk_kobj_dentry *sprt_next;
+};
+
 /*!< The globals */
 static struct fwk_kset sgrt_fwk_kset_root;
 static kbool_t is_fwk_root_existed = false;
 
-/*!< API function */
+/*!<
+ * readers do not lock: they sample g_fwk_kobj_dcache_seq before and after walking a chain,
+ * and fall back to scanning the directory if it was odd or has changed.
+ * Entries are never freed, so a reader that races with a writer never touches freed memory
+ */
+static struct fwk_kobj_dentry sgrt_fwk_kobj_dcache[FWK_KOBJ_DCACHE_NUM];
+static struct fwk_kobj_dentry *sprt_fwk_kobj_dcache_hash[FWK_KOBJ_DCACHE_HASH];
+static volatile kuint32_t g_fwk_kobj_dcache_seq = 0;
+static kuint32_t g_fwk_kobj_dcache_gen = 0;                     /*!< increased by every invalidation */
+static kuint32_t g_fwk_kobj_dcache_victim = 0;
+static struct spin_lock sgrt_fwk_kobj_dcache_lock = SPIN_LOCK_INIT();
+
+/*!< The functions */
+/*!
+ * @brief   hash of path component
+ * @param   sprt_dir, name, lenth, is_dir
+ * @retval  hash
+ * @note    none
+ */
+static kuint32_t fwk_kobj_dcache_hash(struct fwk_kset *sprt_dir, const kchar_t *name, kusize_t lenth, kbool_t is_dir)
+{
+    kuint32_t hash = 5381;
+
+    while (lenth--)
+        hash = ((hash << 5) + hash) ^ (kuint8_t)(*name++);
+
+    return hash ^ ((kuint32_t)(kuaddr_t)sprt_dir >> 3) ^ (is_dir ? 0x80000000U : 0);
+}
+
+/*!
+ * @brief   unlink entry from its chain
+ * @param   sprt_dentry
+ * @retval  none
+ * @note    lock must be held, and sequence must be odd
+ */
+static void fwk_kobj_dcache_unlink(struct fwk_kobj_dentry *sprt_dentry)
+{
+    struct fwk_kobj_dentry **sprt_pos;
+
+    if (!sprt_dentry->used)
+        return;
+
+    sprt_pos = &sprt_fwk_kobj_dcache_hash[sprt_dentry->hash & (FWK_KOBJ_DCACHE_HASH - 1)];
+    for (; *sprt_pos; sprt_pos = &(*sprt_pos)->sprt_next)
+    {
+        if (*sprt_pos == sprt_dentry)
+        {
+            *sprt_pos = sprt_dentry->sprt_next;
+            break;
+        }
+    }
+
+    sprt_dentry->used = false;
+}
+
+/*!
+ * @brief   look up path component without lock
+ * @param   sprt_dir, name, lenth, is_dir
+ * @param   sprt_result: output, null if the component is known to be not existed
+ * @retval  ER_NORMAL: hit; -ER_NOTFOUND: not cached, or cache is changing
+ * @note    none
+ */
+static kint32_t fwk_kobj_dcache_lookup(struct fwk_kset *sprt_dir, const kchar_t *name, kusize_t lenth,
+                                    kbool_t is_dir, struct fwk_kobject **sprt_result)
+{
+    struct fwk_kobj_dentry *sprt_dentry;
+    struct fwk_kobject *sprt_kobj = mrt_nullptr;
+    kuint32_t hash, seq, steps;
+    kbool_t found = false;
+
+    if (lenth >= FWK_KOBJ_DCACHE_NAME_LEN)
+        return -ER_NOTFOUND;
+
+    hash = fwk_kobj_dcache_hash(sprt_dir, name, lenth, is_dir);
+
+    seq = g_fwk_kobj_dcache_seq;
+    if (seq & 1)
+        return -ER_NOTFOUND;
+    mrt_barrier();
+
+    /*!< steps: a chain being changed can not make a reader loop forever */
+    sprt_dentry = sprt_fwk_kobj_dcache_hash[hash & (FWK_KOBJ_DCACHE_HASH - 1)];
+    for (steps = 0; sprt_dentry && (steps < FWK_KOBJ_DCACHE_NUM); steps++, sprt_dentry = sprt_dentry->sprt_next)
+    {
+        if ((sprt_dentry->hash != hash) || (sprt_dentry->sprt_dir != sprt_dir) ||
+            (sprt_dentry->is_dir != is_dir) || (sprt_dentry->lenth != lenth))
+            continue;
+
+        if (!strncmp(sprt_dentry->name, name, lenth))
+        {
+            sprt_kobj = sprt_dentry->sprt_kobj;
+            found = true;
+            break;
+        }
+    }
+
+    mrt_barrier();
+    if (!found || (seq != g_fwk_kobj_dcache_seq))
+        return -ER_NOTFOUND;
+
+    *sprt_result = sprt_kobj;
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   cache result of scanning directory
+ * @param   sprt_dir, name, lenth, is_dir
+ * @param   sprt_kobj: found, null for negative entry
+ * @param   gen: g_fwk_kobj_dcache_gen before scanning
+ * @retval  none
+ * @note    dropped if anything is invalidated since the scan started, the result may be stale then
+ */
+static void fwk_kobj_dcache_insert(struct fwk_kset *sprt_dir, const kchar_t *name, kusize_t lenth,
+                                    kbool_t is_dir, struct fwk_kobject *sprt_kobj, kuint32_t gen)
+{
+    struct fwk_kobj_dentry *sprt_dentry;
+    struct fwk_kobject *sprt_exist;
+    kuint32_t hash, idx;
+
+    if (lenth >= FWK_KOBJ_DCACHE_NAME_LEN)
+        return;
+
+    /*!< another thread may have added it */
+    if (!fwk_kobj_dcache_lookup(sprt_dir, name, lenth, is_dir, &sprt_exist))
+        return;
+
+    hash = fwk_kobj_dcache_hash(sprt_dir, name, lenth, is_dir);
+
+    spin_lock(&sgrt_fwk_kobj_dcache_lock);
+
+    if (gen != g_fwk_kobj_dcache_gen)
+        goto out;
+
+    /*!< reuse entries in turn, used or not */
+    idx = g_fwk_kobj_dcache_victim;
+    g_fwk_kobj_dcache_victim = (idx + 1) % FWK_KOBJ_DCACHE_NUM;
+    sprt_dentry = &sgrt_fwk_kobj_dcache[idx];
+
+    g_fwk_kobj_dcache_seq++;
+    mrt_barrier();
+
+    fwk_kobj_dcache_unlink(sprt_dentry);
+
+    sprt_dentry->sprt_dir = sprt_dir;
+    sprt_dentry->sprt_kobj = sprt_kobj;
+    sprt_dentry->hash = hash;
+    sprt_dentry->lenth = (kuint16_t)lenth;
+    sprt_dentry->is_dir = is_dir;
+    kmemcpy(sprt_dentry->name, name, lenth);
+    sprt_dentry->name[lenth] = '\0';
+
+    sprt_dentry->sprt_next = sprt_fwk_kobj_dcache_hash[hash & (FWK_KOBJ_DCACHE_HASH - 1)];
+    sprt_dentry->used = true;
+    sprt_fwk_kobj_dcache_hash[hash & (FWK_KOBJ_DCACHE_HASH - 1)] = sprt_dentry;
+
+    mrt_barrier();
+    g_fwk_kobj_dcache_seq++;
+
+out:
+    spin_unlock(&sgrt_fwk_kobj_dcache_lock);
+}
+
+/*!
+ * @brief   invalidate cached entries
+ * @param   sprt_dir, name: drop entries of this name in this directory (negative ones), name can be null
+ * @param   sprt_kobj: drop entries that point to it, or that are in it if it is a directory; can be null
+ * @retval  none
+ * @note    walks the whole pool, it is only called when the tree changes
+ */
+static void fwk_kobj_dcache_invalidate(struct fwk_kset *sprt_dir, const kchar_t *name, struct fwk_kobject *sprt_kobj)
+{
+    struct fwk_kobj_dentry *sprt_dentry;
+    struct fwk_kset *sprt_self;
+    kusize_t lenth;
+    kuint32_t idx;
+
+    lenth = name ? kstrlen(name) : 0;
+    sprt_self = sprt_kobj ? mrt_fwk_kset_get(sprt_kobj) : mrt_nullptr;
+
+    spin_lock(&sgrt_fwk_kobj_dcache_lock);
+
+    g_fwk_kobj_dcache_gen++;
+    g_fwk_kobj_dcache_seq++;
+    mrt_barrier();
+
+    for (idx = 0; idx < FWK_KOBJ_DCACHE_NUM; idx++)
+    {
+        sprt_dentry = &sgrt_fwk_kobj_dcache[idx];
+        if (!sprt_dentry->used)
+            continue;
+
+        if ((sprt_kobj && (sprt_dentry->sprt_kobj == sprt_kobj)) ||
+            (sprt_self && (sprt_dentry->sprt_dir == sprt_self)) ||
+            (name && (sprt_dentry->sprt_dir == sprt_dir) && (sprt_dentry->lenth == lenth) &&
+             !strncmp(sprt_dentry->name, name, lenth)))
+            fwk_kobj_dcache_unlink(sprt_dentry);
+    }
+
+    mrt_barrier();
+    g_fwk_kobj_dcache_seq++;
+
+    spin_unlock(&sgrt_fwk_kobj_dcache_lock);
+}
+
+/*!
+ * @brief   drop all cached entries
+ * @param   none
+ * @retval  none
+ * @note    used when a directory is removed: entries of its whole subtree are keyed by
+ *          kset pointers that are about to be freed, and they can not be told apart here
+ */
+static void fwk_kobj_dcache_flush(void)
+{
+    kuint32_t idx;
+
+    spin_lock(&sgrt_fwk_kobj_dcache_lock);
+
+    g_fwk_kobj_dcache_gen++;
+    g_fwk_kobj_dcache_seq++;
+    mrt_barrier();
+
+    for (idx = 0; idx < FWK_KOBJ_DCACHE_HASH; idx++)
+        sprt_fwk_kobj_dcache_hash[idx] = mrt_nullptr;
+
+    for (idx = 0; idx < FWK_KOBJ_DCACHE_NUM; idx++)
+    {
+        sgrt_fwk_kobj_dcache[idx].used = false;
+        sgrt_fwk_kobj_dcache[idx].sprt_next = mrt_nullptr;
+    }
+
+    mrt_barrier();
+    g_fwk_kobj_dcache_seq++;
+
+    spin_unlock(&sgrt_fwk_kobj_dcache_lock);
+}
+
+/*!
+ * @brief   find one component of path in directory
+ * @param   sprt_kset: directory
+ * @param   name, lenth: component, not terminated
+ * @param   is_dir: find directory or file
+ * @retval  kobject, null if not existed
+ * @note    the cache is tried first; the directory is scanned on miss, and the result is cached
+ */
+static struct fwk_kobject *fwk_kobject_lookup_child(struct fwk_kset *sprt_kset, const kchar_t *name,
+                                                kusize_t lenth, kbool_t is_dir)
+{
+    struct fwk_kobject *sprt_kobj, *sprt_found = mrt_nullptr;
+    kuint32_t gen;
+
+    if (!fwk_kobj_dcache_lookup(sprt_kset, name, lenth, is_dir, &sprt_found))
+        return sprt_found;
+
+    gen = g_fwk_kobj_dcache_gen;
+    mrt_barrier();
+
+    spin_lock(&sprt_kset->sgrt_kobj.sgrt_lock);
+
+    foreach_list_next_entry(sprt_kobj, &sprt_kset->sgrt_list, sgrt_link)
+    {
+        /*!< it is possible that file and directory have the same name */
+        if (!sprt_kobj->name || (sprt_kobj->is_dir != is_dir))
+            continue;
+
+        if (!strncmp(name, sprt_kobj->name, lenth) && (sprt_kobj->name[lenth] == '\0'))
+        {
+            sprt_found = sprt_kobj;
+            break;
+        }
+    }
+
+    spin_unlock(&sprt_kset->sgrt_kobj.sgrt_lock);
+
+    fwk_kobj_dcache_insert(sprt_kset, name, lenth, is_dir, sprt_found, gen);
+
+    return sprt_found;
+}
+
 /*!
  * @brief   join the new kobject to kset
  * @param   sprt_kobj
@@ -60,6 +363,9 @@ static kint32_t fwk_kobject_join_to_kset(struct fwk_kobject *sprt_kobj)
     sprt_kobj->sprt_parent = sprt_parent;
     spin_unlock(&sprt_kobj->sgrt_lock);
 
+    /*!< "not existed" may be cached for this name */
+    fwk_kobj_dcache_invalidate(sprt_kobj->sprt_kset, sprt_kobj->name, mrt_nullptr);
+
     return ER_NORMAL;
 
 fail:
@@ -81,6 +387,11 @@ static void fwk_kobject_detach_from_kset(struct fwk_kobject *sprt_kobj)
     spin_lock(&sprt_kobj->sgrt_lock);
     list_head_del_safe(&sprt_kobj->sprt_kset->sgrt_list, &sprt_kobj->sgrt_link);
     spin_unlock(&sprt_kobj->sgrt_lock);
+
+    if (sprt_kobj->is_dir)
+        fwk_kobj_dcache_flush();
+    else
+        fwk_kobj_dcache_invalidate(mrt_nullptr, mrt_nullptr, sprt_kobj);
 }
 
 /*!
@@ -110,6 +421,7 @@ static kint32_t fwk_kobject_build_inode(struct fwk_kobject *sprt_kobj)
     return ER_NORMAL;
 }
 
+/*!< API function */
 /*!
  * @brief   initialize kobject
  * @param   sprt_kobj
@@ -407,7 +719,7 @@ struct fwk_kobject *fwk_find_kobject_by_path(struct fwk_kobject *sprt_head, cons
     kusize_t lenth;
     struct fwk_kobject *sprt_kobj;
     struct fwk_kset *sprt_kset;
-    kbool_t found, is_root;
+    kbool_t is_root;
 
     sprt_kset = sprt_head ? mrt_fwk_kset_get(sprt_head) : &sgrt_fwk_kset_root;
     if (!sprt_kset || !is_fwk_root_existed)
@@ -440,47 +752,18 @@ struct fwk_kobject *fwk_find_kobject_by_path(struct fwk_kobject *sprt_head, cons
         /*!< if '/' can be found, str_start is a directory */
         str_end = kstrchr(str_start, '/');
         is_root = true;
-        found = false;
         lenth = str_end ? (kusize_t)(str_end - str_start) : kstrlen(str_start);
 
-        spin_lock(&sprt_kset->sgrt_kobj.sgrt_lock);
-
-        foreach_list_next_entry(sprt_kobj, &sprt_kset->sgrt_list, sgrt_link)
-        {
-            if (!sprt_kobj->name)
-                continue;
-
-            if (!strncmp(str_start, sprt_kobj->name, lenth))
-            {               
-                /*!< str_end ? directory : file; if file is existed, file is repeated */
-                if (!str_end)
-                {
-                    if (!sprt_kobj->is_dir)
-                    {
-                        spin_unlock(&sprt_kset->sgrt_kobj.sgrt_lock);
-                        return sprt_kobj;
-                    }
-                    
-                    continue;
-                }
-                
-                /*!< otherwise, it is a directory */
-                /*!< it is possible that file and directory have the same name */
-                if (!sprt_kobj->is_dir)
-                    continue;
-
-                spin_unlock(&sprt_kset->sgrt_kobj.sgrt_lock);
-                
-                found = true;
-                sprt_kset = mrt_fwk_kset_get(sprt_kobj);
-                goto out;
-            }
-        }
+        /*!< str_end ? directory : file */
+        sprt_kobj = fwk_kobject_lookup_child(sprt_kset, str_start, lenth, !!str_end);
+        if (!sprt_kobj)
+            break;
 
-        spin_unlock(&sprt_kset->sgrt_kobj.sgrt_lock);
+        if (!str_end)
+            return sprt_kobj;
 
-out:
-        if (!found || !sprt_kset)
+        sprt_kset = mrt_fwk_kset_get(sprt_kobj);
+        if (!sprt_kset)
             break;
     }
 
@@ -541,10 +824,17 @@ kint32_t fwk_kobject_rename(struct fwk_kobject *sprt_kobj, const kchar_t *fmt, .
     va_list sprt_list;
     kint32_t retval;
 
+    /*!< the old name is not valid any more */
+    fwk_kobj_dcache_invalidate(mrt_nullptr, mrt_nullptr, sprt_kobj);
+
     va_start(sprt_list, fmt);
     retval = fwk_kobject_set_name_args(sprt_kobj, fmt, sprt_list);
     va_end(sprt_list);
 
+    /*!< neither is "not existed" of the new one */
+    if (!retval && sprt_kobj->sprt_kset)
+        fwk_kobj_dcache_invalidate(sprt_kobj->sprt_kset, sprt_kobj->name, mrt_nullptr);
+
     return retval;
 }
 
@@ -40,4 +40,18 @@ kusize_t fwk_copy_to_user(void *ptr_user, void *ptr_Src, kusize_t size)
 	return size;
 }
 
+/*!
+ * @brief   set memory type of region
+ * @param   start, size
+ * @param   mem_type: refer to "__ERT_FWK_VM_TYPE"
+ * @retval  errno
+ * @note    called by virt_mmap. Memory is mapped 1:1 and MMU is off (start.S), so every access is
+ *          strongly ordered already and there is nothing to change; arch code that builds translation
+ *          tables overrides it to set the attributes of the region
+ */
+__weak kint32_t fwk_vm_set_memtype(kuaddr_t start, kusize_t size, kuint32_t mem_type)
+{
+	return (mem_type < NR_FWK_VM_TYPE_MAX) ? ER_NORMAL : -ER_UNVALID;
+}
+
 /*!< end of file */
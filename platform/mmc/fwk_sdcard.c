@@ -516,6 +516,10 @@ static kint32_t fwk_sdcard_command_get_scr(struct fwk_sdcard_cmd *sprt_cmd, stru
 
 #undef mrt_fwk_sdcard_scr_setflagbit
 
+    /*!< CMD_SUPPORT: bit1, card supports SET_BLOCK_COUNT (CMD23), host may use auto CMD23 for multi blocks */
+    if (mrt_isBitSetb(mrt_bit(1U), &sprt_card->sgrt_scr.commandSupport) && isValid(sprt_if->sprt_host))
+        mrt_setbitl(NR_SdCard_SupportSetBlockCount, &sprt_if->sprt_host->flagBit);
+
     switch (sprt_card->sgrt_scr.sdSpecification)
     {
         case 0U:
@@ -1151,9 +1155,9 @@ kint32_t fwk_sdcard_read_blocks(struct fwk_sdcard *sprt_card, void *ptrBuffer,
     if (iRetval)
         return -ER_RDATA_FAILD;
 
-    /*!< for reading multi blocks, it must send CMD12 to stop transmission */
+    /*!< for reading multi blocks, it must send CMD12 to stop transmission (unless host sent CMD12/CMD23 itself) */
     if ((sgrt_data.blockCount > 1U) &&
-    	(mrt_isBitResetl(NR_SdCard_CmdFlagsAuto12Enable, &sgrt_data.flags)))
+    	(mrt_isBitResetw(NR_SdCard_CmdFlagsAuto12Enable | NR_SdCard_CmdFlagsAuto23Enable, &sgrt_data.flags)))
     {
         iRetval = fwk_sdcard_send_command(sprt_card, fwk_sdcard_command_stop_transmission, 0U);
         if (iRetval)
@@ -1222,9 +1226,9 @@ kint32_t fwk_sdcard_write_blocks(struct fwk_sdcard *sprt_card, void *ptrBuffer,
     if (iRetval)
         return -ER_SDATA_FAILD;
 
-    /*!< for reading multi blocks, it must send CMD12 to stop transmission */
+    /*!< for reading multi blocks, it must send CMD12 to stop transmission (unless host sent CMD12/CMD23 itself) */
     if ((sgrt_data.blockCount > 1U) &&
-    	(mrt_isBitResetl(NR_SdCard_CmdFlagsAuto12Enable, &sgrt_data.flags)))
+    	(mrt_isBitResetw(NR_SdCard_CmdFlagsAuto12Enable | NR_SdCard_CmdFlagsAuto23Enable, &sgrt_data.flags)))
     {
         iRetval = fwk_sdcard_send_command(sprt_card, fwk_sdcard_command_stop_transmission, 0U);
         if (iRetval)
@@ -1311,6 +1315,17 @@ __weak void *host_sdmmc_card_initial(struct fwk_sdcard *sprt_card)
     return mrt_nullptr;
 }
 
+/*!
+ * @brief   host_sdmmc_card_exit
+ * @param   sprt_host
+ * @retval  none
+ * @note    release resources that host allocated itself (privData, irq, ...)
+ */
+__weak void host_sdmmc_card_exit(struct fwk_sdcard_host *sprt_host)
+{
+
+}
+
 /*!
  * @brief   check if card is inserted
  * @param   sprt_card
@@ -1394,6 +1409,8 @@ void fwk_sdcard_free_device(struct fwk_sdcard *sprt_card)
         return;
 
     sprt_host = sprt_card->sgrt_if.sprt_host;
+    if (isValid(sprt_host))
+        host_sdmmc_card_exit(sprt_host);
     
     if (isValid(sprt_host) && sprt_host->isSelfDync)
     {
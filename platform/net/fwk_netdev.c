@@ -13,6 +13,7 @@
 /*!< The includes */
 #include <platform/fwk_basic.h>
 #include <platform/net/fwk_netdev.h>
+#include <platform/net/fwk_skbuff.h>
 #include <platform/fwk_platform.h>
 #include <platform/fwk_platdev.h>
 
@@ -21,6 +22,7 @@
 
 /*!< The globals */
 static DECLARE_LIST_HEAD(sgrt_fwk_net_device_list);
+static struct spin_lock sgrt_fwk_net_device_lock = SPIN_LOCK_INIT();
 static kuint32_t g_fwk_allocated_ins[mrt_num_align(NETDEV_IF_INS_MAX, RET_BITS_PER_INT) / RET_BITS_PER_INT] = { 0 };
 
 /*!< API function */
@@ -92,18 +94,68 @@ static void fwk_net_invalidate_name(struct fwk_net_device *sprt_ndev)
 }
 
 /*!
- * @brief   Allocate network device
- * @param   none
+ * @brief   release rx queues
+ * @param   sprt_rx, rxqs
  * @retval  none
  * @note    none
  */
+static void fwk_netdev_free_rx_queues(struct fwk_netdev_rx_queue *sprt_rx, kuint32_t rxqs)
+{
+    for (kuint32_t idx = 0; idx < rxqs; idx++)
+        fwk_skb_ring_destroy(&sprt_rx[idx].sgrt_ring);
+
+    kfree(sprt_rx);
+}
+
+/*!
+ * @brief   allocate rx queues
+ * @param   sprt_ndev, rxqs
+ * @retval  rx queues
+ * @note    every queue owns a ring with NETDEV_RXQ_RING_SIZE slots
+ */
+static struct fwk_netdev_rx_queue *fwk_netdev_alloc_rx_queues(struct fwk_net_device *sprt_ndev, kuint32_t rxqs)
+{
+    struct fwk_netdev_rx_queue *sprt_rx;
+    kuint32_t idx;
+
+    sprt_rx = (struct fwk_netdev_rx_queue *)kzalloc(rxqs * sizeof(*sprt_rx), GFP_KERNEL);
+    if (!isValid(sprt_rx))
+        return ERR_PTR(-ER_NOMEM);
+
+    for (idx = 0; idx < rxqs; idx++)
+    {
+        if (fwk_skb_ring_init(&sprt_rx[idx].sgrt_ring, NETDEV_RXQ_RING_SIZE, GFP_KERNEL))
+            goto fail;
+
+        sprt_rx[idx].sprt_ndev = sprt_ndev;
+        sprt_rx[idx].queue_index = idx;
+    }
+
+    return sprt_rx;
+
+fail:
+    fwk_netdev_free_rx_queues(sprt_rx, idx);
+    return ERR_PTR(-ER_NOMEM);
+}
+
+/*!
+ * @brief   Allocate network device
+ * @param   sizeof_priv, name, setup
+ * @param   queue_count: number of tx/rx queues
+ * @retval  network device
+ * @note    none
+ */
 struct fwk_net_device *fwk_alloc_netdev_mq(kint32_t sizeof_priv, const kchar_t *name,
-                                    void (*setup) (struct fwk_net_device *sprt_ndev), kuint32_t txqs)
+                                    void (*setup) (struct fwk_net_device *sprt_ndev), kuint32_t queue_count)
 {
     struct fwk_net_device *sprt_netdev;
     struct fwk_netdev_queue *sprt_tx;
+    struct fwk_netdev_rx_queue *sprt_rx;
     kint32_t alloc_size = 0;
 
+    if (!queue_count)
+        return ERR_PTR(-ER_UNVALID);
+
     alloc_size = sizeof(*sprt_netdev);
     if (sizeof_priv > 0)
         alloc_size = mrt_align(alloc_size, sizeof(kutype_t));
@@ -114,17 +166,30 @@ struct fwk_net_device *fwk_alloc_netdev_mq(kint32_t sizeof_priv, const kchar_t *
     if (!isValid(sprt_netdev))
         return ERR_PTR(-ER_NOMEM);
 
-    sprt_tx = (struct fwk_netdev_queue *)kzalloc(txqs * sizeof(*sprt_tx), GFP_KERNEL);
+    sprt_tx = (struct fwk_netdev_queue *)kzalloc(queue_count * sizeof(*sprt_tx), GFP_KERNEL);
     if (!isValid(sprt_tx))
+        goto fail1;
+
+    sprt_rx = fwk_netdev_alloc_rx_queues(sprt_netdev, queue_count);
+    if (!isValid(sprt_rx))
+        goto fail2;
+
+    for (kuint32_t idx = 0; idx < queue_count; idx++)
     {
-        kfree(sprt_netdev);
-        return ERR_PTR(-ER_NOMEM);
+        sprt_tx[idx].sprt_ndev = sprt_netdev;
+        sprt_tx[idx].queue_index = idx;
     }
 
     /*!< register send queue */
     sprt_netdev->sprt_tx = sprt_tx;
-    sprt_netdev->num_tx_queues = txqs;
-    sprt_netdev->real_num_tx_queues = txqs;
+    sprt_netdev->num_tx_queues = queue_count;
+    sprt_netdev->real_num_tx_queues = queue_count;
+
+    /*!< register receive queue */
+    sprt_netdev->sprt_rx = sprt_rx;
+    sprt_netdev->num_rx_queues = queue_count;
+    sprt_netdev->real_num_rx_queues = queue_count;
+
     sprt_netdev->private_data = (sizeof_priv > 0) ? (((void *)sprt_netdev) + alloc_size) : mrt_nullptr;
     sprt_netdev->ifindex = -1;
 
@@ -135,6 +200,12 @@ struct fwk_net_device *fwk_alloc_netdev_mq(kint32_t sizeof_priv, const kchar_t *
         setup(sprt_netdev);
 
     return sprt_netdev;
+
+fail2:
+    kfree(sprt_tx);
+fail1:
+    kfree(sprt_netdev);
+    return ERR_PTR(-ER_NOMEM);
 }
 
 /*!
@@ -152,9 +223,52 @@ void fwk_free_netdev(struct fwk_net_device *sprt_ndev)
     if (isValid(sprt_ndev->sprt_tx))
         kfree(sprt_ndev->sprt_tx);
 
+    if (isValid(sprt_ndev->sprt_rx))
+        fwk_netdev_free_rx_queues(sprt_ndev->sprt_rx, sprt_ndev->num_rx_queues);
+
+    fwk_skb_cache_destroy(sprt_ndev);
+
     kfree(sprt_ndev);
 }
 
+/*!
+ * @brief   lock netdev list
+ * @param   none
+ * @retval  none
+ * @note    held while walking the list with fwk_next_netdevice()
+ */
+void fwk_netdevice_lock(void)
+{
+    spin_lock(&sgrt_fwk_net_device_lock);
+}
+
+/*!
+ * @brief   unlock netdev list
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+void fwk_netdevice_unlock(void)
+{
+    spin_unlock(&sgrt_fwk_net_device_lock);
+}
+
+/*!
+ * @brief   get next netdev from list
+ * @param   sprt_ndev (base, null means the first one)
+ * @retval  netdev
+ * @note    caller must hold fwk_netdevice_lock()
+ */
+struct fwk_net_device *fwk_next_netdevice(struct fwk_net_device *sprt_ndev)
+{
+    if (!sprt_ndev)
+        return mrt_list_first_valid_entry(&sgrt_fwk_net_device_list, struct fwk_net_device, sgrt_link);
+    if (mrt_list_head_until(sprt_ndev, &sgrt_fwk_net_device_list, sgrt_link))
+        return mrt_nullptr;
+
+    return mrt_list_next_entry(sprt_ndev, sgrt_link);
+}
+
 /*!
  * @brief   get netdev by name
  * @param   name
@@ -165,12 +279,19 @@ struct fwk_net_device *fwk_ifname_to_ndev(const kchar_t *name)
 {
     struct fwk_net_device *sprt_ndev;
 
+    spin_lock(&sgrt_fwk_net_device_lock);
+
     foreach_list_next_entry(sprt_ndev, &sgrt_fwk_net_device_list, sgrt_link)
     {
         if (!strcmp(sprt_ndev->name, name))
+        {
+            spin_unlock(&sgrt_fwk_net_device_lock);
             return sprt_ndev;
+        }
     }
 
+    spin_unlock(&sgrt_fwk_net_device_lock);
+
     return mrt_nullptr;
 }
 
@@ -210,7 +331,10 @@ kint32_t fwk_register_netdevice(struct fwk_net_device *sprt_ndev)
     if (fwk_device_add(sprt_dev))
         goto fail2;
 
+    spin_lock(&sgrt_fwk_net_device_lock);
     list_head_add_tail(&sgrt_fwk_net_device_list, &sprt_ndev->sgrt_link);
+    spin_unlock(&sgrt_fwk_net_device_lock);
+
     return ER_NORMAL;
 
 fail2:
@@ -242,13 +366,17 @@ kint32_t fwk_unregister_netdevice(struct fwk_net_device *sprt_ndev)
     if (!fwk_ifname_to_ndev(sprt_ndev->name))
         return -ER_NODEV;
 
+    /*!< once it is off the list, rx thread does not touch its queues any more */
+    spin_lock(&sgrt_fwk_net_device_lock);
+    list_head_del(&sprt_ndev->sgrt_link);
+    spin_unlock(&sgrt_fwk_net_device_lock);
+
     sprt_dev = &sprt_ndev->sgrt_dev;
     mrt_dev_del_name(sprt_dev);
     if (sprt_ndev->sprt_netdev_oprts->ndo_uninit)
         sprt_ndev->sprt_netdev_oprts->ndo_uninit(sprt_ndev);
 
     fwk_net_invalidate_name(sprt_ndev);
-    list_head_del(&sprt_ndev->sgrt_link);
 
     return ER_NORMAL;
 }
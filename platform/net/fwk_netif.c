@@ -17,6 +17,7 @@
 #include <platform/net/fwk_skbuff.h>
 #include <platform/net/fwk_netif.h>
 #include <platform/net/fwk_ip.h>
+#include <platform/net/fwk_ether.h>
 #include <platform/net/fwk_icmp.h>
 #include <platform/net/fwk_udp.h>
 #include <platform/net/fwk_tcp.h>
@@ -25,9 +26,10 @@
 #include <kernel/sched.h>
 
 /*!< The defines */
+#define NETIF_RX_BUDGET                             (64)            /*!< max skbs taken from one rx queue each round */
 
 /*!< The globals */
-static struct fwk_sk_buff_head sgrt_fwk_skb_rx_lists;
+static struct fwk_sk_buff_head sgrt_fwk_skb_rx_lists;             /*!< only accessed by rx thread */
 
 /*!< API functions */
 /*!
@@ -253,7 +255,7 @@ kuint16_t fwk_ip_slow_csum(struct fwk_ip_hdr *sprt_iphdr, kuint16_t offset)
  * @brief   get global rx list
  * @param   none
  * @retval  rx list
- * @note    none
+ * @note    skbs are moved here from rx queues by rx thread
  */
 struct fwk_sk_buff_head *fwk_netif_rxq_get(void)
 {
@@ -355,6 +357,96 @@ out:
     return ER_NORMAL;
 }
 
+/*!
+ * @brief   calculate flow hash
+ * @param   sprt_skb
+ * @retval  hash
+ * @note    hash = (saddr, daddr, proto, sport, dport), packets of the same flow always get the same hash,
+ *          non-ip packets get 0 (and always go to queue 0)
+ */
+kuint32_t fwk_netif_flow_hash(struct fwk_sk_buff *sprt_skb)
+{
+    struct fwk_eth_hdr *sprt_ethhdr;
+    struct fwk_ip_hdr *sprt_iphdr;
+    struct fwk_udp_hdr *sprt_udphdr;
+    kuint8_t *mac;
+    kuint32_t hash;
+
+    if (sprt_skb->hash)
+        return sprt_skb->hash;
+
+    mac = (sprt_skb->mac_header == (typeof(sprt_skb->mac_header))(~0U)) ? 
+                                sprt_skb->data : fwk_skb_mac_header(sprt_skb);
+    if ((sprt_skb->tail - mac) < (NET_ETHER_HDR_LEN + NET_IP_HDR_LEN))
+        return 0;
+
+    sprt_ethhdr = (struct fwk_eth_hdr *)mac;
+    if (mrt_htons(sprt_ethhdr->h_proto) != NET_ETH_PROTO_IP)
+        return 0;
+
+    sprt_iphdr = (struct fwk_ip_hdr *)(mac + NET_ETHER_HDR_LEN);
+    hash = sprt_iphdr->saddr ^ sprt_iphdr->daddr ^ sprt_iphdr->protocol;
+
+    /*!< tcp and udp have the same port layout */
+    if ((sprt_iphdr->protocol == NET_IP_PROTO_TCP) || (sprt_iphdr->protocol == NET_IP_PROTO_UDP))
+    {
+        sprt_udphdr = (struct fwk_udp_hdr *)((kuint8_t *)sprt_iphdr + sprt_iphdr->ihl * 4);
+        if (((kuint8_t *)sprt_udphdr + NET_UDP_HDR_LEN) <= sprt_skb->tail)
+            hash ^= ((kuint32_t)sprt_udphdr->src_port << 16) | sprt_udphdr->dst_port;
+    }
+
+    /*!< mix bits */
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3bU;
+    hash ^= hash >> 16;
+
+    sprt_skb->hash = hash ? hash : 1;
+    return sprt_skb->hash;
+}
+
+/*!
+ * @brief   select tx queue
+ * @param   sprt_ndev, sprt_skb
+ * @retval  queue index
+ * @note    none
+ */
+static kuint16_t fwk_netif_select_tx_queue(struct fwk_net_device *sprt_ndev, struct fwk_sk_buff *sprt_skb)
+{
+    const struct fwk_netdev_ops *sprt_ops = sprt_ndev->sprt_netdev_oprts;
+    kuint16_t index;
+
+    if (sprt_ndev->real_num_tx_queues <= 1)
+        return 0;
+
+    if (sprt_ops->ndo_select_queue)
+        index = sprt_ops->ndo_select_queue(sprt_ndev, sprt_skb);
+    else
+        index = (kuint16_t)mrt_urem(fwk_netif_flow_hash(sprt_skb), sprt_ndev->real_num_tx_queues);
+
+    return (index < sprt_ndev->real_num_tx_queues) ? index : 0;
+}
+
+/*!
+ * @brief   select rx queue
+ * @param   sprt_ndev, sprt_skb
+ * @retval  rx queue
+ * @note    queue recorded by driver is preferred, otherwise steer by flow hash (keeps per-flow ordering)
+ */
+static struct fwk_netdev_rx_queue *fwk_netif_select_rx_queue(struct fwk_net_device *sprt_ndev, struct fwk_sk_buff *sprt_skb)
+{
+    kuint32_t index = 0;
+
+    if (sprt_ndev->real_num_rx_queues > 1)
+    {
+        if (fwk_skb_rx_queue_recorded(sprt_skb))
+            index = fwk_skb_get_rx_queue(sprt_skb);
+        else
+            index = mrt_urem(fwk_netif_flow_hash(sprt_skb), sprt_ndev->real_num_rx_queues);
+    }
+
+    return &sprt_ndev->sprt_rx[(index < sprt_ndev->real_num_rx_queues) ? index : 0];
+}
+
 /*!
  * @brief   send skb
  * @param   sprt_skb
@@ -364,8 +456,10 @@ out:
 static netdev_tx_t __fwk_dev_queue_xmit(struct fwk_sk_buff *sprt_skb)
 {
     struct fwk_net_device *sprt_ndev;
+    struct fwk_netdev_queue *sprt_txq;
     const struct fwk_netdev_ops *sprt_ops;
     netdev_tx_t retval;
+    kuint32_t len;
     
     sprt_ndev = sprt_skb->sprt_ndev;
     sprt_ops = sprt_ndev->sprt_netdev_oprts;
@@ -373,7 +467,21 @@ static netdev_tx_t __fwk_dev_queue_xmit(struct fwk_sk_buff *sprt_skb)
     if (!sprt_ops->ndo_start_xmit)
         return -ER_TRXERR;
 
+    sprt_skb->queue_mapping = fwk_netif_select_tx_queue(sprt_ndev, sprt_skb);
+    sprt_txq = &sprt_ndev->sprt_tx[sprt_skb->queue_mapping];
+
+    /*!< skb may be released by driver */
+    len = sprt_skb->len;
     retval = sprt_ops->ndo_start_xmit(sprt_skb, sprt_ndev);
+    if (retval < 0)
+        sprt_txq->sgrt_stats.dropped++;
+    else
+    {
+        sprt_txq->sgrt_stats.packets++;
+        sprt_txq->sgrt_stats.bytes += len;
+        sprt_txq->trans_start = jiffies;
+    }
+
     return retval;
 }
 
@@ -389,19 +497,87 @@ kint32_t fwk_dev_queue_xmit(struct fwk_sk_buff *sprt_skb)
 }
 
 /*!
- * @brief   add skb received to global rx list
+ * @brief   add skb received to rx queue of net device
  * @param   sprt_skb
  * @retval  errno
- * @note    the function will wake up rx_thread
+ * @note    the function will wake up rx_thread; 
+ *          it is lock-free, but every rx queue must have only one producer (driver isr/thread)
  */
 kint32_t fwk_netif_rx(struct fwk_sk_buff *sprt_skb)
 {
-    if (!fwk_skb_enqueue(fwk_netif_rxq_get(), sprt_skb))
-        schedule_thread_wakeup(THREAD_TID_SOCKRX);
+    struct fwk_net_device *sprt_ndev;
+    struct fwk_netdev_rx_queue *sprt_rxq;
+    kuint32_t len;
+
+    sprt_ndev = sprt_skb->sprt_ndev;
+    if (!isValid(sprt_ndev) || !isValid(sprt_ndev->sprt_rx))
+    {
+        kfree_skb(sprt_skb);
+        return -ER_NODEV;
+    }
+
+    len = sprt_skb->len;
+    sprt_rxq = fwk_netif_select_rx_queue(sprt_ndev, sprt_skb);
+
+    if (fwk_skb_ring_produce(&sprt_rxq->sgrt_ring, sprt_skb))
+    {
+        sprt_rxq->sgrt_stats.dropped++;
+        sprt_ndev->sgrt_stats.rx_dropped++;
+        kfree_skb(sprt_skb);
+
+        return -ER_FULL;
+    }
+
+    sprt_rxq->sgrt_stats.packets++;
+    sprt_rxq->sgrt_stats.bytes += len;
+    schedule_thread_wakeup(THREAD_TID_SOCKRX);
 
     return ER_NORMAL;
 }
 
+/*!
+ * @brief   move skbs from rx queues of all net devices to rx list
+ * @param   sprt_head: rx list
+ * @retval  the number of skbs moved
+ * @note    called by rx thread only (the only consumer); 
+ *          queues are polled round-robin with NETIF_RX_BUDGET, so one busy queue cannot starve the others
+ */
+static kuint32_t fwk_netif_rx_collect(struct fwk_sk_buff_head *sprt_head)
+{
+    struct fwk_net_device *sprt_ndev = mrt_nullptr;
+    struct fwk_netdev_rx_queue *sprt_rxq;
+    struct fwk_sk_buff *sprt_skb;
+    kuint32_t idx, budget, count = 0;
+
+    /*!< held for the whole walk, so a device can not be unregistered while its queues are polled */
+    fwk_netdevice_lock();
+
+    while ((sprt_ndev = fwk_next_netdevice(sprt_ndev)))
+    {
+        if (!isValid(sprt_ndev->sprt_rx))
+            continue;
+
+        for (idx = 0; idx < sprt_ndev->real_num_rx_queues; idx++)
+        {
+            sprt_rxq = &sprt_ndev->sprt_rx[idx];
+
+            for (budget = NETIF_RX_BUDGET; budget; budget--)
+            {
+                sprt_skb = fwk_skb_ring_consume(&sprt_rxq->sgrt_ring);
+                if (!sprt_skb)
+                    break;
+
+                fwk_skb_enqueue(sprt_head, sprt_skb);
+                count++;
+            }
+        }
+    }
+
+    fwk_netdevice_unlock();
+
+    return count;
+}
+
 /*!< ----------------------------------------------------------------------- */
 struct fwk_netif_tcb
 {
@@ -413,7 +589,7 @@ struct fwk_netif_tcb
  * @brief   rx thread
  * @param   args (for callback function)
  * @retval  args
- * @note    if skb_list is empty, sleep all the time
+ * @note    if all rx queues are empty, sleep all the time
  */
 static void *fwk_netif_rx_entry(void *args)
 {
@@ -425,12 +601,15 @@ static void *fwk_netif_rx_entry(void *args)
 
     for (;;)
     {
-        if (mrt_skbuff_list_empty(sprt_head))
+        if (!fwk_netif_rx_collect(sprt_head))
             goto END;
 
         if (sprt_tcb->pfunc_rx)
             sprt_tcb->pfunc_rx(sprt_head, sprt_tcb->args);
 
+        /*!< rings may be refilled while handling, check again before sleeping */
+        continue;
+
     END:
         schedule_self_suspend();
     }
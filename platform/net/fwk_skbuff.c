@@ -66,14 +66,220 @@ struct fwk_sk_buff *fwk_alloc_skb(kuint32_t data_size, nrt_gfp_t flags)
  */
 void kfree_skb(struct fwk_sk_buff *sprt_skb)
 {
+    struct fwk_skb_cache *sprt_cache;
+
     if (!sprt_skb)
         return;
     if (ATOMIC_READ(&sprt_skb->users) > 1)
         return;
 
+    /*!< skb from cache: give it back to free_list */
+    sprt_cache = sprt_skb->sprt_cache;
+    if (sprt_cache)
+    {
+        atomic_list_push(&sprt_cache->sgrt_class[sprt_skb->cache_class].free_list, sprt_skb);
+        return;
+    }
+
     kfree(sprt_skb);
 }
 
+/*!
+ * @brief   reset skb to the state of just allocated
+ * @param   sprt_skb
+ * @retval  none
+ * @note    head/end/truesize and cache information are kept
+ */
+static void __fwk_skb_reset(struct fwk_sk_buff *sprt_skb)
+{
+    sprt_skb->sprt_ndev = mrt_nullptr;
+    sprt_skb->queue_mapping = 0;
+    sprt_skb->hash = 0;
+    sprt_skb->len = 0;
+    sprt_skb->data_len = 0;
+    sprt_skb->protocol = 0;
+
+    sprt_skb->mac_header = (typeof(sprt_skb->mac_header))(~0U);
+    sprt_skb->network_header = (typeof(sprt_skb->network_header))(~0U);
+    sprt_skb->transport_header = (typeof(sprt_skb->transport_header))(~0U);
+
+    sprt_skb->data = sprt_skb->tail = sprt_skb->head;
+    
+    ATOMIC_SET(&sprt_skb->users, 1);
+    fwk_skb_list_init((struct fwk_sk_buff_head *)sprt_skb);
+}
+
+/*!
+ * @brief   recycle skb (such as rx refill)
+ * @param   sprt_skb
+ * @retval  true: skb can be reused directly as a new buffer; false: skb is still referenced
+ * @note    driver can refill its rx descriptor with the skb instead of kfree_skb() + alloc
+ */
+kbool_t fwk_skb_recycle(struct fwk_sk_buff *sprt_skb)
+{
+    if (!sprt_skb || (ATOMIC_READ(&sprt_skb->users) > 1))
+        return false;
+
+    __fwk_skb_reset(sprt_skb);
+    return true;
+}
+
+/*!
+ * @brief   create skb cache for net device
+ * @param   sprt_ndev
+ * @param   small_count: number of skbs for NR_SKB_CACHE_SMALL
+ * @param   mtu_count: number of skbs for NR_SKB_CACHE_MTU
+ * @retval  errno
+ * @note    all skbs are pre-allocated (and initialized) in one block from GFP_SOCK;
+ *          should be called after mtu and hard_header_len are set
+ */
+kint32_t fwk_skb_cache_create(struct fwk_net_device *sprt_ndev, kuint32_t small_count, kuint32_t mtu_count)
+{
+    struct fwk_skb_cache *sprt_cache;
+    struct fwk_skb_cache_class *sprt_class;
+    struct fwk_sk_buff *sprt_skb;
+    kuint8_t *buffer;
+    kusize_t skb_size, total = 0;
+    kuint32_t idx, cnt;
+
+    if (!isValid(sprt_ndev) || sprt_ndev->sprt_skb_cache)
+        return -ER_UNVALID;
+
+    sprt_cache = kzalloc(sizeof(*sprt_cache), GFP_KERNEL);
+    if (!isValid(sprt_cache))
+        return -ER_NOMEM;
+
+    skb_size = mrt_align(sizeof(*sprt_skb), sizeof(kutype_t));
+
+    sprt_cache->sgrt_class[NR_SKB_CACHE_SMALL].count = small_count;
+    sprt_cache->sgrt_class[NR_SKB_CACHE_SMALL].data_size = SKB_CACHE_SMALL_SIZE;
+    sprt_cache->sgrt_class[NR_SKB_CACHE_MTU].count = mtu_count;
+    sprt_cache->sgrt_class[NR_SKB_CACHE_MTU].data_size = 
+                mrt_align(sprt_ndev->mtu + sprt_ndev->hard_header_len + 2 * ARCH_PER_SIZE, sizeof(kutype_t));
+
+    for (idx = 0; idx < NR_SKB_CACHE_MAX; idx++)
+    {
+        sprt_class = &sprt_cache->sgrt_class[idx];
+        total += sprt_class->count * (skb_size + sprt_class->data_size);
+    }
+
+    if (!total)
+        goto fail;
+
+    sprt_cache->buffer = kmalloc(total, GFP_GET_FLAG(GFP_KERNEL) | GFP_SOCK);
+    if (!isValid(sprt_cache->buffer))
+        goto fail;
+
+    buffer = (kuint8_t *)sprt_cache->buffer;
+    for (idx = 0; idx < NR_SKB_CACHE_MAX; idx++)
+    {
+        sprt_class = &sprt_cache->sgrt_class[idx];
+
+        for (cnt = 0; cnt < sprt_class->count; cnt++)
+        {
+            sprt_skb = (struct fwk_sk_buff *)buffer;
+            memset(sprt_skb, 0, sizeof(*sprt_skb));
+
+            sprt_skb->truesize = sprt_class->data_size;
+            sprt_skb->head = buffer + skb_size;
+            sprt_skb->end = sprt_skb->head + sprt_class->data_size;
+            sprt_skb->sprt_cache = sprt_cache;
+            sprt_skb->cache_class = idx;
+
+            atomic_list_push(&sprt_class->free_list, sprt_skb);
+            buffer += skb_size + sprt_class->data_size;
+        }
+    }
+
+    sprt_ndev->sprt_skb_cache = sprt_cache;
+    return ER_NORMAL;
+
+fail:
+    kfree(sprt_cache);
+    return -ER_NOMEM;
+}
+
+/*!
+ * @brief   destroy skb cache of net device
+ * @param   sprt_ndev
+ * @retval  none
+ * @note    all skbs should have been returned; 
+ *          otherwise the memory is kept (leaked) to avoid kfree_skb() touching a released block
+ */
+void fwk_skb_cache_destroy(struct fwk_net_device *sprt_ndev)
+{
+    struct fwk_skb_cache *sprt_cache;
+    struct fwk_skb_cache_class *sprt_class;
+    kuint32_t idx, cnt;
+
+    if (!isValid(sprt_ndev) || !sprt_ndev->sprt_skb_cache)
+        return;
+
+    sprt_cache = sprt_ndev->sprt_skb_cache;
+    sprt_ndev->sprt_skb_cache = mrt_nullptr;
+
+    for (idx = 0; idx < NR_SKB_CACHE_MAX; idx++)
+    {
+        sprt_class = &sprt_cache->sgrt_class[idx];
+
+        for (cnt = 0; atomic_list_pop(&sprt_class->free_list); cnt++);
+        if (cnt != sprt_class->count)
+        {
+            print_warn("%s: %d skbs of %s are still in use!\n", 
+                            __FUNCTION__, sprt_class->count - cnt, sprt_ndev->name);
+            return;
+        }
+    }
+
+    kfree(sprt_cache->buffer);
+    kfree(sprt_cache);
+}
+
+/*!
+ * @brief   allocate skb for net device
+ * @param   sprt_ndev, data_size: length (tail - data), flags
+ * @retval  skb
+ * @note    take skb from the cache of sprt_ndev (constant time, lock-free) if possible,
+ *          fall back to fwk_alloc_skb() if cache is not created, exhausted, or too small
+ */
+struct fwk_sk_buff *fwk_netdev_alloc_skb(struct fwk_net_device *sprt_ndev, kuint32_t data_size, nrt_gfp_t flags)
+{
+    struct fwk_skb_cache *sprt_cache;
+    struct fwk_skb_cache_class *sprt_class;
+    struct fwk_sk_buff *sprt_skb;
+    kuint32_t idx;
+
+    sprt_cache = isValid(sprt_ndev) ? sprt_ndev->sprt_skb_cache : mrt_nullptr;
+    if (!sprt_cache)
+        goto fallback;
+
+    for (idx = 0; idx < NR_SKB_CACHE_MAX; idx++)
+    {
+        sprt_class = &sprt_cache->sgrt_class[idx];
+        if (data_size > sprt_class->data_size)
+            continue;
+
+        sprt_skb = atomic_list_pop(&sprt_class->free_list);
+        if (sprt_skb)
+        {
+            atomic_inc(&sprt_class->hits);
+            __fwk_skb_reset(sprt_skb);
+            return sprt_skb;
+        }
+
+        /*!< this class is exhausted, try a larger one */
+        atomic_inc(&sprt_class->misses);
+    }
+
+    /*!< larger than any class */
+    sprt_class = &sprt_cache->sgrt_class[NR_SKB_CACHE_MAX - 1];
+    if (data_size > sprt_class->data_size)
+        atomic_inc(&sprt_class->misses);
+
+fallback:
+    return fwk_alloc_skb(data_size, flags);
+}
+
 /*!
  * @brief   add skb to skb_list
  * @param   sprt_head, sprt_skb
@@ -102,4 +308,51 @@ struct fwk_sk_buff *fwk_skb_dequeue(struct fwk_sk_buff_head *sprt_head)
     return sprt_skb;
 }
 
+/*!
+ * @brief   initialize skb ring
+ * @param   sprt_ring, size (rounded up to power of 2), flags
+ * @retval  errno
+ * @note    none
+ */
+kint32_t fwk_skb_ring_init(struct fwk_skb_ring *sprt_ring, kuint32_t size, nrt_gfp_t flags)
+{
+    kuint32_t count = 1;
+
+    if (!sprt_ring || !size)
+        return -ER_UNVALID;
+
+    while (count < size)
+        count <<= 1;
+
+    sprt_ring->sprt_slots = kzalloc(count * sizeof(*sprt_ring->sprt_slots), flags);
+    if (!isValid(sprt_ring->sprt_slots))
+        return -ER_NOMEM;
+
+    sprt_ring->head = 0;
+    sprt_ring->tail = 0;
+    sprt_ring->mask = count - 1;
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   release skb ring
+ * @param   sprt_ring
+ * @retval  none
+ * @note    skbs left in ring will be released together
+ */
+void fwk_skb_ring_destroy(struct fwk_skb_ring *sprt_ring)
+{
+    struct fwk_sk_buff *sprt_skb;
+
+    if (!sprt_ring || !isValid(sprt_ring->sprt_slots))
+        return;
+
+    while ((sprt_skb = fwk_skb_ring_consume(sprt_ring)))
+        kfree_skb(sprt_skb);
+
+    kfree(sprt_ring->sprt_slots);
+    sprt_ring->sprt_slots = mrt_nullptr;
+}
+
 /*!< end of file */
@@ -374,6 +374,39 @@ kssize_t network_recvfrom(kint32_t sockfd, void *buf, size_t len,
     return -ER_FORBID;
 }
 
+/*!
+ * @brief   get ready events of socket
+ * @param   sockfd
+ * @param   sprt_pt: wait queues are added to it, can be null
+ * @retval  POLLIN/POLLOUT/...
+ * @note    called by virt_poll/virt_select
+ */
+kuint32_t network_poll(kint32_t sockfd, struct fwk_poll_table *sprt_pt)
+{
+    struct fwk_network_object *sprt_obj;
+    struct fwk_network_if *sprt_if;
+    kint32_t index;
+
+    index = sockfd - NETWORK_SOCKETS_BASE;
+    if ((index < 0) ||
+        (index >= NET_SOCKETS_NUM))
+        return POLLNVAL;
+
+    sprt_obj = mrt_socket_to_object(index);
+    if (!sprt_obj)
+        return POLLNVAL;
+
+    /*!< not bound yet, nothing can be sent or received */
+    sprt_if = sprt_obj->sprt_if;
+    if (!sprt_if)
+        return 0;
+
+    if (sprt_if->sprt_oprts->poll)
+        return sprt_if->sprt_oprts->poll(&sprt_obj->sgrt_socket, sprt_pt);
+
+    return POLLIN | POLLRDNORM | POLLOUT | POLLWRNORM;
+}
+
 /*!< ----------------------------------------------------------------- */
 /*!
  * @brief   net_socket
@@ -95,7 +95,7 @@ static err_t lwip_lowlevel_output(struct netif *sprt_netif, struct pbuf *sprt_bu
         sprt_ethhdr = (struct fwk_eth_hdr *)sprt_per->payload;
     
         head_len = SKB_DATA_HEAD_LEN(NET_ETHER_HDR_LEN);
-        sprt_skb = fwk_alloc_skb(sprt_per->len + 2 * head_len, GFP_KERNEL);
+        sprt_skb = fwk_netdev_alloc_skb(sprt_data->ndev, sprt_per->len + 2 * head_len, GFP_KERNEL);
         if (!isValid(sprt_skb))
         {
             print_err("%s: allocate skb failed!\n", __FUNCTION__);
@@ -417,6 +417,26 @@ static kssize_t fwk_lwip_recvfrom(struct fwk_network_com *sprt_socket, void *buf
     return size;
 }
 
+/*!
+ * @brief   get ready events
+ * @param   sprt_socket, sprt_pt
+ * @retval  POLLIN/POLLOUT/...
+ * @note    only udp is supported, tcp is never ready
+ */
+static kuint32_t fwk_lwip_poll(struct fwk_network_com *sprt_socket, struct fwk_poll_table *sprt_pt)
+{
+    struct udp_pcb *sprt_upcb;
+
+    if (sprt_socket->type != NR_SOCK_DGRAM)
+        return 0;
+
+    sprt_upcb = (struct udp_pcb *)sprt_socket->private_data;
+    if (!isValid(sprt_upcb))
+        return POLLERR;
+
+    return lwip_udp_raw_poll_events(sprt_upcb, sprt_pt);
+}
+
 /*!< network device node operations of lwip interface */
 static const struct fwk_network_if_ops sgrt_fwk_lwip_if_oprts =
 {
@@ -428,6 +448,7 @@ static const struct fwk_network_if_ops sgrt_fwk_lwip_if_oprts =
     .recv       = fwk_lwip_recv,
     .sendto     = fwk_lwip_sendto,
     .recvfrom   = fwk_lwip_recvfrom,
+    .poll       = fwk_lwip_poll,
 
     .link_up    = fwk_lwip_link_up,
     .link_down  = fwk_lwip_link_down,
@@ -16,6 +16,8 @@
 #include <platform/fwk_uaccess.h>
 #include <platform/net/fwk_lwip.h>
 #include <platform/net/fwk_netif.h>
+#include <platform/fwk_fcntl.h>
+#include <kernel/wait.h>
 
 /*!< The globals */
 struct lwip_udp_data
@@ -29,6 +31,13 @@ struct lwip_udp_data
     struct pq_data sgrt_pqd;
 };
 
+/*!< woken up when any udp pcb receives, pollers check their own queue */
+static struct wait_queue_head sgrt_lwip_udp_wqh =
+{
+    .sgrt_lock = SPIN_LOCK_INIT(),
+    .sgrt_task = LIST_HEAD_INIT(&sgrt_lwip_udp_wqh.sgrt_task),
+};
+
 /*!< API functions */
 /*!
  * @brief   release lwip_udp_data
@@ -106,6 +115,7 @@ static void __lwip_udp_raw_recv(void *arg, struct udp_pcb *sprt_upcb, struct pbu
     sprt_data->sgrt_pqd.dequeue_chk = lwip_udp_raw_check;
 
     pq_enqueue(sprt_pq, &sprt_data->sgrt_pqd);
+    wake_up(&sgrt_lwip_udp_wqh);
 }
 
 /*!
@@ -151,6 +161,25 @@ kssize_t lwip_udp_raw_recvfrom(struct udp_pcb *sprt_upcb, void *buf,
     return len;
 }
 
+/*!
+ * @brief   called by virt_poll
+ * @param   sprt_upcb, sprt_pt
+ * @retval  POLLIN (frame queued) | POLLOUT
+ * @note    none
+ */
+kuint32_t lwip_udp_raw_poll_events(struct udp_pcb *sprt_upcb, struct fwk_poll_table *sprt_pt)
+{
+    struct pq_queue *sprt_pq = (struct pq_queue *)sprt_upcb->recv_arg;
+    kuint32_t mask = POLLOUT | POLLWRNORM;
+
+    fwk_poll_wait(mrt_nullptr, &sgrt_lwip_udp_wqh, sprt_pt);
+
+    if (sprt_pq && pq_queue_get_size(sprt_pq))
+        mask |= POLLIN | POLLRDNORM;
+
+    return mask;
+}
+
 /*!
  * @brief   called by socket_sendto
  * @param   sprt_upcb, buf, ...
@@ -24,6 +24,62 @@
 /*!< Address offset, and automatic 4-byte alignment */
 #define FDT_PTR_MOVE_BYTE(ptr, len)						({(ptr) += (len); mrt_ptr_align4(ptr);})
 
+/*!< The minimum size of each extra chunk of arena */
+#define FWK_FDT_ARENA_MIN_GROW							(1024)
+
+/*!< Property names that have been sorted, direct-mapped by offset in the string block */
+#define FWK_FDT_NAME_CACHE_SIZE							(64)
+
+/*!< Property names that fill struct fwk_device_node */
+enum __ERT_FWK_FDT_PROP_KIND
+{
+    NR_FWK_FDT_PROP_NONE = 0,
+    NR_FWK_FDT_PROP_NAME,
+    NR_FWK_FDT_PROP_TYPE,
+    NR_FWK_FDT_PROP_PHANDLE,
+};
+
+struct fwk_fdt_name_cache
+{
+    kuint32_t offset;									/*!< offset in string block + 1, 0: empty */
+    kuint32_t kind;										/*!< refer to "__ERT_FWK_FDT_PROP_KIND" */
+};
+
+/*!< Memory of unflattened tree: a list of chunks, objects are carved from the latest one */
+struct fwk_fdt_arena_chunk
+{
+    struct fwk_fdt_arena_chunk *sprt_next;				/*!< the previous chunk */
+};
+
+struct fwk_fdt_arena
+{
+    struct fwk_fdt_arena_chunk *sprt_chunk;
+    void *ptr_cur;
+    void *ptr_end;
+    kusize_t grow;										/*!< bytes of each extra chunk */
+};
+
+/*!< The minimum buckets of each index, it grows to the power of 2 that is not less than the number of nodes */
+#define FWK_OF_INDEX_MIN_BUCKETS						(16)
+
+/*!< One entry of index: keyed by phandle, full path or one compatible string */
+struct fwk_of_index_entry
+{
+    const kchar_t *key;									/*!< string key, null for phandle */
+    kuint32_t hash;										/*!< phandle, or hash of key */
+    kuint32_t order;									/*!< position of node on allnext list */
+    struct fwk_device_node *sprt_node;
+    struct fwk_of_index_entry *sprt_next;				/*!< entries of a bucket keep the allnext order */
+};
+
+struct fwk_of_index
+{
+    kuint32_t mask;										/*!< buckets - 1, 0: index is not built */
+    struct fwk_of_index_entry **sprt_phandle;
+    struct fwk_of_index_entry **sprt_path;
+    struct fwk_of_index_entry **sprt_compat;
+};
+
 /*!< -------------------------------------------------------------------------- */
 /*!< The globals */
 struct fdt_params *sprt_fwk_fdt_params;
@@ -32,22 +88,31 @@ kuint8_t *ptr_fdt_memBuffer = mrt_nullptr;
 /*!< Global list */
 struct fwk_device_node *sprt_fwk_of_allNodes = mrt_nullptr;
 
+/*!< Memory of global list */
+static struct fwk_fdt_arena sgrt_fwk_fdt_arena;
+static struct fwk_fdt_name_cache sgrt_fwk_fdt_name_cache[FWK_FDT_NAME_CACHE_SIZE];
+
+/*!< Lookup indexes of global list */
+static struct fwk_of_index sgrt_fwk_of_index;
+
 /*!< -------------------------------------------------------------------------- */
 /*!< The functions */
 static void fwk_early_init_dt_params(void *ptr_dt);
 static void fwk_unflatten_device_tree(void);
 static void __fwk_unflatten_device_tree(struct fwk_fdt_header *ptr_blob, struct fwk_device_node ***sprt_allNext);
-static void *fwk_unflatten_dt_nodes(struct fwk_fdt_header *ptr_blob,
-                                    void *ptr_mem,
+static kint32_t fwk_unflatten_dt_nodes(struct fwk_fdt_header *ptr_blob,
                                     void **ptr_start,
                                     struct fwk_device_node ***sprt_allNext);
 static void *fwk_fdt_populate_node(struct fwk_fdt_header *ptr_blob,
-                                    void **ptr_offset, void **mem, void **ptr_parent, void ***allNext);
+                                    void **ptr_offset, void **ptr_parent, void ***allNext);
 static void *fwk_fdt_populate_properties(struct fwk_fdt_header *ptr_blob,
-                                    void **ptr_offset, void **mem, void *node, void ***allNext, kbool_t *has_name);
-static void *fwk_fdt_add_string_properties(void **mem, void *node, kchar_t *name, kchar_t *value, kuint32_t size, void ***allNext);
-static void *fwk_fdt_memory_calculate(void **mem, kuint32_t size, kuint32_t align);
-static void *fwk_fdt_memory_alloc(kuint32_t size, kuint32_t align);
+                                    void **ptr_offset, void *node, kbool_t *has_name);
+static void *fwk_fdt_add_string_properties(void *node, kchar_t *name, kchar_t *value, kuint32_t size);
+static kint32_t fwk_fdt_arena_init(kusize_t size, kusize_t grow);
+static void *fwk_fdt_arena_alloc(kusize_t size, kusize_t align);
+static void fwk_fdt_arena_destroy(void);
+static void fwk_of_index_build(void);
+static void fwk_of_index_destroy(void);
 
 /*!< -------------------------------------------------------------------------- */
 /*!< API function */
@@ -85,13 +150,11 @@ void setup_machine_fdt(void *ptr)
  */
 void destroy_machine_fdt(void)
 {
-    struct fwk_device_node **sprt_mem = &sprt_fwk_of_allNodes;
+    fwk_of_index_destroy();
 
-    if (isValid(*sprt_mem))
-    {
-        kfree(*sprt_mem);
-        *sprt_mem = mrt_nullptr;
-    }
+    /*!< All nodes and properties are in the arena */
+    fwk_fdt_arena_destroy();
+    sprt_fwk_of_allNodes = mrt_nullptr;
 }
 
 /*!< ----------------------------------------------------------------------- */
@@ -132,19 +195,21 @@ static void fwk_unflatten_device_tree(void)
      * Fortunately, each member of the struct fdt_header is of 4-byte type, and it is possible to convert the endian
      */
     __fwk_unflatten_device_tree(ptr_fdt_start, &sprt_allNodes);
+
+    /*!< The tree does not change after here, lookups by phandle, path and compatible go through hash indexes */
+    fwk_of_index_build();
 }
 
 /*!
  * @brief   __fwk_unflatten_device_tree
  * @param   none
  * @retval  none
- * @note    none
+ * @note    the blob is walked only once, nodes and properties are carved from the arena in order
  */
 static void __fwk_unflatten_device_tree(struct fwk_fdt_header *ptr_blob, struct fwk_device_node ***sprt_allNext)
 {
     struct fwk_device_node **sprt_allNodes;
     void *ptr_start;
-    void *ptr_dt_mem;
     kusize_t size;
 
     if (!isValid(ptr_blob))
@@ -156,50 +221,46 @@ static void __fwk_unflatten_device_tree(struct fwk_fdt_header *ptr_blob, struct
 
     sprt_allNodes = *sprt_allNext;
 
-    /*!< Offset to the first address of the device block, this area will be used to build the device tree node */
-    ptr_start = (void *)((void *)ptr_blob + FDT_TO_ARCH_ENDIAN32(ptr_blob->off_dt_struct));
-    size = (kusize_t)fwk_unflatten_dt_nodes(ptr_blob, mrt_nullptr, &ptr_start, mrt_nullptr);
-    size = mrt_num_align4(size);
-    if (!size)
-        return;
-
-    /*!< Apply for contiguous memory space */
-    ptr_dt_mem = (void *)fwk_fdt_memory_alloc(size + 4, __alignof__(struct fwk_device_node));
-    if (!isValid(ptr_dt_mem))
+    /*!<
+     * The unflattened tree is about 1.5 times of the structure block:
+     * a property costs 12 bytes and more in the blob, but only a struct fwk_of_property here (value is not copied);
+     * a node costs its name and tags in the blob, but a struct fwk_device_node and the full path here
+     * If it is not enough, the arena grows by smaller chunks
+     */
+    size = FDT_TO_ARCH_ENDIAN32(ptr_blob->size_dt_struct);
+    if (fwk_fdt_arena_init(size + (size >> 1), CMP_MAX2(size >> 2, FWK_FDT_ARENA_MIN_GROW)))
         return;
 
-    /*!< The end is filled with a magic number, which is used to identify if the memory is out of bounds */
-    *(kuint32_t *)(ptr_dt_mem + size) = FDT_TO_ARCH_ENDIAN32(FDT_MAGIC_VERIFY);
+    kmemzero(sgrt_fwk_fdt_name_cache, sizeof(sgrt_fwk_fdt_name_cache));
 
-    /*!< The last call caused the ptr_start to shift and need to be back to the starting position */
+    /*!< Offset to the first address of the device block, this area will be used to build the device tree node */
     ptr_start = (void *)((void *)ptr_blob + FDT_TO_ARCH_ENDIAN32(ptr_blob->off_dt_struct));
-    fwk_unflatten_dt_nodes(ptr_blob, ptr_dt_mem, &ptr_start, &sprt_allNodes);
-
-    /*!< Check the magic number, if the memory is out of bounds... it will not deal with it for the time being */
-    if (FDT_MAGIC_VERIFY != FDT_TO_ARCH_ENDIAN32(*(kuint32_t *)(ptr_dt_mem + size)))
-        return;
+    if (fwk_unflatten_dt_nodes(ptr_blob, &ptr_start, &sprt_allNodes))
+    {
+        /*!< A half tree is worse than none: drivers would probe without their parents */
+        fwk_fdt_arena_destroy();
+        **sprt_allNext = mrt_nullptr;
+    }
 }
 
 /*!
  * @brief   Resolve all nodes
  * @param   none
- * @retval  none
+ * @retval  errno
  * @note    none
  */
-static void *fwk_unflatten_dt_nodes(struct fwk_fdt_header *ptr_blob,
-                                    void *ptr_mem,
+static kint32_t fwk_unflatten_dt_nodes(struct fwk_fdt_header *ptr_blob,
                                     void **ptr_start,
                                     struct fwk_device_node ***sprt_allNext)
 {
     struct fwk_device_node *sprt_node;
     struct fwk_device_node **sprt_allNodes;
     struct fwk_device_node *sprt_list;
-    struct fwk_device_node *sprt_cast;
     void *ptr_move;
     kuint32_t iTag;
 
-    if (!isValid(ptr_blob) || !isValid(ptr_start))
-        return ptr_mem;
+    if (!isValid(ptr_blob) || !isValid(ptr_start) || !isValid(sprt_allNext))
+        return -ER_NULLPTR;
 
     /*!< Obtain the first address of the device block */
     ptr_move = *ptr_start;
@@ -208,11 +269,11 @@ static void *fwk_unflatten_dt_nodes(struct fwk_fdt_header *ptr_blob,
 
     /*!< Not the start of the node, exiting incorrectly */
     if (FDT_ALL_NODE_START != iTag)
-        return ptr_mem;
+        return -ER_UNVALID;
 
     sprt_node		= mrt_nullptr;
     sprt_list		= mrt_nullptr;
-    sprt_allNodes	= isValid(sprt_allNext) ? *sprt_allNext : mrt_nullptr;
+    sprt_allNodes	= *sprt_allNext;
 
     /*!<
      * Traverse all nodes in the DTB
@@ -236,18 +297,10 @@ static void *fwk_unflatten_dt_nodes(struct fwk_fdt_header *ptr_blob,
         if (FDT_NODE_END == iTag)
         {
             /*!< If the parent node is empty, it is the privilege of the root node, and the child node cannot be triggered */
+            /*!< Go back to the previous node */
             if (isValid(sprt_list))
-            {
-                sprt_cast = sprt_list;
-
-                /*!< Go back to the previous node */
                 sprt_list = sprt_list->parent;
 
-                /*!< The child node has been used up, and the temporary memory is released */
-                if (!isValid(sprt_allNodes))
-                    kfree(sprt_cast);
-            }
-
             ptr_move += 4;
             continue;
         }
@@ -257,50 +310,35 @@ static void *fwk_unflatten_dt_nodes(struct fwk_fdt_header *ptr_blob,
             break;
 
         /*!< Handle a single node */
-        sprt_node = fwk_fdt_populate_node(ptr_blob, &ptr_move, &ptr_mem, (void **)(&sprt_list), (void ***)&sprt_allNodes);
+        sprt_node = fwk_fdt_populate_node(ptr_blob, &ptr_move, (void **)(&sprt_list), (void ***)&sprt_allNodes);
         if (!isValid(sprt_node))
-        {
-            /*!<
-             * If the memory request of the current node fails, you need to release the local node and the parent nodes at all levels;
-             * The sibling node has been released in the if (FDT_NODE_END == iTag), and there is no need to consider the existence of the sibling node
-             */
-            if (!isValid(sprt_allNodes))
-            {
-                while (isValid(sprt_list))
-                {
-                    sprt_cast = sprt_list;
-                    sprt_list = sprt_list->parent;
-                    kfree(sprt_cast);
-                }
-
-                return mrt_nullptr;
-            }
-        }
+            return -ER_NOMEM;
 
         sprt_list = sprt_node;
     }
 
-    return ptr_mem;
+    *ptr_start = ptr_move;
+
+    return ER_NORMAL;
 }
 
 /*!
  * @brief   Single-node handlers
  * @param   ptr_blob: 	dtb start address
  * @param	ptr_offset: the address that is currently offset
- * @param	mem: 		the first address where the node's memory is allocated
  * @param	parent: 	parent node
  * @param	allNext:	next node
  * @retval  allocated node memory pointer
  * @note    Parent, child, and sibling nodes are treated equally
  */
 static void *fwk_fdt_populate_node(struct fwk_fdt_header *ptr_blob,
-                                        void **ptr_offset, void **mem, void **ptr_parent, void ***allNext)
+                                        void **ptr_offset, void **ptr_parent, void ***allNext)
 {
     struct fwk_device_node *sprt_node;
     struct fwk_device_node *sprt_parent;
     struct fwk_of_property *sprt_prop;
     struct fwk_of_property **sprt_prev;
-    void *ptr_move, *ptr_mem, **ptr_allNext;
+    void *ptr_move, **ptr_allNext;
     kchar_t *ptr_path;
     kuint32_t iTag;
     kusize_t  ipathLenth, iLenthNeed;
@@ -309,7 +347,6 @@ static void *fwk_fdt_populate_node(struct fwk_fdt_header *ptr_blob,
 
     sprt_parent	= (struct fwk_device_node *)(*ptr_parent);
     ptr_move	= *ptr_offset;
-    ptr_mem		= *mem;
     ptr_allNext	= *allNext;
     new_format	= false;
     iTag		= FDT_TO_ARCH_ENDIAN32(*(kuint32_t *)ptr_move);
@@ -354,27 +391,16 @@ static void *fwk_fdt_populate_node(struct fwk_fdt_header *ptr_blob,
         }
     }
 
-    sprt_node = fwk_fdt_memory_calculate(&ptr_mem, sizeof(struct fwk_device_node) + iLenthNeed, __alignof__(struct fwk_device_node));
+    sprt_node = fwk_fdt_arena_alloc(sizeof(struct fwk_device_node) + iLenthNeed, __alignof__(struct fwk_device_node));
+    if (!isValid(sprt_node))
+        return mrt_nullptr;
 
-    if (isValid(ptr_allNext))
-    {
-        /*!< Inserts the current node into the list */
-        *ptr_allNext = sprt_node;
-        ptr_allNext	 = (void **)(&sprt_node->allnext);
+    /*!< Inserts the current node into the list */
+    *ptr_allNext = sprt_node;
+    ptr_allNext	 = (void **)(&sprt_node->allnext);
 
-        /*!< Update the address */
-        *allNext = ptr_allNext;
-    }
-    else
-    {
-        /*!< 
-         * Request temporary memory; 
-         * This method makes the memory of each node discontinuous, so it is only used temporarily, and must be released when it is used up 
-         */
-        sprt_node = kzalloc(sizeof(struct fwk_device_node) + iLenthNeed, GFP_KERNEL);
-        if (!isValid(sprt_node))
-            return mrt_nullptr;
-    }
+    /*!< Update the address */
+    *allNext = ptr_allNext;
 
     /*!< Point to (mem - iLenthNeed), which is dedicated to storing pathnames */
     sprt_node->full_name = (kchar_t *)(sprt_node + 1);
@@ -400,7 +426,7 @@ static void *fwk_fdt_populate_node(struct fwk_fdt_header *ptr_blob,
     /*!< Initialize the value of phandle */
     sprt_node->phandle = -1;
 
-    if (isValid(sprt_parent) && isValid(ptr_allNext))
+    if (isValid(sprt_parent))
     {
         /*!< The parent node points to the child node, completing the list */
         /*!< This node is the first child node */
@@ -442,17 +468,18 @@ static void *fwk_fdt_populate_node(struct fwk_fdt_header *ptr_blob,
             continue;
         }
 
+        /*!< Non-property values are not handled here */
+        if (FDT_NODE_PROP != iTag)
+            break;
+
         /*!< Handles individual properties under this node and automatically completes the pointer position offset */
-        sprt_prop = fwk_fdt_populate_properties(ptr_blob, &ptr_move, &ptr_mem, sprt_node, &ptr_allNext, &has_name);
+        sprt_prop = fwk_fdt_populate_properties(ptr_blob, &ptr_move, sprt_node, &has_name);
         if (!isValid(sprt_prop))
-            break;
+            return mrt_nullptr;
 
         /*!< Inserts the attribute into the linked list of the local node's attributes */
-        if (isValid(ptr_allNext))
-        {
-            *sprt_prev	= sprt_prop;
-            sprt_prev	= &sprt_prop->sprt_next;
-        }
+        *sprt_prev	= sprt_prop;
+        sprt_prev	= &sprt_prop->sprt_next;
     }
 
     /*!< The property traversal is complete, and some work should be done before closing: */
@@ -489,61 +516,79 @@ static void *fwk_fdt_populate_node(struct fwk_fdt_header *ptr_blob,
          */
         ptr_3 = (ptr_3 < ptr_2) ? ptr_1 : ptr_3;
 
-        sprt_prop = fwk_fdt_add_string_properties(&ptr_mem, sprt_node, "name", ptr_2, ((ptr_3 + 1) - ptr_2), &ptr_allNext);
-        if (isValid(sprt_prop) && isValid(ptr_allNext))
-        {
-            /*!< Inserts the property into the list of the local node's properties */
-            *sprt_prev	= sprt_prop;
-            sprt_prev	= &sprt_prop->sprt_next;
-        }
+        sprt_prop = fwk_fdt_add_string_properties(sprt_node, "name", ptr_2, ((ptr_3 + 1) - ptr_2));
+        if (!isValid(sprt_prop))
+            return mrt_nullptr;
+
+        /*!< Inserts the property into the list of the local node's properties */
+        *sprt_prev	= sprt_prop;
+        sprt_prev	= &sprt_prop->sprt_next;
     }
 
-    if (isValid(ptr_allNext))
-    {
-        if (!sprt_node->name)
-            sprt_node->name	= "<null>";
+    if (!sprt_node->name)
+        sprt_node->name	= "<null>";
 
-        if (!sprt_node->type)
-            sprt_node->type	= "<null>";
-    }
+    if (!sprt_node->type)
+        sprt_node->type	= "<null>";
 
-    *mem		= ptr_mem;
     *ptr_offset	= ptr_move;
 
     return sprt_node;
 }
 
+/*!
+ * @brief   Sort property name
+ * @param   ptr_name: property name
+ * @param	iPropOffset: offset of ptr_name in the string block
+ * @retval  refer to "__ERT_FWK_FDT_PROP_KIND"
+ * @note    dtc stores each name once in the string block, so the offset identifies the name;
+ *          each name is compared with strings only the first time it is met
+ */
+static kuint32_t fwk_fdt_property_kind(kchar_t *ptr_name, kuint32_t iPropOffset)
+{
+    struct fwk_fdt_name_cache *sprt_cache;
+    kuint32_t kind;
+
+    sprt_cache = &sgrt_fwk_fdt_name_cache[((iPropOffset >> 2) ^ iPropOffset) & (FWK_FDT_NAME_CACHE_SIZE - 1)];
+    if (sprt_cache->offset == (iPropOffset + 1))
+        return sprt_cache->kind;
+
+    if (!strcmp("name", ptr_name))
+        kind = NR_FWK_FDT_PROP_NAME;
+    else if (!strcmp("device_type", ptr_name))
+        kind = NR_FWK_FDT_PROP_TYPE;
+    else if (!strcmp("phandle", ptr_name))
+        kind = NR_FWK_FDT_PROP_PHANDLE;
+    else
+        kind = NR_FWK_FDT_PROP_NONE;
+
+    /*!< 0 means empty slot, so offset is saved as offset + 1 */
+    sprt_cache->offset = iPropOffset + 1;
+    sprt_cache->kind = kind;
+
+    return kind;
+}
+
 /*!
  * @brief   Deal with one property
  * @param   none
  * @retval  none
- * @note    none
+ * @note    name and value are not copied, they stay in the string block and the structure block
  */
 static void *fwk_fdt_populate_properties(struct fwk_fdt_header *ptr_blob,
-                                        void **ptr_offset, void **mem, void *node, void ***allNext, kbool_t *has_name)
+                                        void **ptr_offset, void *node, kbool_t *has_name)
 {
     void *ptr_str_start;
     struct fwk_device_node *sprt_node;
     struct fwk_of_property *sprt_prop;
-    void *ptr_move, *ptr_mem, **ptr_allNext, *ptr_value;
-    kuint32_t tag;
+    void *ptr_move, *ptr_value;
     kchar_t *ptr_name;
     kuint32_t iPropOffset;
     kusize_t  iPropLenth;
 
     /*!< Gets the current pointer position */
     ptr_move	= *ptr_offset;
-    ptr_mem		= *mem;
     sprt_node	= (struct fwk_device_node *)node;
-    ptr_allNext	= *allNext;
-    tag			= FDT_TO_ARCH_ENDIAN32(*(kuint32_t *)ptr_move);
-
-    /*!< Non-property values are not handled by this function */
-    if (FDT_NODE_PROP != tag)
-    {
-        sprt_prop = mrt_nullptr;
-        goto exit;
-    }
 
     /*!< Skip tag */
     ptr_move += 4;
@@ -572,38 +617,39 @@ static void *fwk_fdt_populate_properties(struct fwk_fdt_header *ptr_blob,
      */
     ptr_str_start	= (void *)((void *)ptr_blob + FDT_TO_ARCH_ENDIAN32(ptr_blob->off_dt_strings));
     ptr_name		= (kchar_t *)(ptr_str_start + iPropOffset);
-    *has_name		= (!strcmp("name", ptr_name)) ? true : (*has_name);
 
     /*!< Record this property */
-    sprt_prop = fwk_fdt_memory_calculate(&ptr_mem, sizeof(struct fwk_of_property), __alignof__(struct fwk_of_property));
+    sprt_prop = fwk_fdt_arena_alloc(sizeof(struct fwk_of_property), __alignof__(struct fwk_of_property));
+    if (!isValid(sprt_prop))
+        return mrt_nullptr;
 
-    /*!<
-     * allnext:
-     */
-    if (isValid(ptr_allNext))
-    {
-        sprt_prop->name	= ptr_name;
-        sprt_prop->length = iPropLenth;
-        sprt_prop->value = ptr_value;
-        sprt_prop->sprt_next = mrt_nullptr;
+    sprt_prop->name	= ptr_name;
+    sprt_prop->length = iPropLenth;
+    sprt_prop->value = ptr_value;
+    sprt_prop->sprt_next = mrt_nullptr;
 
-        /*!< Fill node information */
-        if (!strcmp("name", sprt_prop->name))
+    /*!< Fill node information */
+    switch (fwk_fdt_property_kind(ptr_name, iPropOffset))
+    {
+        case NR_FWK_FDT_PROP_NAME:
             sprt_node->name	= (kchar_t *)sprt_prop->value;
-        else if (!strcmp("device_type", sprt_prop->name))
+            *has_name = true;
+            break;
+
+        case NR_FWK_FDT_PROP_TYPE:
             sprt_node->type	= (kchar_t *)sprt_prop->value;
-        else if (!strcmp("phandle", sprt_prop->name))
+            break;
+
+        case NR_FWK_FDT_PROP_PHANDLE:
             sprt_node->phandle = FDT_TO_ARCH_ENDIAN32(*(kuint32_t *)sprt_prop->value);
-    }
+            break;
 
-    /*!< If the next one is not an empty node, nor is it a property, then the property traversal ends */
-    ptr_move = FDT_PTR_MOVE_BYTE(ptr_move, iPropLenth);
-    tag	= FDT_TO_ARCH_ENDIAN32(*(kuint32_t *)ptr_move);
+        default:
+            break;
+    }
 
-exit:
     /*!< Update the pointer position */
-    *mem		= ptr_mem;
-    *ptr_offset	= ptr_move;
+    *ptr_offset	= FDT_PTR_MOVE_BYTE(ptr_move, iPropLenth);
 
     return sprt_prop;
 }
@@ -614,83 +660,295 @@ exit:
  * @retval  none
  * @note    If you want to add an integer property, build a separate function and then switch to big-endian mode when storing value
  */
-static void *fwk_fdt_add_string_properties(void **mem, void *node, kchar_t *name, kchar_t *value, kuint32_t size, void ***allNext)
+static void *fwk_fdt_add_string_properties(void *node, kchar_t *name, kchar_t *value, kuint32_t size)
 {
     struct fwk_device_node *sprt_node;
     struct fwk_of_property *sprt_prop;
-    void *ptr_mem, **ptr_allNext;
 
-    ptr_mem		= *mem;
     sprt_node	= (struct fwk_device_node *)node;
-    ptr_allNext	= *allNext;
 
     if (!name)
+        return mrt_nullptr;
+
+    /*!< The value is kept right behind the property */
+    sprt_prop = fwk_fdt_arena_alloc(sizeof(struct fwk_of_property) + size, __alignof__(struct fwk_of_property));
+    if (!isValid(sprt_prop))
+        return mrt_nullptr;
+
+    sprt_prop->name	= name;
+    sprt_prop->length = size;
+    sprt_prop->sprt_next = mrt_nullptr;
+
+    sprt_prop->value = (void *)(sprt_prop + 1);
+    memcpy(sprt_prop->value, value, size - 1);
+    *(kchar_t *)(sprt_prop->value + size - 1)	= '\0';
+
+    /*!< Fill node information */
+    if (!strcmp("name", sprt_prop->name))
+        sprt_node->name	= (kchar_t *)sprt_prop->value;
+    else if (!strcmp("device_type", sprt_prop->name))
+        sprt_node->type	= (kchar_t *)sprt_prop->value;
+
+    return sprt_prop;
+}
+
+/*!
+ * @brief   Add a chunk to arena
+ * @param   size: usable bytes
+ * @retval  errno
+ * @note    the chunk is zeroed, nodes rely on it
+ */
+static kint32_t fwk_fdt_arena_grow(kusize_t size)
+{
+    struct fwk_fdt_arena *sprt_arena = &sgrt_fwk_fdt_arena;
+    struct fwk_fdt_arena_chunk *sprt_chunk;
+
+    sprt_chunk = kzalloc(sizeof(struct fwk_fdt_arena_chunk) + size, GFP_KERNEL);
+    if (!isValid(sprt_chunk))
+        return -ER_NOMEM;
+
+    sprt_chunk->sprt_next = sprt_arena->sprt_chunk;
+    sprt_arena->sprt_chunk = sprt_chunk;
+    sprt_arena->ptr_cur = (void *)(sprt_chunk + 1);
+    sprt_arena->ptr_end = sprt_arena->ptr_cur + size;
+
+    return ER_NORMAL;
+}
+
+/*!
+ * @brief   Create arena of tree
+ * @param   size: bytes of the first chunk
+ * @param	grow: bytes of each extra chunk
+ * @retval  errno
+ * @note    the root node is the first object of the first chunk
+ */
+static kint32_t fwk_fdt_arena_init(kusize_t size, kusize_t grow)
+{
+    struct fwk_fdt_arena *sprt_arena = &sgrt_fwk_fdt_arena;
+
+    fwk_fdt_arena_destroy();
+    sprt_arena->grow = grow;
+
+    return fwk_fdt_arena_grow(mrt_num_align4(size));
+}
+
+/*!
+ * @brief   Allocate from arena
+ * @param   size, align
+ * @retval  memory, null if failed
+ * @note    there is no free, the whole arena is released with the tree
+ */
+static void *fwk_fdt_arena_alloc(kusize_t size, kusize_t align)
+{
+    struct fwk_fdt_arena *sprt_arena = &sgrt_fwk_fdt_arena;
+    void *ptr_mem;
+
+    ptr_mem = mrt_ptr_align(sprt_arena->ptr_cur, align);
+    if (!isValid(ptr_mem) || ((ptr_mem + size) > sprt_arena->ptr_end))
     {
-        sprt_prop = mrt_nullptr;
-        goto exit;
+        if (fwk_fdt_arena_grow(CMP_MAX2(size + align, sprt_arena->grow)))
+            return mrt_nullptr;
+
+        ptr_mem = mrt_ptr_align(sprt_arena->ptr_cur, align);
     }
 
-    sprt_prop = fwk_fdt_memory_calculate(&ptr_mem, sizeof(struct fwk_of_property) + size, __alignof__(struct fwk_of_property));
+    sprt_arena->ptr_cur = ptr_mem + size;
 
-    /*!< Inserts the property into the linked list of the local node's properties */
-    if (isValid(ptr_allNext))
-    {
-        sprt_prop->name	= name;
-        sprt_prop->length = size;
-        sprt_prop->sprt_next = mrt_nullptr;
+    return ptr_mem;
+}
 
-        sprt_prop->value = (void *)(sprt_prop + 1);
-        memcpy(sprt_prop->value, value, size - 1);
-        *(kchar_t *)(sprt_prop->value + size - 1)	= '\0';
+/*!
+ * @brief   Release arena of tree
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+static void fwk_fdt_arena_destroy(void)
+{
+    struct fwk_fdt_arena *sprt_arena = &sgrt_fwk_fdt_arena;
+    struct fwk_fdt_arena_chunk *sprt_chunk;
 
-        /*!< Fill node information */
-        if (!strcmp("name", sprt_prop->name))
-            sprt_node->name	= (kchar_t *)sprt_prop->value;
-        else if (!strcmp("device_type", sprt_prop->name))
-            sprt_node->type	= (kchar_t *)sprt_prop->value;
+    while (isValid(sprt_arena->sprt_chunk))
+    {
+        sprt_chunk = sprt_arena->sprt_chunk;
+        sprt_arena->sprt_chunk = sprt_chunk->sprt_next;
+        kfree(sprt_chunk);
     }
 
-exit:
-    /*!< Update the pointer position */
-    *mem = ptr_mem;
+    kmemzero(sprt_arena, sizeof(*sprt_arena));
+}
 
-    return sprt_prop;
+/*!< ---------------------------------------------------------------------------------- */
+/*!
+ * @brief   Hash of string key
+ * @param   str
+ * @retval  hash
+ * @note    none
+ */
+static kuint32_t fwk_of_index_hash(const kchar_t *str)
+{
+    kuint32_t hash = 5381;
+
+    while (*str)
+        hash = ((hash << 5) + hash) ^ (kuint8_t)(*str++);
+
+    return hash;
 }
 
 /*!
- * @brief   Memory space calculation
+ * @brief   Add entry to the tail of bucket
+ * @param   sprt_table, sprt_entry
+ * @retval  none
+ * @note    nodes are added in allnext order, so the first match of a bucket is the first one on allnext
+ */
+static void fwk_of_index_insert(struct fwk_of_index_entry **sprt_table, struct fwk_of_index_entry *sprt_entry)
+{
+    struct fwk_of_index_entry **sprt_pos = &sprt_table[sprt_entry->hash & sgrt_fwk_of_index.mask];
+
+    while (*sprt_pos)
+        sprt_pos = &(*sprt_pos)->sprt_next;
+
+    *sprt_pos = sprt_entry;
+}
+
+/*!
+ * @brief   Build phandle, path and compatible indexes
  * @param   none
  * @retval  none
- * @note    Start with (void *)0 and add up to get the final mem
+ * @note    if memory is not enough, lookups walk the allnext list as before
  */
-static void *fwk_fdt_memory_calculate(void **mem, kuint32_t size, kuint32_t align)
+static void fwk_of_index_build(void)
 {
-    void *res;
+    struct fwk_of_index *sprt_index = &sgrt_fwk_of_index;
+    struct fwk_of_index_entry *sprt_entry;
+    struct fwk_device_node *sprt_node;
+    kchar_t *ptr_compat, *ptr_end;
+    kusize_t lenth;
+    kuint32_t nodes = 0, compats = 0, buckets, order;
+    void *ptr_mem;
 
-    *mem = mrt_ptr_align(*mem, align);
-    res = *mem;
-    *mem += size;
+    foreach_fwk_of_dt_node(sprt_node, mrt_nullptr)
+    {
+        nodes++;
+
+        lenth = 0;
+        ptr_compat = fwk_of_get_property(sprt_node, "compatible", &lenth);
+        for (ptr_end = ptr_compat + lenth; ptr_compat && (ptr_compat < ptr_end); ptr_compat += strlen(ptr_compat) + 1)
+            compats++;
+    }
 
-    return res;
+    if (!nodes)
+        return;
+
+    for (buckets = FWK_OF_INDEX_MIN_BUCKETS; buckets < nodes; buckets <<= 1);
+
+    /*!< 3 tables of buckets, followed by all entries */
+    ptr_mem = kzalloc(buckets * 3 * sizeof(struct fwk_of_index_entry *) + 
+                    (nodes * 2 + compats) * sizeof(struct fwk_of_index_entry), GFP_KERNEL);
+    if (!isValid(ptr_mem))
+        return;
+
+    sprt_index->mask = buckets - 1;
+    sprt_index->sprt_phandle = (struct fwk_of_index_entry **)ptr_mem;
+    sprt_index->sprt_path = sprt_index->sprt_phandle + buckets;
+    sprt_index->sprt_compat = sprt_index->sprt_path + buckets;
+    sprt_entry = (struct fwk_of_index_entry *)(sprt_index->sprt_compat + buckets);
+
+    order = 0;
+    foreach_fwk_of_dt_node(sprt_node, mrt_nullptr)
+    {
+        /*!< nodes without phandle are kept too, only to get their order by path */
+        sprt_entry->key = sprt_node->full_name;
+        sprt_entry->hash = fwk_of_index_hash(sprt_node->full_name);
+        sprt_entry->order = order;
+        sprt_entry->sprt_node = sprt_node;
+        fwk_of_index_insert(sprt_index->sprt_path, sprt_entry++);
+
+        if (sprt_node->phandle >= 0)
+        {
+            sprt_entry->key = mrt_nullptr;
+            sprt_entry->hash = sprt_node->phandle;
+            sprt_entry->order = order;
+            sprt_entry->sprt_node = sprt_node;
+            fwk_of_index_insert(sprt_index->sprt_phandle, sprt_entry++);
+        }
+
+        lenth = 0;
+        ptr_compat = fwk_of_get_property(sprt_node, "compatible", &lenth);
+        for (ptr_end = ptr_compat + lenth; ptr_compat && (ptr_compat < ptr_end); ptr_compat += strlen(ptr_compat) + 1)
+        {
+            sprt_entry->key = ptr_compat;
+            sprt_entry->hash = fwk_of_index_hash(ptr_compat);
+            sprt_entry->order = order;
+            sprt_entry->sprt_node = sprt_node;
+            fwk_of_index_insert(sprt_index->sprt_compat, sprt_entry++);
+        }
+
+        order++;
+    }
 }
 
 /*!
- * @brief   Memory space allocation
+ * @brief   Release indexes
  * @param   none
  * @retval  none
  * @note    none
  */
-static void *fwk_fdt_memory_alloc(kuint32_t size, kuint32_t align)
+static void fwk_of_index_destroy(void)
 {
-    void *mem = mrt_nullptr;
+    struct fwk_of_index *sprt_index = &sgrt_fwk_of_index;
 
-    mem = mrt_ptr_align(mem + size, align);
-    size = (kuaddr_t)mem;
+    if (!sprt_index->mask)
+        return;
 
-    return kzalloc(size, GFP_KERNEL);
+    /*!< the buckets of phandle are the head of memory */
+    kfree(sprt_index->sprt_phandle);
+    kmemzero(sprt_index, sizeof(*sprt_index));
+}
+
+/*!
+ * @brief   Find path entry of node
+ * @param   ptr_path
+ * @retval  entry, null if not found
+ * @note    index must be built
+ */
+static struct fwk_of_index_entry *fwk_of_index_find_path(const kchar_t *ptr_path)
+{
+    struct fwk_of_index_entry *sprt_entry;
+    kuint32_t hash = fwk_of_index_hash(ptr_path);
+
+    for (sprt_entry = sgrt_fwk_of_index.sprt_path[hash & sgrt_fwk_of_index.mask]; sprt_entry; sprt_entry = sprt_entry->sprt_next)
+    {
+        if ((sprt_entry->hash == hash) && !strcmp(sprt_entry->key, ptr_path))
+            return sprt_entry;
+    }
+
+    return mrt_nullptr;
+}
+
+/*!
+ * @brief   Get the order of start node
+ * @param   sprt_from: null means the first node
+ * @retval  order, -1 if index can not be used
+ * @note    lookups with "sprt_from" search from it (inclusive) to the end of allnext list
+ */
+static kint32_t fwk_of_index_from(struct fwk_device_node *sprt_from)
+{
+    struct fwk_of_index_entry *sprt_entry;
+
+    if (!sgrt_fwk_of_index.mask)
+        return -1;
+
+    if (!isValid(sprt_from))
+        return 0;
+
+    sprt_entry = fwk_of_index_find_path(sprt_from->full_name);
+    if (!sprt_entry || (sprt_entry->sprt_node != sprt_from))
+        return -1;
+
+    return sprt_entry->order;
 }
 
-/*!< ---------------------------------------------------------------------------------- */
 /*!
  * @brief   Find nodes based on paths
  * @param   none
@@ -699,9 +957,16 @@ static void *fwk_fdt_memory_alloc(kuint32_t size, kuint32_t align)
  */
 struct fwk_device_node *fwk_of_find_node_by_path(const kchar_t *ptr_path)
 {
+    struct fwk_of_index_entry *sprt_entry;
     struct fwk_device_node *sprt_list = mrt_nullptr;
     struct fwk_device_node *sprt_head = mrt_fwk_fdt_node_header();
 
+    if (sgrt_fwk_of_index.mask)
+    {
+        sprt_entry = fwk_of_index_find_path(ptr_path);
+        return sprt_entry ? sprt_entry->sprt_node : mrt_nullptr;
+    }
+
     foreach_list_odd(sprt_head, sprt_list, allnext)
     {
         if (!strcmp(ptr_path, sprt_list->full_name))
@@ -759,8 +1024,23 @@ struct fwk_device_node *fwk_of_find_node_by_type(struct fwk_device_node *sprt_fr
  */
 struct fwk_device_node *fwk_of_find_node_by_phandle(struct fwk_device_node *sprt_from, kuint32_t phandle)
 {
+    struct fwk_of_index_entry *sprt_entry;
     struct fwk_device_node *sprt_list = mrt_nullptr;
     struct fwk_device_node *sprt_head = isValid(sprt_from) ? sprt_from : mrt_fwk_fdt_node_header();
+    kint32_t order;
+
+    order = fwk_of_index_from(sprt_from);
+    if (order >= 0)
+    {
+        sprt_entry = sgrt_fwk_of_index.sprt_phandle[phandle & sgrt_fwk_of_index.mask];
+        for (; sprt_entry; sprt_entry = sprt_entry->sprt_next)
+        {
+            if ((sprt_entry->hash == phandle) && (sprt_entry->order >= order))
+                return sprt_entry->sprt_node;
+        }
+
+        return mrt_nullptr;
+    }
 
     foreach_list_odd(sprt_head, sprt_list, allnext)
     {
@@ -780,8 +1060,28 @@ struct fwk_device_node *fwk_of_find_node_by_phandle(struct fwk_device_node *sprt
 struct fwk_device_node *fwk_of_find_compatible_node(struct fwk_device_node *sprt_from,
                                         const kchar_t *ptr_type, const kchar_t *ptr_compat)
 {
+    struct fwk_of_index_entry *sprt_entry;
     struct fwk_device_node *sprt_list = mrt_nullptr;
     struct fwk_device_node *sprt_head = isValid(sprt_from) ? sprt_from : mrt_fwk_fdt_node_header();
+    kuint32_t hash;
+    kint32_t order;
+
+    order = fwk_of_index_from(sprt_from);
+    if (order >= 0)
+    {
+        hash = fwk_of_index_hash(ptr_compat);
+        for (sprt_entry = sgrt_fwk_of_index.sprt_compat[hash & sgrt_fwk_of_index.mask]; 
+                                                    sprt_entry; sprt_entry = sprt_entry->sprt_next)
+        {
+            if ((sprt_entry->hash != hash) || (sprt_entry->order < order) || strcmp(sprt_entry->key, ptr_compat))
+                continue;
+
+            if (!ptr_type || !strcmp(ptr_type, sprt_entry->sprt_node->type))
+                return sprt_entry->sprt_node;
+        }
+
+        return mrt_nullptr;
+    }
 
     foreach_list_odd(sprt_head, sprt_list, allnext)
     {
@@ -0,0 +1,130 @@
+/*
+ * Terminal Core API: Command blkstat
+ *
+ * File Name:   blk.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+#include <platform/block/fwk_blkqueue.h>
+#include <term/term.h>
+
+/*!< The defines */
+
+
+/*!< The globals */
+
+
+/*!< The functions */
+
+/*!< API functions */
+/*!
+ * @brief   print statistics of one request queue
+ * @param   sprt_queue, data: unused
+ * @retval  none
+ * @note    none
+ */
+static void term_cmd_blkstat_queue(struct fwk_request_queue *sprt_queue, void *data)
+{
+    struct fwk_blk_stats *sprt_stats = &sprt_queue->sgrt_stats;
+    kuint32_t total, rate;
+
+    total = sprt_stats->hits + sprt_stats->misses;
+    rate = total ? ((sprt_stats->hits * 100) / total) : 0;
+
+    printk("%-10s %8d %8d %5d%% %6d/%-6d %8d %8d %8d %8d %8d\n",
+            sprt_queue->name, sprt_stats->hits, sprt_stats->misses, rate,
+            sprt_queue->nr_dirty, sprt_queue->nr_bufs,
+            sprt_stats->reads, sprt_stats->writes, sprt_stats->merges, sprt_stats->writebacks, sprt_stats->wberrors);
+}
+
+/*!
+ * @brief   write back one request queue
+ * @param   sprt_queue, data: unused
+ * @retval  none
+ * @note    none
+ */
+static void term_cmd_blkstat_sync(struct fwk_request_queue *sprt_queue, void *data)
+{
+    fwk_blk_flush(sprt_queue);
+}
+
+/*!
+ * @brief   cmd 'blkstat': excute function
+ * @param   sprt_cmd, argc, argv
+ * @retval  errno
+ * @note    none
+ */
+static kint32_t term_cmd_show_blkstat(struct term_cmd *sprt_cmd, kint32_t argc, kchar_t **argv)
+{
+    switch (argc)
+    {
+        case 1:
+            printk("%-10s %8s %8s %6s %13s %8s %8s %8s %8s %8s\n",
+                    "queue", "hits", "misses", "rate", "dirty/bufs", "reads", "writes", "merges", "wback", "wberr");
+
+            fwk_blk_foreach_queue(term_cmd_blkstat_queue, mrt_nullptr);
+
+            break;
+
+        case 2:
+            if (!strcmp(argv[1], "--help"))
+                sprt_cmd->help();
+            else if (!strcmp(argv[1], "-s"))
+                fwk_blk_foreach_queue(term_cmd_blkstat_sync, mrt_nullptr);
+            else
+                goto fail;
+
+            break;
+
+        default:
+            goto fail;
+    }
+
+    return ER_NORMAL;
+
+fail:
+    printk("argument error, try entering \'%s --help\' to get usage\n", argv[0]);
+    return -ER_FAULT;
+}
+
+/*!
+ * @brief   cmd 'blkstat': help function
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+static void term_cmd_blkstat_help(void)
+{
+    printk("usage: blkstat [-s]\n");
+    printk("    show sector cache and request merging statistics of block devices\n");
+    printk("    merges counts requests folded into a neighbour: write-back batches, and read-ahead on a miss\n");
+    printk("    wberr counts dirty sectors dropped, since they could not be written back\n");
+    printk("    -s: write back all dirty sectors\n");
+}
+
+/*!
+ * @brief   cmd 'blkstat' init and add
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+void term_cmd_add_blkstat(void)
+{
+    struct term_cmd *sprt_cmd;
+
+    sprt_cmd = term_cmd_allocate("blkstat", GFP_KERNEL);
+    if (!isValid(sprt_cmd))
+        return;
+
+    sprt_cmd->do_excute = term_cmd_show_blkstat;
+    sprt_cmd->help = term_cmd_blkstat_help;
+
+    term_cmd_add(sprt_cmd);
+}
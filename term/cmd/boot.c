@@ -0,0 +1,204 @@
+/*
+ * Terminal Core API: Command bootprof
+ *
+ * File Name:   boot.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+#include <boot/boot_prof.h>
+#include <term/term.h>
+
+/*!< The defines */
+#define mrt_boot_prof_duration(event)       ((event)->end ? (kuint32_t)((event)->end - (event)->start) : 0)
+
+/*!< The globals */
+
+
+/*!< The functions */
+/*!
+ * @brief   name of event
+ * @param   sprt_event, buf, size
+ * @retval  name
+ * @note    none
+ */
+static const kchar_t *term_cmd_bootprof_name(struct boot_prof_event *sprt_event, kchar_t *buf, kusize_t size)
+{
+    return sprt_event->name ? sprt_event->name : boot_prof_symbol(sprt_event->func, buf, size);
+}
+
+/*!
+ * @brief   print events, the longest first
+ * @param   count
+ * @retval  none
+ * @note    if there is no memory to sort, events are printed in order of start
+ */
+static void term_cmd_bootprof_table(kuint32_t count)
+{
+    struct boot_prof_event *sprt_event;
+    kchar_t buf[BOOT_PROF_SYMBOL_LEN];
+    kuint32_t *order;
+    kuint32_t idx, pos, cur, total = 0;
+
+    order = kmalloc(count * sizeof(*order) + 1, GFP_KERNEL);
+
+    /*!< insertion sort by duration, descending */
+    for (idx = 0; isValid(order) && (idx < count); idx++)
+    {
+        cur = mrt_boot_prof_duration(boot_prof_get(idx));
+
+        for (pos = idx; pos && (mrt_boot_prof_duration(boot_prof_get(order[pos - 1])) < cur); pos--)
+            order[pos] = order[pos - 1];
+
+        order[pos] = idx;
+    }
+
+    printk("%10s %10s %-8s %3s %4s %5s %s\n", "dur(us)", "start(us)", "type", "lvl", "tid", "ret", "name");
+
+    for (idx = 0; idx < count; idx++)
+    {
+        sprt_event = boot_prof_get(isValid(order) ? order[idx] : idx);
+
+        if (sprt_event->end)
+            printk("%10d ", mrt_boot_prof_duration(sprt_event));
+        else
+            printk("%10s ", "-");
+
+        printk("%10d %-8s %3d %4d %5d %s",
+                (kuint32_t)sprt_event->start, boot_prof_type_name(sprt_event->type), sprt_event->level,
+                sprt_event->tid, sprt_event->retval, term_cmd_bootprof_name(sprt_event, buf, sizeof(buf)));
+
+        if (sprt_event->owner)
+            printk(" (%s)", sprt_event->owner);
+        printk("\n");
+
+        /*!< the others run inside stages and sync initcalls, or in parallel with each other */
+        if (sprt_event->type == NR_BOOT_PROF_INITCALL)
+            total += mrt_boot_prof_duration(sprt_event);
+    }
+
+    printk("%d events, synchronous initcalls take %d us\n", count, total);
+
+    if (isValid(order))
+        kfree(order);
+}
+
+/*!
+ * @brief   print events in chrome trace event format
+ * @param   count
+ * @retval  none
+ * @note    complete events ("ph": "X"), save the output as .json and load it in chrome://tracing or perfetto;
+ *          tid is -1 before the scheduler runs
+ */
+static void term_cmd_bootprof_trace(kuint32_t count)
+{
+    struct boot_prof_event *sprt_event;
+    kchar_t buf[BOOT_PROF_SYMBOL_LEN];
+    kuint32_t idx;
+    kbool_t first = true;
+
+    printk("[\n");
+
+    for (idx = 0; idx < count; idx++)
+    {
+        sprt_event = boot_prof_get(idx);
+        if (!sprt_event->end)
+            continue;
+
+        printk("%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%d,\"dur\":%d,\"pid\":0,\"tid\":%d,",
+                first ? "" : ",\n", term_cmd_bootprof_name(sprt_event, buf, sizeof(buf)),
+                boot_prof_type_name(sprt_event->type), (kuint32_t)sprt_event->start,
+                mrt_boot_prof_duration(sprt_event), sprt_event->tid);
+
+        printk("\"args\":{\"level\":%d,\"ret\":%d,\"driver\":\"%s\"}}",
+                sprt_event->level, sprt_event->retval, sprt_event->owner ? sprt_event->owner : "");
+
+        first = false;
+    }
+
+    printk("\n]\n");
+}
+
+/*!< API functions */
+/*!
+ * @brief   cmd 'bootprof': excute function
+ * @param   sprt_cmd, argc, argv
+ * @retval  errno
+ * @note    none
+ */
+static kint32_t term_cmd_show_bootprof(struct term_cmd *sprt_cmd, kint32_t argc, kchar_t **argv)
+{
+    kuint32_t count, dropped;
+
+    count = boot_prof_count(&dropped);
+
+    switch (argc)
+    {
+        case 1:
+            term_cmd_bootprof_table(count);
+            break;
+
+        case 2:
+            if (!strcmp(argv[1], "--help"))
+                sprt_cmd->help();
+            else if (!strcmp(argv[1], "-t"))
+                term_cmd_bootprof_trace(count);
+            else
+                goto fail;
+
+            break;
+
+        default:
+            goto fail;
+    }
+
+    if (dropped)
+        printk("%d events are dropped, increase CONFIG_BOOT_PROF_EVENTS\n", dropped);
+
+    return ER_NORMAL;
+
+fail:
+    printk("argument error, try entering \'%s --help\' to get usage\n", argv[0]);
+    return -ER_FAULT;
+}
+
+/*!
+ * @brief   cmd 'bootprof': help function
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+static void term_cmd_bootprof_help(void)
+{
+    printk("usage: bootprof [-t]\n");
+    printk("    show time of initcalls and driver probes, the longest first\n");
+    printk("    -t: print them in chrome trace event format (json), in order of start\n");
+}
+
+/*!
+ * @brief   cmd 'bootprof' init and add
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+void term_cmd_add_bootprof(void)
+{
+    struct term_cmd *sprt_cmd;
+
+    sprt_cmd = term_cmd_allocate("bootprof", GFP_KERNEL);
+    if (!isValid(sprt_cmd))
+        return;
+
+    sprt_cmd->do_excute = term_cmd_show_bootprof;
+    sprt_cmd->help = term_cmd_bootprof_help;
+
+    term_cmd_add(sprt_cmd);
+}
+
+/*!< end of file */
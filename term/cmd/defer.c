@@ -0,0 +1,116 @@
+/*
+ * Terminal Core API: Command deferred
+ *
+ * File Name:   defer.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+#include <platform/fwk_platform.h>
+#include <term/term.h>
+
+/*!< The defines */
+
+
+/*!< The globals */
+
+
+/*!< The functions */
+/*!
+ * @brief   print one deferred device
+ * @param   sprt_dev, data: counter
+ * @retval  none
+ * @note    none
+ */
+static void term_cmd_deferred_show(struct fwk_device *sprt_dev, void *data)
+{
+    kuint32_t *count = (kuint32_t *)data;
+
+    printk("%-24s %-24s %s\n", mrt_dev_get_name(sprt_dev),
+            sprt_dev->sprt_defer_driver ? sprt_dev->sprt_defer_driver->name : "-",
+            sprt_dev->defer_reason ? sprt_dev->defer_reason : "-");
+
+    (*count)++;
+}
+
+/*!< API functions */
+/*!
+ * @brief   cmd 'deferred': excute function
+ * @param   sprt_cmd, argc, argv
+ * @retval  errno
+ * @note    none
+ */
+static kint32_t term_cmd_show_deferred(struct term_cmd *sprt_cmd, kint32_t argc, kchar_t **argv)
+{
+    kuint32_t count = 0;
+
+    switch (argc)
+    {
+        case 1:
+            printk("%-24s %-24s %s\n", "device", "driver", "reason");
+            fwk_deferred_probe_foreach(term_cmd_deferred_show, &count);
+            printk("%d devices are waiting\n", count);
+
+            break;
+
+        case 2:
+            if (!strcmp(argv[1], "--help"))
+                sprt_cmd->help();
+            else if (!strcmp(argv[1], "-r"))
+                fwk_deferred_probe_trigger();
+            else
+                goto fail;
+
+            break;
+
+        default:
+            goto fail;
+    }
+
+    return ER_NORMAL;
+
+fail:
+    printk("argument error, try entering \'%s --help\' to get usage\n", argv[0]);
+    return -ER_FAULT;
+}
+
+/*!
+ * @brief   cmd 'deferred': help function
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+static void term_cmd_deferred_help(void)
+{
+    printk("usage: deferred [-r]\n");
+    printk("    show devices whose probe is deferred, and the reason given by driver\n");
+    printk("    -r: retry them now\n");
+}
+
+/*!
+ * @brief   cmd 'deferred' init and add
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+void term_cmd_add_deferred(void)
+{
+    struct term_cmd *sprt_cmd;
+
+    sprt_cmd = term_cmd_allocate("deferred", GFP_KERNEL);
+    if (!isValid(sprt_cmd))
+        return;
+
+    sprt_cmd->do_excute = term_cmd_show_deferred;
+    sprt_cmd->help = term_cmd_deferred_help;
+
+    term_cmd_add(sprt_cmd);
+}
+
+/*!< end of file */
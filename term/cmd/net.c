@@ -0,0 +1,130 @@
+/*
+ * Terminal Core API: Command skbstat
+ *
+ * File Name:   net.c
+ * Author:      Yang Yujun
+ * E-mail:      <yujiantianhu@163.com>
+ * Created on:  2025.03.02
+ *
+ * Copyright (c) 2025   Yang Yujun <yujiantianhu@163.com>
+ *
+ */
+
+/*!< The includes */
+#include <platform/fwk_basic.h>
+#include <platform/net/fwk_netdev.h>
+#include <platform/net/fwk_skbuff.h>
+#include <term/term.h>
+
+/*!< The defines */
+
+
+/*!< The globals */
+
+
+/*!< The functions */
+/*!
+ * @brief   print skb cache statistics of one net device
+ * @param   sprt_ndev
+ * @retval  none
+ * @note    none
+ */
+static void term_cmd_skbstat_ndev(struct fwk_net_device *sprt_ndev)
+{
+    struct fwk_skb_cache_class *sprt_class;
+    kuint32_t idx, hits, misses;
+
+    if (!sprt_ndev->sprt_skb_cache)
+    {
+        printk("%-10s %6s\n", sprt_ndev->name, "-");
+        return;
+    }
+
+    for (idx = 0; idx < NR_SKB_CACHE_MAX; idx++)
+    {
+        sprt_class = &sprt_ndev->sprt_skb_cache->sgrt_class[idx];
+        hits = ATOMIC_READ(&sprt_class->hits);
+        misses = ATOMIC_READ(&sprt_class->misses);
+
+        printk("%-10s %6d %6d %10d %10d %5d%%\n", idx ? "" : sprt_ndev->name,
+                sprt_class->data_size, sprt_class->count, hits, misses,
+                (hits + misses) ? ((hits * 100) / (hits + misses)) : 0);
+    }
+}
+
+/*!< API functions */
+/*!
+ * @brief   cmd 'skbstat': excute function
+ * @param   sprt_cmd, argc, argv
+ * @retval  errno
+ * @note    none
+ */
+static kint32_t term_cmd_show_skbstat(struct term_cmd *sprt_cmd, kint32_t argc, kchar_t **argv)
+{
+    struct fwk_net_device *sprt_ndev = mrt_nullptr;
+
+    switch (argc)
+    {
+        case 1:
+            printk("%-10s %6s %6s %10s %10s %6s\n", "netdev", "size", "count", "hits", "misses", "rate");
+
+            fwk_netdevice_lock();
+            while ((sprt_ndev = fwk_next_netdevice(sprt_ndev)))
+                term_cmd_skbstat_ndev(sprt_ndev);
+            fwk_netdevice_unlock();
+
+            break;
+
+        case 2:
+            if (!strcmp(argv[1], "--help"))
+                sprt_cmd->help();
+            else
+                goto fail;
+
+            break;
+
+        default:
+            goto fail;
+    }
+
+    return ER_NORMAL;
+
+fail:
+    printk("argument error, try entering \'%s --help\' to get usage\n", argv[0]);
+    return -ER_FAULT;
+}
+
+/*!
+ * @brief   cmd 'skbstat': help function
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+static void term_cmd_skbstat_help(void)
+{
+    printk("usage: skbstat\n");
+    printk("    show skb recycle cache statistics of every net device, one line per size class\n");
+    printk("    a miss falls back to the next larger class, and then to the heap\n");
+}
+
+/*!
+ * @brief   cmd 'skbstat' init and add
+ * @param   none
+ * @retval  none
+ * @note    none
+ */
+void term_cmd_add_skbstat(void)
+{
+    struct term_cmd *sprt_cmd;
+
+    sprt_cmd = term_cmd_allocate("skbstat", GFP_KERNEL);
+    if (!isValid(sprt_cmd))
+        return;
+
+    sprt_cmd->do_excute = term_cmd_show_skbstat;
+    sprt_cmd->help = term_cmd_skbstat_help;
+
+    term_cmd_add(sprt_cmd);
+}
+
+/*!< end of file */
@@ -226,6 +226,10 @@ static const term_cmd_fn_t g_term_cmd_fn[] =
     term_cmd_add_ttc,
     term_cmd_add_user,
     term_cmd_add_kill,
+    term_cmd_add_blkstat,
+    term_cmd_add_bootprof,
+    term_cmd_add_deferred,
+    term_cmd_add_skbstat,
 
     mrt_nullptr,
 };